@@ -0,0 +1,176 @@
+// apps/headless/main.cpp
+// Runs the core without a frontend: load content, run N frames or cycles with
+// optional scripted input, print timing and hashes of the final framebuffer and RAM.
+// --batch runs a manifest of such jobs on all cores and prints a JSON summary.
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "core/apu/apu.h"
+#include "core/mmu/mmu.h"
+#include "core/system/batch.h"
+#include "core/system/headless.h"
+#include "core/system/system.h"
+
+namespace {
+    constexpr std::uint64_t kDefaultFrames = 600U; // ~10 s of emulated time
+
+    struct Options {
+        std::filesystem::path rom;
+        std::filesystem::path bios; // empty: boot straight into the cartridge
+        std::filesystem::path input;
+        gba::HeadlessConfig config;
+        std::filesystem::path batch; // manifest; replaces rom/input/frames
+        std::filesystem::path json;  // batch summary destination; empty = stdout
+        std::uint64_t jobs = 0;      // batch workers; 0 = one per hardware thread
+    };
+
+    void usage() {
+        std::cerr << "usage: gba_headless <rom.gba> [bios.bin] [options]\n"
+                     "       gba_headless --batch jobs.txt [bios.bin] [--jobs N] [--json out.json]\n"
+                     "  --frames N     run N frames (default 600)\n"
+                     "  --cycles N     run N cycles instead\n"
+                     "  --input FILE   scripted keypad input or movie (see InputScript)\n"
+                     "  --no-render    skip PPU rendering (framebuffer hash is then meaningless)\n"
+                     "  --audio        run full audio synthesis (default: timing only)\n"
+                     "  --batch FILE   run every \"rom input frames\" line of FILE in parallel\n"
+                     "  --jobs N       batch worker threads (default: one per hardware thread)\n"
+                     "  --json FILE    write the batch summary there instead of stdout\n";
+    }
+
+    auto parse_count(std::string_view text, std::uint64_t &value) -> bool {
+        const auto *end = text.data() + text.size(); // NOLINT(*-pointer-arithmetic)
+        const auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc{} && ptr == end && value > 0U;
+    }
+
+    auto parse_options(int argc, char **argv, Options &options) -> bool {
+        const std::span<char *> args(argv, static_cast<std::size_t>(argc));
+        std::vector<std::filesystem::path> positional;
+        options.config.frames = kDefaultFrames;
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            const std::string_view arg = args[i];
+            const bool hasValue = i + 1U < args.size();
+            if (arg == "--frames" && hasValue) {
+                if (!parse_count(args[++i], options.config.frames)) {
+                    return false;
+                }
+            } else if (arg == "--cycles" && hasValue) {
+                if (!parse_count(args[++i], options.config.cycles)) {
+                    return false;
+                }
+            } else if (arg == "--input" && hasValue) {
+                options.input = args[++i];
+            } else if (arg == "--batch" && hasValue) {
+                options.batch = args[++i];
+            } else if (arg == "--json" && hasValue) {
+                options.json = args[++i];
+            } else if (arg == "--jobs" && hasValue) {
+                if (!parse_count(args[++i], options.jobs)) {
+                    return false;
+                }
+            } else if (arg == "--no-render") {
+                options.config.render = false;
+            } else if (arg == "--audio") {
+                options.config.audio = gba::AudioMode::Full;
+            } else if (arg.starts_with("--")) {
+                return false;
+            } else {
+                positional.emplace_back(arg);
+            }
+        }
+        if (!options.batch.empty()) {
+            if (positional.size() > 1U) {
+                return false;
+            }
+            if (!positional.empty()) {
+                options.bios = positional[0];
+            }
+            return true;
+        }
+        if (positional.empty() || positional.size() > 2U) {
+            return false;
+        }
+        options.rom = positional[0];
+        if (positional.size() == 2U) {
+            options.bios = positional[1];
+        }
+        return true;
+    }
+
+    auto run_batch(const Options &options) -> int {
+        std::vector<gba::BatchJob> jobs;
+        if (!gba::load_manifest(options.batch, jobs)) {
+            std::cerr << "cannot read manifest " << options.batch << '\n';
+            return 1;
+        }
+        gba::BatchRunner runner(static_cast<std::size_t>(options.jobs), options.bios);
+        const gba::BatchSummary summary = runner.run(jobs);
+        if (options.json.empty()) {
+            gba::write_batch_json(std::cout, jobs, summary);
+        } else {
+            std::ofstream out(options.json, std::ios::trunc);
+            gba::write_batch_json(out, jobs, summary);
+            if (!out) {
+                std::cerr << "cannot write " << options.json << '\n';
+                return 1;
+            }
+        }
+        std::cerr << summary.results.size() << " jobs, " << summary.failed() << " failed, " << summary.workers
+                  << " workers, " << summary.seconds << " s\n";
+        return summary.failed() == 0U ? 0 : 1;
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+    if (!options.batch.empty()) {
+        return run_batch(options);
+    }
+
+    auto sys = std::make_unique<gba::System>();
+    sys->reset();
+    if (!sys->load_gamepak(options.rom)) {
+        std::cerr << "cannot load ROM " << options.rom << '\n';
+        return 1;
+    }
+    if (options.bios.empty()) {
+        sys->cpu().debug_set_program_counter(gba::MMU::WS0_BASE); // no BIOS: start at the cartridge
+    } else if (!sys->load_bios(options.bios)) {
+        std::cerr << "cannot load BIOS " << options.bios << '\n';
+        return 1;
+    }
+    gba::InputScript input;
+    if (!options.input.empty()) {
+        if (!input.load_file(options.input)) {
+            std::cerr << "cannot read input script " << options.input << '\n';
+            return 1;
+        }
+        options.config.input = &input;
+    }
+
+    const gba::HeadlessResult result = gba::run_headless(*sys, options.config);
+    const gba::MemoryFootprint memory = sys->memory_footprint();
+
+    std::cout << std::fixed << std::setprecision(3) << "frames      " << result.frames << '\n'
+              << "cycles      " << result.cycles << '\n'
+              << "seconds     " << result.seconds << '\n'
+              << "fps         " << result.fps() << '\n'
+              << "speed       " << result.speed() << "x\n"
+              << "private_kib " << (memory.private_bytes / 1024U) << '\n'
+              << "shared_kib  " << (memory.shared_bytes / 1024U) << '\n'
+              << std::hex << std::setfill('0') << "framebuffer " << std::setw(16) << result.framebuffer_hash << '\n'
+              << "ram         " << std::setw(16) << result.ram_hash << '\n';
+    return 0;
+}
@@ -1,46 +1,386 @@
 #include <SDL.h>
 #include <SDL_error.h>
 #include <SDL_stdinc.h>
-#include <cstdio>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
-#include "core/bus/bus.h"
-#include "core/cpu/arm7tdmi.h"
+#include "core/apu/audio_ring.h"
+#include "core/io/io.h"
 #include "core/mmu/mmu.h"
+#include "core/ppu/pixel_convert.h"
+#include "core/ppu/ppu.h"
+#include "core/system/emu_thread.h"
+#include "core/system/system.h"
 
-int main(int /*unused*/, char ** /*unused*/) {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS) != 0) {
-        std::cerr << "SDL_Init faild: " << SDL_GetError() << '\n';
+namespace {
+    constexpr int kScale = 3;
+    constexpr int kTextureWidth = static_cast<int>(gba::PPU::kScreenWidth);
+    constexpr int kTextureHeight = static_cast<int>(gba::PPU::kScreenHeight);
+    constexpr int kAudioHz = 48000;
+    constexpr Uint16 kAudioDeviceFrames = 512U;
+    constexpr std::size_t kAudioRingFrames = 4096U; // ~85 ms at 48 kHz
+    constexpr Uint64 kStatsPeriodMs = 1000U;
+    constexpr double kPercent = 100.0;
+
+    using Clock = gba::EmuThread::Clock;
+    auto ms_between(Clock::time_point from, Clock::time_point to) -> double {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    struct KeyBinding {
+        SDL_Scancode scancode;
+        std::uint16_t key;
+    };
+    constexpr std::array<KeyBinding, 10> kBindings{{
+        {SDL_SCANCODE_X, gba::IORegs::kKeyA},
+        {SDL_SCANCODE_Z, gba::IORegs::kKeyB},
+        {SDL_SCANCODE_BACKSPACE, gba::IORegs::kKeySelect},
+        {SDL_SCANCODE_RETURN, gba::IORegs::kKeyStart},
+        {SDL_SCANCODE_RIGHT, gba::IORegs::kKeyRight},
+        {SDL_SCANCODE_LEFT, gba::IORegs::kKeyLeft},
+        {SDL_SCANCODE_UP, gba::IORegs::kKeyUp},
+        {SDL_SCANCODE_DOWN, gba::IORegs::kKeyDown},
+        {SDL_SCANCODE_S, gba::IORegs::kKeyR},
+        {SDL_SCANCODE_A, gba::IORegs::kKeyL},
+    }};
+
+    auto poll_keys() -> std::uint16_t {
+        const Uint8 *state = SDL_GetKeyboardState(nullptr);
+        std::uint16_t pressed = 0;
+        for (const auto &binding : kBindings) {
+            if (state[binding.scancode] != 0U) { // NOLINT(*-pointer-arithmetic)
+                pressed = static_cast<std::uint16_t>(pressed | binding.key);
+            }
+        }
+        return pressed;
+    }
+
+    // SDL audio thread: pop what the emulator produced, pad the rest with silence
+    void SDLCALL audio_callback(void *userdata, Uint8 *stream, int len) {
+        auto *ring = static_cast<gba::AudioRing *>(userdata);
+        const std::span<gba::AudioFrame> out(reinterpret_cast<gba::AudioFrame *>(stream), // NOLINT(*-reinterpret-cast)
+                                             static_cast<std::size_t>(len) / sizeof(gba::AudioFrame));
+        const std::size_t got = ring->pop(out);
+        std::fill(out.begin() + static_cast<std::ptrdiff_t>(got), out.end(), gba::AudioFrame{});
+    }
+
+    struct SdlResources {
+        SDL_Window *window = nullptr;
+        SDL_Renderer *renderer = nullptr;
+        SDL_Texture *texture = nullptr;
+        SDL_AudioDeviceID audio = 0;
+
+        SdlResources() = default;
+        SdlResources(const SdlResources &) = delete;
+        auto operator=(const SdlResources &) -> SdlResources & = delete;
+        SdlResources(SdlResources &&) = delete;
+        auto operator=(SdlResources &&) -> SdlResources & = delete;
+        ~SdlResources() {
+            if (audio != 0U) {
+                SDL_CloseAudioDevice(audio);
+            }
+            if (texture != nullptr) {
+                SDL_DestroyTexture(texture);
+            }
+            if (renderer != nullptr) {
+                SDL_DestroyRenderer(renderer);
+            }
+            if (window != nullptr) {
+                SDL_DestroyWindow(window);
+            }
+            SDL_Quit();
+        }
+    };
+
+    // How a published frame reaches the streaming texture
+    enum class Upload : std::uint8_t {
+        Lock, // SDL_LockTexture and convert straight into the texture's XRGB8888 pixels
+        Copy, // SDL_UpdateTexture from the BGR555 frame (staging copy plus driver conversion)
+    };
+
+    struct Options {
+        std::filesystem::path rom;
+        std::filesystem::path bios; // empty: boot straight into the cartridge
+        double fast_forward = gba::EmuThread::kUncapped;
+        Upload upload = Upload::Lock;
+    };
+
+    auto parse_options(int argc, char **argv, Options &options) -> bool {
+        const std::span<char *> args(argv, static_cast<std::size_t>(argc));
+        std::vector<std::filesystem::path> positional;
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            const std::string_view arg = args[i];
+            if (arg == "--ff" && i + 1U < args.size()) {
+                std::istringstream value(args[++i]);
+                if (!(value >> options.fast_forward) || options.fast_forward < 0.0) {
+                    return false;
+                }
+            } else if (arg == "--upload" && i + 1U < args.size()) {
+                const std::string_view mode = args[++i];
+                if (mode != "lock" && mode != "copy") {
+                    return false;
+                }
+                options.upload = mode == "lock" ? Upload::Lock : Upload::Copy;
+            } else {
+                positional.emplace_back(arg);
+            }
+        }
+        if (positional.empty() || positional.size() > 2U) {
+            return false;
+        }
+        options.rom = positional[0];
+        if (positional.size() == 2U) {
+            options.bios = positional[1];
+        }
+        return true;
+    }
+
+    void print_latency(std::ostream &out, const gba::LatencyStats &latency) {
+        constexpr int kBarWidth = 40;
+        const auto row = [&out](const char *stage, const gba::LatencyHistogram &histogram) {
+            out << "  " << std::left << std::setw(8) << stage << std::right << " mean " << std::setw(6)
+                << histogram.mean() << "  p50 " << std::setw(4) << histogram.percentile(0.5) << "  p95 "
+                << std::setw(4) << histogram.percentile(0.95) << "  p99 " << std::setw(4)
+                << histogram.percentile(0.99) << " ms\n";
+        };
+        const auto &photon = latency.to_present;
+        out << std::fixed << std::setprecision(1) << "latency from key event, " << photon.count() << " samples\n";
+        if (photon.count() == 0U) {
+            return;
+        }
+        row("read", latency.to_read);
+        row("changed", latency.to_changed);
+        row("present", photon);
+        std::uint64_t peak = 0;
+        for (std::size_t i = 0; i < gba::LatencyHistogram::kBuckets; ++i) {
+            peak = std::max(peak, photon.bucket(i));
+        }
+        for (std::size_t i = 0; i < gba::LatencyHistogram::kBuckets; ++i) {
+            if (const std::uint64_t count = photon.bucket(i); count != 0U) {
+                const auto bar = static_cast<int>(std::max<std::uint64_t>(count * kBarWidth / peak, 1U));
+                out << "  " << std::setw(4) << i << (i + 1U == gba::LatencyHistogram::kBuckets ? "+ " : "  ") << "ms "
+                    << std::string(static_cast<std::size_t>(bar), '#') << ' ' << count << '\n';
+            }
+        }
+    }
+
+    auto upload_frame(SDL_Texture *texture, const gba::VideoFrame &frame, Upload upload) -> bool {
+        if (upload == Upload::Copy) {
+            return SDL_UpdateTexture(texture, nullptr, frame.pixels.data(),
+                                     kTextureWidth * static_cast<int>(sizeof(std::uint16_t))) == 0;
+        }
+        void *pixels = nullptr;
+        int pitch = 0;
+        if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) != 0) {
+            return false;
+        }
+        gba::convert_xrgb8888(frame.pixels, gba::PPU::kScreenWidth, gba::PPU::kScreenHeight, pixels,
+                              static_cast<std::size_t>(pitch));
+        SDL_UnlockTexture(texture);
+        return true;
+    }
+
+    auto load_content(gba::System &sys, const Options &options) -> bool {
+        sys.reset();
+        if (!sys.load_gamepak(options.rom)) {
+            std::cerr << "cannot load ROM " << options.rom << '\n';
+            return false;
+        }
+        if (!options.bios.empty() && !sys.load_bios(options.bios)) {
+            std::cerr << "cannot load BIOS " << options.bios << '\n';
+            return false;
+        }
+        if (options.bios.empty()) {
+            sys.cpu().debug_set_program_counter(gba::MMU::WS0_BASE); // no BIOS: start at the cartridge
+        }
+        auto &backup = sys.bus().backup();
+        const auto save = std::filesystem::path(options.rom).replace_extension(".sav");
+        if (backup.type() != gba::BackupType::None && !backup.attach_file(save)) {
+            std::cerr << "warning: cannot map " << save << ", saves will not persist\n";
+        }
+        return true;
     }
+} // namespace
 
-    return 1;
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << "usage: gba_sdl <rom.gba> [bios.bin] [--ff N] [--upload lock|copy]\n"
+                     "  hold Tab to fast-forward at N x real time (default 0: uncapped)\n"
+                     "  --upload copy: SDL_UpdateTexture instead of converting into the locked texture\n";
+        return 1;
+    }
+    auto sys = std::make_unique<gba::System>();
+    if (!load_content(*sys, options)) {
+        return 1;
+    }
 
-    const int WindowWidth = 240 * 2;
-    const int WindowHeight = 160 * 2;
-    SDL_Window *win =
-        SDL_CreateWindow("GBA-EMU", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, WindowWidth, WindowHeight, 0);
-    if (win == nullptr) {
+    gba::AudioRing ring(kAudioRingFrames); // declared first: outlives the audio device
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS) != 0) {
+        std::cerr << "SDL_Init failed: " << SDL_GetError() << '\n';
+        return 1;
+    }
+    SdlResources sdl;
+    sdl.window = SDL_CreateWindow("GBA-EMU", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, kTextureWidth * kScale,
+                                  kTextureHeight * kScale, SDL_WINDOW_RESIZABLE);
+    if (sdl.window == nullptr) {
         std::cerr << "SDL_CreateWindow failed: " << SDL_GetError() << '\n';
-        SDL_Quit();
         return 1;
     }
+    // Presentation waits for vsync on this thread only; the emulator never does
+    sdl.renderer = SDL_CreateRenderer(sdl.window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (sdl.renderer == nullptr) {
+        std::cerr << "SDL_CreateRenderer failed: " << SDL_GetError() << '\n';
+        return 1;
+    }
+    // Without vsync (some drivers refuse it) present on our own timer at the display's rate
+    SDL_RendererInfo info{};
+    SDL_DisplayMode display{};
+    const bool vsync = SDL_GetRendererInfo(sdl.renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0U;
+    const int refreshHz =
+        (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(sdl.window), &display) == 0 && display.refresh_rate > 0)
+            ? display.refresh_rate
+            : 60;
+    const auto refresh = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / refreshHz));
+    SDL_RenderSetLogicalSize(sdl.renderer, kTextureWidth, kTextureHeight);
+    const auto format = options.upload == Upload::Lock ? SDL_PIXELFORMAT_XRGB8888 : SDL_PIXELFORMAT_BGR555;
+    sdl.texture = SDL_CreateTexture(sdl.renderer, format, SDL_TEXTUREACCESS_STREAMING, kTextureWidth, kTextureHeight);
+    if (sdl.texture == nullptr) {
+        std::cerr << "SDL_CreateTexture failed: " << SDL_GetError() << '\n';
+        return 1;
+    }
+
+    SDL_AudioSpec wanted{};
+    wanted.freq = kAudioHz;
+    wanted.format = AUDIO_S16SYS;
+    wanted.channels = 2;
+    wanted.samples = kAudioDeviceFrames;
+    wanted.callback = audio_callback;
+    wanted.userdata = &ring;
+    SDL_AudioSpec obtained{};
+    sdl.audio = SDL_OpenAudioDevice(nullptr, 0, &wanted, &obtained, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+    if (sdl.audio == 0U) {
+        std::cerr << "warning: no audio device (" << SDL_GetError() << "), running silent\n";
+        sys->bus().apu().set_mode(gba::AudioMode::TimingOnly);
+    } else {
+        sys->bus().apu().set_host_rate(static_cast<double>(obtained.freq));
+    }
+
+    // With a device the audio ring's fill is the master clock; otherwise the steady clock
+    gba::EmuThread emu(*sys, sdl.audio != 0U ? &ring : nullptr);
+    gba::PresentStats stats;
+    gba::FrameTimeStats emuTimes;     // between consecutive emulated frames (emulation thread pacing)
+    gba::FrameTimeStats presentTimes; // between presents (vsync cadence)
+    gba::FrameTimeStats uploadTimes;  // frame -> texture, per new frame
+    gba::FrameTimeStats uploadTotal;  // same, whole run
+    gba::LatencyStats latency;        // key event -> guest read -> changed frame -> present
+    Clock::time_point lastFinished{};
+    auto lastPresent = Clock::now();
+    emu.start();
+    if (sdl.audio != 0U) {
+        SDL_PauseAudioDevice(sdl.audio, 0);
+    }
 
-    // Minimal event pump for ~100ms then exit
-    SDL_Event event;
+    const auto started = Clock::now();
+    Uint64 statsStart = SDL_GetTicks64();
+    std::uint64_t statsFrames = emu.frames();
+    gba::PresentStats statsBase = stats;
     bool running = true;
-    constexpr Uint64 kPumpMs = 100; // window lifetime
-    constexpr Uint32 kDelayMs = 1;  // event loop sleep
-    const Uint64 start = SDL_GetTicks64();
-    while (running && (SDL_GetTicks64() - start) < kPumpMs) {
+    while (running) {
+        SDL_Event event;
+        auto keyEvent = Clock::now();
         while (SDL_PollEvent(&event) != 0) {
-            if (event.type == SDL_QUIT) {
+            if (event.type == SDL_QUIT ||
+                (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_ESCAPE)) {
+                running = false;
+            }
+            if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
+                // SDL stamps events in ms on its own tick counter; map the earliest onto the steady clock
+                const auto age = std::chrono::milliseconds(SDL_GetTicks() - event.key.timestamp);
+                keyEvent = std::min(keyEvent, Clock::now() - age);
+            }
+        }
+        emu.set_keys(poll_keys(), keyEvent);
+        const bool fastForward = SDL_GetKeyboardState(nullptr)[SDL_SCANCODE_TAB] != 0U; // NOLINT(*-pointer-arithmetic)
+        emu.set_speed(fastForward ? options.fast_forward : 1.0);
+
+        // Newest finished frame, if any; otherwise show the previous one again
+        auto &video = emu.video();
+        if (video.acquire()) {
+            const gba::VideoFrame &frame = video.front();
+            const auto uploadStart = Clock::now();
+            if (!upload_frame(sdl.texture, frame, options.upload)) {
+                std::cerr << "texture upload failed: " << SDL_GetError() << '\n';
                 running = false;
             }
+            const double uploadMs = ms_between(uploadStart, Clock::now());
+            uploadTimes.add(uploadMs);
+            uploadTotal.add(uploadMs);
+            if (lastFinished != Clock::time_point{} && frame.sequence > stats.last_sequence) {
+                // Averaged over frames that were published but never shown
+                emuTimes.add(ms_between(lastFinished, frame.finished) /
+                             static_cast<double>(frame.sequence - stats.last_sequence));
+            }
+            lastFinished = frame.finished;
+        }
+        stats.on_present(video.front().sequence);
+        SDL_RenderClear(sdl.renderer);
+        SDL_RenderCopy(sdl.renderer, sdl.texture, nullptr, nullptr);
+        SDL_RenderPresent(sdl.renderer); // blocks until vsync
+        if (!vsync) {
+            std::this_thread::sleep_until(lastPresent + refresh);
+        }
+        const auto presented = Clock::now();
+        presentTimes.add(ms_between(lastPresent, presented));
+        latency.on_present(video.front().probe, presented);
+        lastPresent = presented;
+
+        const Uint64 now = SDL_GetTicks64();
+        if (now - statsStart >= kStatsPeriodMs) {
+            const double seconds = static_cast<double>(now - statsStart) / 1000.0;
+            const std::uint64_t frames = emu.frames();
+            std::ostringstream title;
+            const double fps = static_cast<double>(frames - statsFrames) / seconds;
+            title << std::fixed << std::setprecision(2) << "GBA-EMU | " << (fps / gba::EmuThread::kFrameHz)
+                  << "x | emu " << fps << " fps | shown "
+                  << (static_cast<double>(stats.presented - statsBase.presented) / seconds) << "/s | dropped "
+                  << (stats.dropped - statsBase.dropped) << " | repeated " << (stats.repeated - statsBase.repeated)
+                  << " | frame " << emuTimes.mean << " +/- " << emuTimes.stddev() << " ms | present "
+                  << presentTimes.mean << " +/- " << presentTimes.stddev() << " ms | upload "
+                  << (uploadTimes.mean * 1000.0) << " us | latency " << latency.to_present.percentile(0.5) << '/'
+                  << latency.to_present.percentile(0.95) << " ms | audio "
+                  << (ring.fill_ratio() * kPercent) << '%';
+            SDL_SetWindowTitle(sdl.window, title.str().c_str());
+            statsStart = now;
+            statsFrames = frames;
+            statsBase = stats;
+            emuTimes = {};
+            presentTimes = {};
+            uploadTimes = {};
         }
-        SDL_Delay(kDelayMs);
     }
 
-    SDL_DestroyWindow(win);
-    SDL_Quit();
+    emu.stop();
+    const std::chrono::duration<double> runtime = Clock::now() - started;
+    std::cout << "frames " << emu.frames() << " ("
+              << (static_cast<double>(emu.frames()) / (runtime.count() * gba::EmuThread::kFrameHz))
+              << "x real time) presented " << stats.presented << " dropped " << stats.dropped
+              << " repeated " << stats.repeated << " pacing "
+              << (emu.pacing() == gba::Pacing::Audio ? "audio" : "clock") << " upload "
+              << (options.upload == Upload::Lock ? "lock" : "copy") << ' ' << (uploadTotal.mean * 1000.0) << " +/- "
+              << (uploadTotal.stddev() * 1000.0) << " us\n";
+    print_latency(std::cout, latency);
     return 0;
 }
@@ -0,0 +1,75 @@
+// bench/apu.cpp
+// Host CPU time per emulated frame spent in the APU: full synthesis vs timing-only.
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include "core/apu/apu.h"
+#include "core/mmu/mmu.h"
+
+using gba::APU;
+using gba::AudioMode;
+using gba::MMU;
+
+namespace {
+    constexpr std::uint32_t kCyclesPerFrame = 280896U;
+    constexpr std::uint32_t kCyclesPerBatch = 64U; // typical CPU slice between device updates
+    constexpr int kFrames = 600;                   // ten emulated seconds
+    constexpr std::uint32_t kSampleWord = 0x10F020E0U;
+    constexpr std::uint32_t kRefillWords = 4U; // one sound-DMA burst (16 bytes)
+    constexpr std::uint16_t kCntHBothFifos = APU::kCntHVolumeA | APU::kCntHVolumeB | APU::kCntHRightA |
+                                             APU::kCntHLeftA | APU::kCntHRightB | APU::kCntHLeftB |
+                                             APU::kCntHTimerB;
+
+    // A game streaming both FIFOs with the timers running at the mixer rate.
+    auto ns_per_frame(AudioMode mode, std::uint32_t resolution) -> double {
+        MMU mmu;
+        mmu.reset();
+        mmu.apu().set_mode(mode);
+        mmu.write16(MMU::IO_BASE + APU::kOffSOUNDCNT_X, APU::kCntXMasterEnable);
+        mmu.write16(MMU::IO_BASE + APU::kOffSOUNDCNT_H, kCntHBothFifos);
+        mmu.write16(MMU::IO_BASE + APU::kOffSOUNDBIAS,
+                    static_cast<std::uint16_t>(APU::kBiasResetValue | (resolution << APU::kBiasResolutionShift)));
+
+        const std::uint32_t timerPeriod = APU::kCpuHz / mmu.apu().sample_rate();
+        std::uint32_t timerCycles = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            for (std::uint32_t cycles = 0; cycles < kCyclesPerFrame; cycles += kCyclesPerBatch) {
+                timerCycles += kCyclesPerBatch;
+                while (timerCycles >= timerPeriod) {
+                    timerCycles -= timerPeriod;
+                    mmu.apu().on_timer_overflow(0U);
+                    mmu.apu().on_timer_overflow(1U);
+                }
+                const std::uint32_t requests = mmu.apu().take_dma_requests();
+                for (std::uint32_t word = 0; word < kRefillWords; ++word) {
+                    if ((requests & APU::kDmaRequestA) != 0U) {
+                        mmu.write32(MMU::IO_BASE + APU::kOffFIFO_A, kSampleWord);
+                    }
+                    if ((requests & APU::kDmaRequestB) != 0U) {
+                        mmu.write32(MMU::IO_BASE + APU::kOffFIFO_B, kSampleWord);
+                    }
+                }
+                mmu.apu().advance(kCyclesPerBatch);
+            }
+            mmu.apu().end_frame();
+            mmu.apu().consume_output();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / kFrames;
+    }
+} // namespace
+
+auto main() -> int {
+    std::cout << "rate_hz  full_us_per_frame  timing_only_us_per_frame  saved_us_per_frame\n";
+    for (std::uint32_t resolution = 0; resolution < 4U; ++resolution) {
+        const double full = ns_per_frame(AudioMode::Full, resolution);
+        const double timing = ns_per_frame(AudioMode::TimingOnly, resolution);
+        std::cout << std::setw(7) << (APU::kBaseSampleHz << resolution) << std::fixed << std::setprecision(2)
+                  << std::setw(19) << (full / 1e3) << std::setw(26) << (timing / 1e3) << std::setw(20)
+                  << ((full - timing) / 1e3) << '\n';
+    }
+    return 0;
+}
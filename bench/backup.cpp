@@ -0,0 +1,79 @@
+// bench/backup.cpp
+// Cost of game saves on the emulation thread: SRAM writes into memory vs a mapped
+// save file whose flusher syncs in the background.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/bus/bus.h"
+#include "core/mmu/mmu.h"
+
+using gba::Bus;
+using gba::MMU;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Nanos = std::chrono::duration<double, std::nano>;
+
+    constexpr int kBursts = 2000; // one "save" each
+    constexpr std::uint32_t kBurstBytes = 2048U;
+    constexpr std::chrono::milliseconds kIdle{2};
+
+    struct Result {
+        double ns_per_write = 0.0;
+        double worst_burst_us = 0.0;
+        std::uint64_t flushes = 0;
+    };
+
+    auto run(const std::filesystem::path *file) -> Result {
+        std::vector<std::uint8_t> rom(0x400U, 0U);
+        const std::string id = "SRAM_V113";
+        std::copy(id.begin(), id.end(), rom.begin());
+        Bus bus;
+        bus.reset();
+        bus.load_gamepak(rom);
+        if (file != nullptr && !bus.backup().attach_file(*file, kIdle)) {
+            return {};
+        }
+
+        Nanos total{};
+        Nanos worst{};
+        for (int burst = 0; burst < kBursts; ++burst) {
+            const auto t0 = Clock::now();
+            for (std::uint32_t i = 0; i < kBurstBytes; ++i) {
+                bus.write8(MMU::SRAM_BASE + ((static_cast<std::uint32_t>(burst) * 97U + i) & 0x7FFFU),
+                           static_cast<std::uint8_t>(i + static_cast<std::uint32_t>(burst)));
+            }
+            const Nanos elapsed = Clock::now() - t0;
+            total += elapsed;
+            worst = std::max(worst, elapsed);
+            if (burst % 64 == 0) {
+                std::this_thread::sleep_for(kIdle * 2); // let the game go idle now and then
+            }
+        }
+        const auto *mapped = bus.backup().file();
+        return {total.count() / (static_cast<double>(kBursts) * kBurstBytes), worst.count() / 1000.0,
+                mapped != nullptr ? mapped->flush_count() : 0U};
+    }
+} // namespace
+
+auto main() -> int {
+    const auto path = std::filesystem::temp_directory_path() / "gba_backup_bench.sav";
+    std::filesystem::remove(path);
+    const Result memory = run(nullptr);
+    const Result mapped = run(&path);
+    std::filesystem::remove(path);
+
+    std::cout << std::fixed << std::setprecision(2) << "writes " << (kBursts * kBurstBytes) << '\n'
+              << "memory_ns_per_write " << memory.ns_per_write << '\n'
+              << "mapped_ns_per_write " << mapped.ns_per_write << '\n'
+              << "memory_worst_burst_us " << memory.worst_burst_us << '\n'
+              << "mapped_worst_burst_us " << mapped.worst_burst_us << '\n'
+              << "background_flushes " << mapped.flushes << '\n';
+    return 0;
+}
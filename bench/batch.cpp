@@ -0,0 +1,114 @@
+// bench/batch.cpp
+// Batch throughput: 48 headless jobs (4 ROMs x 12 input scripts, 60 frames each)
+// through BatchRunner at 1, 2, 4 and hardware-concurrency workers: jobs/s, fps,
+// instances reused, steals. Then the same jobs one fresh System each, as separate
+// gba_headless processes would run them, to show what instance reuse saves.
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/system/batch.h"
+#include "core/system/headless.h"
+#include "core/system/system.h"
+
+using gba::BatchJob;
+using gba::BatchRunner;
+using gba::BatchSummary;
+using gba::HeadlessConfig;
+using gba::InputScript;
+using gba::MMU;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kRoms = 4U;
+    constexpr std::size_t kScriptsPerRom = 12U;
+    constexpr std::uint64_t kFrames = 60U;
+    constexpr std::size_t kRomBytes = 1U << 20U; // 1 MiB: loading it is not free
+    // Thumb key-echo loop (see tests/batch.cpp): keeps the CPU busy with bus traffic
+    constexpr std::array<std::uint16_t, 14> kProgram{0x2104U, 0x0609U, 0x2026U, 0x00C0U, 0x1809U,
+                                                     0x2302U, 0x061BU, 0x2406U, 0x0624U, 0x3501U,
+                                                     0x7025U, 0x780AU, 0x701AU, 0xE7FAU};
+
+    auto make_jobs(const std::filesystem::path &dir) -> std::vector<BatchJob> {
+        std::vector<BatchJob> jobs;
+        for (std::size_t r = 0; r < kRoms; ++r) {
+            std::vector<char> rom(kRomBytes, static_cast<char>(r));
+            for (std::size_t i = 0; i < kProgram.size(); ++i) {
+                rom[i * 2U] = static_cast<char>(kProgram[i] & 0xFFU);
+                rom[(i * 2U) + 1U] = static_cast<char>(kProgram[i] >> 8U);
+            }
+            const auto romPath = dir / ("rom" + std::to_string(r) + ".gba");
+            std::ofstream(romPath, std::ios::binary).write(rom.data(), static_cast<std::streamsize>(rom.size()));
+            for (std::size_t s = 0; s < kScriptsPerRom; ++s) {
+                const auto inputPath = dir / ("in" + std::to_string(r) + "_" + std::to_string(s) + ".txt");
+                std::ofstream(inputPath) << "0 none\n" << (s + 1U) << " A\n" << (s + 20U) << " Start+Up\n";
+                jobs.push_back(BatchJob{romPath, inputPath, kFrames});
+            }
+        }
+        return jobs;
+    }
+
+    void report(const char *name, std::size_t workers, double seconds, std::size_t jobs, std::size_t reused,
+                std::uint64_t steals) {
+        std::cout << std::left << std::setw(10) << name << std::right << " workers " << std::setw(2) << workers
+                  << "  jobs/s " << std::setw(8) << (static_cast<double>(jobs) / seconds) << "  fps " << std::setw(9)
+                  << (static_cast<double>(jobs * kFrames) / seconds) << "  reused " << std::setw(2) << reused
+                  << "  steals " << steals << '\n';
+    }
+} // namespace
+
+auto main() -> int {
+    const auto dir = std::filesystem::temp_directory_path() / "gba_batch_bench";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto jobs = make_jobs(dir);
+    std::cout << std::fixed << std::setprecision(1) << "jobs " << jobs.size() << " x " << kFrames
+              << " frames, host threads " << std::thread::hardware_concurrency() << '\n';
+
+    std::vector<std::size_t> counts{1U, 2U, 4U};
+    if (const std::size_t hw = std::thread::hardware_concurrency(); hw > 4U) {
+        counts.push_back(hw);
+    }
+    for (const std::size_t workers : counts) {
+        BatchRunner runner(workers);
+        const BatchSummary summary = runner.run(jobs);
+        std::size_t reused = 0;
+        for (const auto &result : summary.results) {
+            reused += result.reused ? 1U : 0U;
+        }
+        report("batch", runner.workers(), summary.seconds, jobs.size(), reused, summary.steals);
+    }
+
+    // Baseline: a fresh instance and a fresh ROM load per job, one at a time
+    const auto t0 = Clock::now();
+    for (const BatchJob &job : jobs) {
+        System sys;
+        sys.reset();
+        if (!sys.load_gamepak(job.rom)) {
+            return 1;
+        }
+        sys.cpu().debug_set_program_counter(MMU::WS0_BASE);
+        InputScript input;
+        if (!input.load_file(job.input)) {
+            return 1;
+        }
+        HeadlessConfig config;
+        config.frames = job.frames;
+        config.input = &input;
+        static_cast<void>(gba::run_headless(sys, config));
+    }
+    report("fresh", 1U, std::chrono::duration<double>(Clock::now() - t0).count(), jobs.size(), 0U, 0U);
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,114 @@
+// bench/coop_scheduler.cpp
+// Many lightweight instances on few threads: 256 forks of one System (a program
+// walking EWRAM, skip-render, timing-only audio) each advance two frames.
+// Reported: one OS thread per instance, then CooperativeScheduler with 1, 2, 4 ...
+// up to every hardware thread (aggregate emulated frames per second, speedup
+// and efficiency against 1 worker, slices, migrations between cores), then the
+// slice length at full width.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/system/coop_scheduler.h"
+#include "core/system/system.h"
+
+using gba::CooperativeScheduler;
+using gba::MMU;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kInstances = 256U;
+    constexpr std::uint64_t kFrames = 2U;
+    constexpr std::uint64_t kBudget = kFrames * System::kCyclesPerFrame;
+    // r3 = EWRAM; loop { r4 += 1; [r3 + (r4 & 0x3FFFF)] = r4 } (see tests/instance_pool.cpp)
+    constexpr std::array<std::uint16_t, 9> kProgram{0x2302U, 0x061BU, 0x2400U, 0x3401U, 0x03A5U,
+                                                    0x0BADU, 0x195EU, 0x7034U, 0xE7FAU};
+
+    auto make_template() -> std::unique_ptr<System> {
+        auto sys = std::make_unique<System>();
+        sys->reset();
+        for (std::size_t i = 0; i < kProgram.size(); ++i) {
+            sys->bus().write16(MMU::IWRAM_BASE + static_cast<std::uint32_t>(i * 2U), kProgram[i]);
+        }
+        sys->bus().apu().set_mode(gba::AudioMode::TimingOnly);
+        sys->ppu().set_render_enabled(false);
+        sys->cpu().debug_set_program_counter(MMU::IWRAM_BASE);
+        return sys;
+    }
+
+    // Fresh forks per measurement, so every row starts from the same state and page sharing
+    auto spawn(const System &source, std::vector<std::unique_ptr<System>> &owned) -> std::vector<System *> {
+        owned.clear();
+        std::vector<System *> handles;
+        for (std::size_t i = 0; i < kInstances; ++i) {
+            owned.push_back(source.fork());
+            handles.push_back(owned.back().get());
+        }
+        return handles;
+    }
+
+    auto fps(double seconds) -> double { return static_cast<double>(kInstances * kFrames) / seconds; }
+} // namespace
+
+auto main() -> int {
+    const auto source = make_template();
+    const std::size_t hardware = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::unique_ptr<System>> owned;
+    std::cout << std::fixed << std::setprecision(1) << kInstances << " instances x " << kFrames
+              << " frames, hardware threads " << hardware << "\n";
+
+    {
+        const auto handles = spawn(*source, owned);
+        const auto t0 = Clock::now();
+        std::vector<std::thread> threads;
+        threads.reserve(kInstances);
+        for (System *sys : handles) {
+            threads.emplace_back([sys] { sys->run(static_cast<std::uint32_t>(kBudget)); });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        std::cout << "thread per instance      fps " << std::setw(9) << fps(seconds) << '\n';
+    }
+
+    std::vector<std::size_t> widths;
+    for (std::size_t w = 1U; w < hardware; w *= 2U) {
+        widths.push_back(w);
+    }
+    widths.push_back(hardware);
+    double single = 0.0;
+    for (const std::size_t workers : widths) {
+        const auto handles = spawn(*source, owned);
+        CooperativeScheduler scheduler(workers);
+        const auto t0 = Clock::now();
+        scheduler.run(handles, kBudget);
+        const double rate = fps(std::chrono::duration<double>(Clock::now() - t0).count());
+        single = (workers == 1U) ? rate : single;
+        const auto stats = scheduler.stats();
+        std::cout << "cooperative workers " << std::setw(4) << workers << "  fps " << std::setw(9) << rate
+                  << "  speedup " << std::setw(5) << std::setprecision(2) << (rate / single) << "  efficiency "
+                  << std::setw(5) << (rate / single / static_cast<double>(workers)) << std::setprecision(1)
+                  << "  slices " << stats.slices << "  migrations " << stats.migrations << '\n';
+    }
+
+    for (const std::uint32_t lines : {1U, 16U, 228U}) {
+        const auto handles = spawn(*source, owned);
+        CooperativeScheduler scheduler(hardware, lines * System::kCyclesPerLine);
+        const auto t0 = Clock::now();
+        scheduler.run(handles, kBudget);
+        const double rate = fps(std::chrono::duration<double>(Clock::now() - t0).count());
+        std::cout << "slice " << std::setw(3) << lines << " lines, " << hardware << " workers  fps " << std::setw(9)
+                  << rate << "  slices " << scheduler.stats().slices << '\n';
+    }
+    return 0;
+}
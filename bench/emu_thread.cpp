@@ -0,0 +1,133 @@
+// bench/emu_thread.cpp
+// Threaded emulation against a simulated 48 kHz audio device whose crystal runs
+// 0.2% fast and a 60 Hz vsync presenter, once per pacing mode: emulated fps,
+// audio underruns, frame-time mean/stddev on both threads, dropped/repeated frames.
+// Then fast-forward at 2x, 4x and uncapped: achieved speed, share of frames drawn
+// and host audio kept per emulated frame.
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "core/apu/audio_ring.h"
+#include "core/apu/resampler.h"
+#include "core/system/emu_thread.h"
+#include "core/system/system.h"
+
+using gba::AudioFrame;
+using gba::AudioRing;
+using gba::EmuThread;
+using gba::FrameTimeStats;
+using gba::Pacing;
+using gba::PresentStats;
+using gba::Resampler;
+using gba::System;
+
+namespace {
+    constexpr double kRefreshHz = 60.0;
+    constexpr int kRefreshes = 300; // 5 s
+    constexpr double kDeviceSkew = 1.002;
+    constexpr std::size_t kDeviceChunk = 512U;
+    constexpr std::size_t kRingFrames = 4096U;
+    constexpr auto kFastForwardRun = std::chrono::seconds(2);
+
+    using Clock = EmuThread::Clock;
+
+    auto period(double hz) -> Clock::duration {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+    }
+    auto ms_between(Clock::time_point from, Clock::time_point to) -> double {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    void run(const char *name, Pacing pacing) {
+        System sys;
+        sys.reset();
+        AudioRing ring(kRingFrames);
+        EmuThread emu(sys, &ring);
+        emu.set_pacing(pacing);
+
+        // Audio device: pulls a chunk per callback period on its own (slightly fast) clock
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> underruns{0};
+        std::thread device([&] {
+            std::vector<AudioFrame> chunk(kDeviceChunk);
+            const auto callback = period(Resampler::kDefaultOutputHz * kDeviceSkew / kDeviceChunk);
+            auto next = Clock::now() + (callback * 4); // let the ring prime like SDL's startup latency
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_until(next);
+                next += callback;
+                if (ring.pop(chunk) < chunk.size()) {
+                    underruns.fetch_add(1U, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        PresentStats stats;
+        FrameTimeStats emuTimes;
+        FrameTimeStats presentTimes;
+        emu.start();
+        const auto start = Clock::now();
+        auto vsync = start;
+        auto lastPresent = start;
+        Clock::time_point lastFinished{};
+        for (int i = 0; i < kRefreshes; ++i) {
+            vsync += period(kRefreshHz);
+            std::this_thread::sleep_until(vsync); // stands in for SDL_RenderPresent
+            const auto now = Clock::now();
+            presentTimes.add(ms_between(lastPresent, now));
+            lastPresent = now;
+            if (emu.video().acquire()) {
+                const auto finished = emu.video().front().finished;
+                if (lastFinished != Clock::time_point{}) {
+                    emuTimes.add(ms_between(lastFinished, finished) /
+                                 static_cast<double>(emu.video().front().sequence - stats.last_sequence));
+                }
+                lastFinished = finished;
+            }
+            stats.on_present(emu.video().front().sequence);
+        }
+        emu.stop();
+        stop.store(true, std::memory_order_relaxed);
+        device.join();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << name << std::fixed << std::setprecision(2) << "   "
+                  << std::setw(6) << (static_cast<double>(emu.frames()) / seconds) << "   " << std::setw(9)
+                  << underruns.load() << "   " << std::setw(5) << emuTimes.mean << " +/- " << std::setw(5)
+                  << emuTimes.stddev() << "   " << std::setw(5) << presentTimes.mean << " +/- " << std::setw(5)
+                  << presentTimes.stddev() << "   " << std::setw(7) << stats.dropped << "   " << std::setw(8)
+                  << stats.repeated << '\n';
+    }
+
+    void fast_forward(double speed) {
+        System sys;
+        sys.reset();
+        AudioRing ring(1U << 20U); // nobody drains it: count what fast-forward keeps
+        EmuThread emu(sys, &ring);
+        emu.set_speed(speed);
+        emu.start();
+        std::this_thread::sleep_for(kFastForwardRun);
+        emu.stop();
+        (void)emu.video().acquire();
+        const auto frames = static_cast<double>(emu.frames());
+        std::cout << std::fixed << std::setprecision(2) << std::setw(8) << speed << "   " << std::setw(8)
+                  << emu.achieved_speed() << "x   " << std::setw(6)
+                  << (static_cast<double>(emu.video().front().sequence) / frames * 100.0) << "%   " << std::setw(8)
+                  << (static_cast<double>(ring.size()) / frames) << '\n';
+    }
+} // namespace
+
+auto main() -> int {
+    std::cout << "pacing   fps      underruns   emu frame ms     present ms       dropped   repeated\n";
+    run("clock ", Pacing::Clock);
+    run("audio ", Pacing::Audio);
+    std::cout << "\nff speed   achieved   drawn     audio/frame   (0 = uncapped)\n";
+    fast_forward(2.0);
+    fast_forward(4.0);
+    fast_forward(EmuThread::kUncapped);
+    return 0;
+}
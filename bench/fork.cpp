@@ -0,0 +1,73 @@
+// bench/fork.cpp
+// Fork 1000 children from one running instance and run each for one frame.
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "core/apu/apu.h"
+#include "core/mmu/mmu.h"
+#include "core/mmu/paged_memory.h"
+#include "core/system/system.h"
+
+using gba::AudioMode;
+using gba::MMU;
+using gba::PagedMemory;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    constexpr int kChildren = 1000;
+    constexpr std::uint32_t kTouchedBytes = 16U; // per child, spread over pages like game state
+    constexpr std::uint32_t kTouchStride = 0x1111U;
+
+    auto private_pages(const PagedMemory &child, const PagedMemory &parent) -> std::size_t {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < child.page_count(); ++i) {
+            count += child.shares_page_with(parent, i) ? 0U : 1U;
+        }
+        return count;
+    }
+} // namespace
+
+auto main() -> int {
+    System parent;
+    parent.reset();
+    parent.bus().apu().set_mode(AudioMode::TimingOnly); // search agents don't listen
+    for (std::uint32_t off = 0; off < MMU::EWRAM_SIZE; off += PagedMemory::kPageBytes) {
+        parent.bus().write8(MMU::EWRAM_BASE + off, static_cast<std::uint8_t>(off >> PagedMemory::kPageShift));
+    }
+    parent.run_frame();
+
+    Micros forkTime{};
+    Micros runTime{};
+    std::size_t privatePages = 0;
+    for (int i = 0; i < kChildren; ++i) {
+        const auto t0 = Clock::now();
+        const auto child = parent.fork();
+        const auto t1 = Clock::now();
+        for (std::uint32_t b = 0; b < kTouchedBytes; ++b) {
+            const std::uint32_t off = (static_cast<std::uint32_t>(i) + (b * kTouchStride)) % MMU::EWRAM_SIZE;
+            child->bus().write8(MMU::EWRAM_BASE + off, static_cast<std::uint8_t>(i));
+        }
+        child->run_frame();
+        const auto t2 = Clock::now();
+        forkTime += t1 - t0;
+        runTime += t2 - t1;
+        privatePages += private_pages(child->bus().ewram(), parent.bus().ewram()) +
+                        private_pages(child->bus().iwram(), parent.bus().iwram()) +
+                        private_pages(child->bus().vram(), parent.bus().vram());
+    }
+
+    const double avgPages = static_cast<double>(privatePages) / kChildren;
+    std::cout << std::fixed << std::setprecision(2) << "children " << kChildren << '\n'
+              << "fork_us " << (forkTime.count() / kChildren) << '\n'
+              << "frame_us " << (runTime.count() / kChildren) << '\n'
+              << "private_pages_per_child " << avgPages << '\n'
+              << "private_kib_per_child " << (avgPages * PagedMemory::kPageBytes / 1024.0) << '\n'
+              << "full_copy_kib " << ((MMU::EWRAM_SIZE + MMU::IWRAM_SIZE + MMU::VRAM_SIZE) / 1024U) << '\n';
+    return 0;
+}
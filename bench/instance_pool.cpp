@@ -0,0 +1,124 @@
+// bench/instance_pool.cpp
+// Episode resets: a program walking EWRAM (~11 pages per frame) runs a 30-frame
+// "intro", then 200 one-frame episodes each start from that state again. Time of
+// the reset alone, per method: InstancePool::reset (re-share written pages), a
+// load_state() of the intro state into the same instance, and a full reload (new
+// System, 1 MiB ROM from disk, the intro replayed) as a freshly booted instance
+// would need. Also the pages each pool reset re-shared. The ROM carries the
+// Flash 128 KiB library ID, so every reset also restores a full-size save chip.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/system/instance_pool.h"
+#include "core/system/system.h"
+
+using gba::InstancePool;
+using gba::MMU;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int kIntroFrames = 30;
+    constexpr int kEpisodes = 200;
+    constexpr int kReloads = 10; // each replays the intro
+    constexpr std::size_t kRomBytes = 1U << 20U;
+    // r3 = EWRAM; loop { r4 += 1; [r3 + (r4 & 0x3FFFF)] = r4 } (see tests/instance_pool.cpp)
+    constexpr std::array<std::uint16_t, 9> kProgram{0x2302U, 0x061BU, 0x2400U, 0x3401U, 0x03A5U,
+                                                    0x0BADU, 0x195EU, 0x7034U, 0xE7FAU};
+    constexpr std::string_view kFlashId = "FLASH1M_V103"; // detect_backup_type(): Flash128K
+    constexpr std::size_t kFlashIdOffset = 0x1000U;
+
+    auto boot(const std::filesystem::path &rom) -> std::unique_ptr<System> {
+        auto sys = std::make_unique<System>();
+        sys->reset();
+        if (!sys->load_gamepak(rom)) {
+            return nullptr;
+        }
+        sys->bus().apu().set_mode(gba::AudioMode::TimingOnly);
+        sys->cpu().debug_set_program_counter(MMU::WS0_BASE);
+        for (int f = 0; f < kIntroFrames; ++f) {
+            sys->run_frame();
+        }
+        return sys;
+    }
+
+    void report(const char *name, double seconds, int resets, double pages) {
+        std::cout << std::left << std::setw(11) << name << std::right << "  reset us " << std::setw(10)
+                  << (seconds * 1e6 / resets) << "  pages " << std::setw(5) << pages << '\n';
+    }
+} // namespace
+
+auto main() -> int {
+    const auto rom = std::filesystem::temp_directory_path() / "gba_instance_pool_bench.gba";
+    {
+        std::vector<char> bytes(kRomBytes, 0);
+        for (std::size_t i = 0; i < kProgram.size(); ++i) {
+            bytes[i * 2U] = static_cast<char>(kProgram[i] & 0xFFU);
+            bytes[(i * 2U) + 1U] = static_cast<char>(kProgram[i] >> 8U);
+        }
+        std::ranges::copy(kFlashId, bytes.begin() + kFlashIdOffset);
+        std::ofstream(rom, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    const auto intro = boot(rom);
+    if (intro == nullptr) {
+        return 1;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Pool: restore in place
+    {
+        InstancePool pool(*intro, 1U);
+        auto sys = pool.acquire();
+        double seconds = 0.0;
+        std::size_t pages = 0;
+        for (int e = 0; e < kEpisodes; ++e) {
+            sys->run_frame();
+            const auto t0 = Clock::now();
+            pages += pool.reset(*sys);
+            seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+        }
+        report("pool", seconds, kEpisodes, static_cast<double>(pages) / kEpisodes);
+    }
+
+    // Save state: load_state() of the intro state into the same instance
+    {
+        std::vector<std::uint8_t> state;
+        intro->save_state(state);
+        const auto sys = intro->fork();
+        double seconds = 0.0;
+        for (int e = 0; e < kEpisodes; ++e) {
+            sys->run_frame();
+            const auto t0 = Clock::now();
+            if (!sys->load_state(state)) {
+                return 1;
+            }
+            seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+        }
+        report("load_state", seconds, kEpisodes, 0.0);
+    }
+
+    // Reload: a new instance, the ROM from disk and the intro replayed
+    {
+        const auto t0 = Clock::now();
+        for (int r = 0; r < kReloads; ++r) {
+            if (boot(rom) == nullptr) {
+                return 1;
+            }
+        }
+        report("reload", std::chrono::duration<double>(Clock::now() - t0).count(), kReloads, 0.0);
+    }
+
+    std::filesystem::remove(rom);
+    return 0;
+}
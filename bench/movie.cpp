@@ -0,0 +1,68 @@
+// bench/movie.cpp
+// Seek cost in a recorded input movie: keyframe load + catch-up vs replaying from frame 0.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/movie.h"
+#include "core/system/system.h"
+
+using gba::IORegs;
+using gba::MMU;
+using gba::Movie;
+using gba::MovieConfig;
+using gba::PPU;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Millis = std::chrono::duration<double, std::milli>;
+
+    constexpr std::uint64_t kFrames = 1200U; // 20 s of gameplay
+    constexpr std::uint32_t kInterval = 300U;
+    constexpr std::uint64_t kSeekStride = 97U;
+} // namespace
+
+auto main() -> int {
+    System sys;
+    sys.reset();
+    sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, PPU::kMode3 | PPU::kDispcntBg2);
+    Movie movie(MovieConfig{kInterval});
+
+    const auto r0 = Clock::now();
+    for (std::uint64_t f = 0; f < kFrames; ++f) {
+        movie.record_frame(sys, static_cast<std::uint16_t>((f / 7U) & IORegs::kKeyMask));
+    }
+    const Millis recordTime = Clock::now() - r0;
+
+    Millis total{};
+    Millis worst{};
+    int seeks = 0;
+    bool ok = true;
+    for (std::uint64_t target = kSeekStride; target < kFrames; target += kSeekStride) {
+        const auto t0 = Clock::now();
+        ok = movie.seek(sys, target) && ok;
+        const Millis elapsed = Clock::now() - t0;
+        total += elapsed;
+        worst = std::max(worst, elapsed);
+        ++seeks;
+    }
+
+    const double frameMs = recordTime.count() / static_cast<double>(kFrames);
+    std::cout << std::fixed << std::setprecision(2) << "frames " << kFrames << " interval " << kInterval << '\n'
+              << "keyframes " << movie.keyframe_count() << '\n'
+              << "keyframe_kib_avg " << (static_cast<double>(movie.keyframe_bytes()) / 1024.0 /
+                                         static_cast<double>(movie.keyframe_count()))
+              << '\n'
+              << "record_ms_per_frame " << frameMs << '\n'
+              << "seek_ms_avg " << (total.count() / seeks) << '\n'
+              << "seek_ms_worst " << worst.count() << '\n'
+              << "replay_from_0_ms_avg_est " << (frameMs * static_cast<double>(kFrames) / 2.0) << '\n'
+              << "seeks_ok " << (ok ? "yes" : "NO") << '\n';
+    return ok ? 0 : 1;
+}
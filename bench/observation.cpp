@@ -0,0 +1,114 @@
+// bench/observation.cpp
+// Host time per frame of PPU output for an agent wanting 84x84 grayscale, on a
+// noisy mode 3 picture: full colour only (reference), full colour then a separate
+// box-filter pass over the framebuffer (converting afterwards), full colour plus the
+// PPU's Gray8 observation, and the observation alone with colour output off.
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "core/bus/bus.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+
+using gba::Bus;
+using gba::IORegs;
+using gba::MMU;
+using gba::ObservationConfig;
+using gba::ObservationFormat;
+using gba::PPU;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int kFrames = 300;
+    constexpr std::uint32_t kSize = 84U;
+
+    void render_frame(PPU &ppu, const Bus &bus) {
+        for (std::uint16_t line = 0; line < PPU::kScreenHeight; ++line) {
+            ppu.render_line(line, bus);
+        }
+    }
+
+    // What an agent does without PPU support: read the finished framebuffer back and reduce it
+    void downscale_after(std::span<const std::uint16_t> frame, std::vector<std::uint8_t> &out) {
+        std::array<std::uint32_t, kSize> sums{};
+        std::array<std::uint32_t, kSize> counts{};
+        std::uint32_t row = 0;
+        std::uint32_t rows = 0;
+        for (std::uint32_t y = 0; y < PPU::kScreenHeight; ++y) {
+            for (std::uint32_t x = 0; x < PPU::kScreenWidth; ++x) {
+                const std::uint16_t p = frame[(y * PPU::kScreenWidth) + x];
+                const std::uint32_t r = p & 0x1FU;
+                const std::uint32_t g = (p >> 5U) & 0x1FU;
+                const std::uint32_t b = (p >> 10U) & 0x1FU;
+                const std::uint32_t ox = x * kSize / PPU::kScreenWidth;
+                sums[ox] += ((77U * ((r << 3U) | (r >> 2U))) + (150U * ((g << 3U) | (g >> 2U))) +
+                             (29U * ((b << 3U) | (b >> 2U))) + 128U) >> 8U;
+                ++counts[ox];
+            }
+            ++rows;
+            if (y + 1U == PPU::kScreenHeight || (y + 1U) * kSize / PPU::kScreenHeight != row) {
+                for (std::uint32_t x = 0; x < kSize; ++x) {
+                    out[(row * kSize) + x] = static_cast<std::uint8_t>((sums[x] + (counts[x] / 2U)) / counts[x]);
+                }
+                sums.fill(0U);
+                counts.fill(0U);
+                ++row;
+                rows = 0;
+            }
+        }
+    }
+
+    template <typename Frame> void report(const char *name, Frame frame) {
+        const auto t0 = Clock::now();
+        for (int f = 0; f < kFrames; ++f) {
+            frame();
+        }
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / kFrames;
+        std::cout << std::left << std::setw(22) << name << std::right << "  us/frame " << std::setw(8) << us << '\n';
+    }
+} // namespace
+
+auto main() -> int {
+    Bus bus;
+    bus.reset();
+    bus.write16(MMU::IO_BASE + IORegs::kOffDISPCNT, PPU::kMode3 | PPU::kDispcntBg2);
+    std::uint32_t seed = 1U;
+    for (std::uint32_t i = 0; i < PPU::kPixels; ++i) {
+        seed = (seed * 1664525U) + 1013904223U;
+        bus.write16(MMU::VRAM_BASE + (i * 2U), static_cast<std::uint16_t>(seed >> 17U));
+    }
+    std::cout << std::fixed << std::setprecision(1) << "observation " << kSize << "x" << kSize << " Gray8, "
+              << kFrames << " frames\n";
+
+    PPU colour;
+    report("colour only", [&] { render_frame(colour, bus); });
+
+    std::vector<std::uint8_t> after(std::size_t{kSize} * kSize);
+    report("colour + convert after", [&] {
+        render_frame(colour, bus);
+        downscale_after(colour.framebuffer(), after);
+    });
+
+    PPU both;
+    if (!both.set_observation(ObservationConfig{ObservationFormat::Gray8, kSize, kSize})) {
+        return 1;
+    }
+    report("colour + observation", [&] { render_frame(both, bus); });
+
+    PPU agent;
+    agent.set_color_output(false);
+    if (!agent.set_observation(ObservationConfig{ObservationFormat::Gray8, kSize, kSize})) {
+        return 1;
+    }
+    report("observation only", [&] { render_frame(agent, bus); });
+
+    const bool same = std::equal(after.begin(), after.end(), agent.observation().begin());
+    std::cout << "observation matches the converted frame: " << (same ? "yes" : "no") << '\n';
+    return same ? 0 : 1;
+}
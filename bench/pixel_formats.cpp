@@ -0,0 +1,92 @@
+// bench/pixel_formats.cpp
+// Host time per frame to get a noisy mode 3 picture out in each output format:
+// the PPU emitting the format from its line buffers (native) vs drawing BGR555 and
+// converting the finished frame with convert_frame() (downstream, as a consumer
+// without native support would). Also checks both give the same bytes.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "core/bus/bus.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/pixel_convert.h"
+#include "core/ppu/ppu.h"
+
+using gba::Bus;
+using gba::IORegs;
+using gba::MMU;
+using gba::PixelFormat;
+using gba::PPU;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int kFrames = 300;
+
+    struct Format {
+        PixelFormat format;
+        const char *name;
+    };
+    constexpr std::array kFormats{Format{PixelFormat::BGR555, "BGR555"}, Format{PixelFormat::XRGB8888, "XRGB8888"},
+                                  Format{PixelFormat::RGB24, "RGB24"}, Format{PixelFormat::YUV420, "YUV420"}};
+
+    void render_frame(PPU &ppu, const Bus &bus) {
+        for (std::uint16_t line = 0; line < PPU::kScreenHeight; ++line) {
+            ppu.render_line(line, bus);
+        }
+    }
+
+    template <typename Frame> auto us_per_frame(Frame frame) -> double {
+        const auto t0 = Clock::now();
+        for (int f = 0; f < kFrames; ++f) {
+            frame();
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / kFrames;
+    }
+} // namespace
+
+auto main() -> int {
+    Bus bus;
+    bus.reset();
+    bus.write16(MMU::IO_BASE + IORegs::kOffDISPCNT, PPU::kMode3 | PPU::kDispcntBg2);
+    std::uint32_t seed = 1U;
+    for (std::uint32_t i = 0; i < PPU::kPixels; ++i) {
+        seed = (seed * 1664525U) + 1013904223U;
+        bus.write16(MMU::VRAM_BASE + (i * 2U), static_cast<std::uint16_t>(seed >> 17U));
+    }
+    std::cout << std::fixed << std::setprecision(1) << "output formats, 240x160 mode 3 noise, " << kFrames
+              << " frames\n"
+              << std::left << std::setw(10) << "format" << std::right << std::setw(8) << "KiB" << std::setw(12)
+              << "native us" << std::setw(14) << "downstream us" << "  same\n";
+
+    bool all_same = true;
+    for (const Format &entry : kFormats) {
+        const std::size_t bytes = gba::pixel_format_bytes(entry.format, PPU::kScreenWidth, PPU::kScreenHeight);
+
+        PPU native;
+        native.set_output_format(entry.format);
+        const double native_us = us_per_frame([&] { render_frame(native, bus); });
+
+        PPU bgr555;
+        std::vector<std::uint8_t> converted(bytes);
+        bool ok = true;
+        const double downstream_us = us_per_frame([&] {
+            render_frame(bgr555, bus);
+            ok = gba::convert_frame(entry.format, bgr555.framebuffer(), PPU::kScreenWidth, PPU::kScreenHeight,
+                                    converted) &&
+                 ok;
+        });
+
+        const bool same = ok && std::ranges::equal(native.output(), converted);
+        all_same = all_same && same;
+        std::cout << std::left << std::setw(10) << entry.name << std::right << std::setw(8)
+                  << static_cast<double>(bytes) / 1024.0 << std::setw(12) << native_us << std::setw(14)
+                  << downstream_us << "  " << (same ? "yes" : "no") << '\n';
+    }
+    return all_same ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+// bench/resampler.cpp
+// Throughput of the APU output resampler for every SOUNDBIAS rate -> 48 kHz.
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <vector>
+#include "core/apu/resampler.h"
+
+using gba::AudioFrame;
+using gba::Resampler;
+
+namespace {
+    constexpr double kHostRate = 48000.0;
+    constexpr double kSecondsOfAudio = 20.0;
+    constexpr double kToneHz = 440.0;
+    constexpr double kAmplitude = 12000.0;
+    constexpr std::size_t kChunkFrames = 1024; // roughly one emulated frame at 64 KiHz
+    constexpr double kDriftAdjust = 1.002;     // exercise the dynamic-rate path mid-run
+
+    auto make_input(double rate, std::size_t count) -> std::vector<AudioFrame> {
+        std::vector<AudioFrame> frames(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const double phase = 2.0 * std::numbers::pi * kToneHz * static_cast<double>(i) / rate;
+            const auto sample = static_cast<std::int16_t>(std::lrint(kAmplitude * std::sin(phase)));
+            frames[i] = AudioFrame{sample, sample};
+        }
+        return frames;
+    }
+} // namespace
+
+auto main() -> int {
+    // SOUNDBIAS bits 14-15: 32768 << n Hz
+    const std::vector<double> rates{32768.0, 65536.0, 131072.0, 262144.0};
+
+    std::cout << "rate_in_hz  taps  in_msamples_per_s  out_msamples_per_s  realtime_x\n";
+    for (const double rate : rates) {
+        const auto inputCount = static_cast<std::size_t>(rate * kSecondsOfAudio);
+        const auto input = make_input(rate, inputCount);
+        std::vector<AudioFrame> output(kChunkFrames * 8U);
+
+        Resampler rs;
+        rs.configure(rate, kHostRate);
+
+        std::size_t produced = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t offset = 0; offset < inputCount; offset += kChunkFrames) {
+            if (offset == inputCount / 2U) {
+                rs.set_ratio_adjust(kDriftAdjust);
+            }
+            const std::size_t count = std::min(kChunkFrames, inputCount - offset);
+            const auto result = rs.process(std::span(input).subspan(offset, count), output);
+            produced += result.produced;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const double inRate = static_cast<double>(inputCount) / elapsed.count();
+        const double outRate = static_cast<double>(produced) / elapsed.count();
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << rate << std::setw(6) << rs.taps()
+                  << std::setw(19) << (inRate / 1e6) << std::setw(20) << (outRate / 1e6) << std::setw(12)
+                  << (kSecondsOfAudio / elapsed.count()) << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+// bench/rewind.cpp
+// Rewind history cost: caller-side push time, delta size and step-back latency.
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/state/rewind.h"
+#include "core/system/system.h"
+
+using gba::MMU;
+using gba::RewindBuffer;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    constexpr int kFrames = 600;                  // 10 s of history
+    constexpr std::uint32_t kBytesPerFrame = 2048; // simulated game writes per frame
+    constexpr std::uint32_t kWriteStride = 61U;
+    constexpr int kStepsBack = 60;
+} // namespace
+
+auto main() -> int {
+    System sys;
+    sys.reset();
+    RewindBuffer rewind;
+    std::vector<std::uint8_t> state;
+
+    Micros pushTime{};
+    std::uint32_t cursor = 0;
+    const auto start = Clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        for (std::uint32_t i = 0; i < kBytesPerFrame; ++i) {
+            cursor = (cursor + kWriteStride) % (MMU::EWRAM_SIZE + MMU::VRAM_SIZE);
+            const std::uint32_t addr = cursor < MMU::EWRAM_SIZE ? MMU::EWRAM_BASE + cursor
+                                                                 : MMU::VRAM_BASE + (cursor - MMU::EWRAM_SIZE);
+            sys.bus().write8(addr, static_cast<std::uint8_t>(f + i));
+        }
+        sys.save_state(state);
+        const auto t0 = Clock::now();
+        rewind.push(state);
+        pushTime += Clock::now() - t0;
+    }
+    rewind.flush();
+    const Micros total = Clock::now() - start;
+
+    Micros stepTime{};
+    bool ok = true;
+    for (int i = 0; i < kStepsBack; ++i) {
+        const auto t0 = Clock::now();
+        ok = rewind.step_back(state) && ok;
+        stepTime += Clock::now() - t0;
+    }
+
+    const double history = static_cast<double>(rewind.compressed_bytes()) + static_cast<double>(state.size());
+    std::cout << "state_bytes " << state.size() << '\n'
+              << std::fixed << std::setprecision(2) << "snapshots " << rewind.size() << '\n'
+              << "avg_delta_bytes " << (static_cast<double>(rewind.compressed_bytes()) / (rewind.size() - 1U))
+              << '\n'
+              << "history_mib " << (history / (1024.0 * 1024.0)) << '\n'
+              << "push_us " << (pushTime.count() / kFrames) << '\n'
+              << "wall_us_per_frame " << (total.count() / kFrames) << '\n'
+              << "step_back_us " << (stepTime.count() / kStepsBack) << '\n'
+              << "ok " << (ok ? "yes" : "no") << '\n';
+    return ok ? 0 : 1;
+}
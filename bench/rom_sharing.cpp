@@ -0,0 +1,92 @@
+// bench/rom_sharing.cpp
+// Memory per instance with a 16 MiB ROM: 500 Systems mapping one shared RomImage
+// (through RomCache, as BatchRunner does) against a few Systems each loading
+// their own copy, extrapolated to 500. Reports private/shared KiB per instance,
+// the projected total for 500 and the time to bring one instance up either way.
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "core/mmu/footprint.h"
+#include "core/mmu/rom_image.h"
+#include "core/system/system.h"
+
+using gba::MemoryFootprint;
+using gba::RomCache;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kRomBytes = 16U << 20U; // the largest cartridge the bus maps
+    constexpr std::size_t kSharedInstances = 500U;
+    constexpr std::size_t kCopiedInstances = 8U; // enough to measure; 500 copies would need 8 GiB
+    constexpr double kKiB = 1024.0;
+    constexpr double kMiB = 1024.0 * 1024.0;
+
+    void report(const char *name, const MemoryFootprint &each, double seconds, std::size_t built) {
+        const double perInstance = static_cast<double>(each.private_bytes);
+        const double projected = (perInstance * kSharedInstances) + static_cast<double>(each.shared_bytes);
+        std::cout << std::left << std::setw(7) << name << std::right << "  private KiB " << std::setw(8)
+                  << (perInstance / kKiB) << "  shared KiB " << std::setw(8)
+                  << (static_cast<double>(each.shared_bytes) / kKiB) << "  total for " << kSharedInstances << ": "
+                  << std::setw(8) << (projected / kMiB) << " MiB  setup us " << std::setw(8)
+                  << (seconds * 1e6 / static_cast<double>(built)) << '\n';
+    }
+} // namespace
+
+auto main() -> int {
+    const auto rom = std::filesystem::temp_directory_path() / "gba_rom_sharing_bench.gba";
+    {
+        std::vector<char> bytes(kRomBytes);
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<char>(i * 31U);
+        }
+        std::ofstream(rom, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    std::cout << std::fixed << std::setprecision(1) << "ROM " << (kRomBytes >> 20U) << " MiB\n";
+
+    // Shared: one image, every instance maps it
+    {
+        RomCache cache;
+        std::vector<std::unique_ptr<System>> systems;
+        systems.reserve(kSharedInstances);
+        const auto t0 = Clock::now();
+        for (std::size_t i = 0; i < kSharedInstances; ++i) {
+            auto sys = std::make_unique<System>();
+            sys->reset();
+            const auto image = cache.load(rom);
+            if (image == nullptr) {
+                return 1;
+            }
+            sys->set_gamepak(image);
+            systems.push_back(std::move(sys));
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        report("shared", systems.front()->memory_footprint(), seconds, systems.size());
+    }
+
+    // Copied: each instance reads the file into its own buffer
+    {
+        std::vector<std::unique_ptr<System>> systems;
+        const auto t0 = Clock::now();
+        for (std::size_t i = 0; i < kCopiedInstances; ++i) {
+            auto sys = std::make_unique<System>();
+            sys->reset();
+            if (!sys->load_gamepak(rom)) {
+                return 1;
+            }
+            systems.push_back(std::move(sys));
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        report("copied", systems.front()->memory_footprint(), seconds, systems.size());
+    }
+
+    std::filesystem::remove(rom);
+    return 0;
+}
@@ -0,0 +1,49 @@
+// bench/run_ahead.cpp
+// Host CPU time per frame with run-ahead of K = 0..kMaxAhead frames.
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/run_ahead.h"
+#include "core/system/system.h"
+
+using gba::IORegs;
+using gba::MMU;
+using gba::PPU;
+using gba::RunAhead;
+using gba::System;
+
+namespace {
+    constexpr int kHostFrames = 60;
+    constexpr std::uint32_t kMaxAhead = 4U;
+
+    auto us_per_frame(std::uint32_t ahead) -> double {
+        System sys;
+        sys.reset();
+        sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, PPU::kMode3 | PPU::kDispcntBg2);
+        RunAhead runAhead(sys);
+        runAhead.set_frames(ahead);
+
+        bool ok = runAhead.run_frame(0U); // warm-up: sizes the state buffer
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kHostFrames; ++i) {
+            ok = runAhead.run_frame(IORegs::kKeyA) && ok;
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return ok ? elapsed.count() / kHostFrames : -1.0;
+    }
+} // namespace
+
+auto main() -> int {
+    const double base = us_per_frame(0U);
+    std::cout << std::fixed << std::setprecision(1) << "K   us/frame   cost_vs_K0\n";
+    for (std::uint32_t k = 0; k <= kMaxAhead; ++k) {
+        const double us = (k == 0U) ? base : us_per_frame(k);
+        std::cout << k << "   " << std::setw(9) << us << "   " << std::setprecision(2) << (us / base) << "x\n"
+                  << std::setprecision(1);
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+// bench/save_state.cpp
+// Save/load round trip of the full machine state into a reused buffer.
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/system/system.h"
+
+using gba::MMU;
+using gba::System;
+
+namespace {
+    constexpr int kIterations = 2000;
+    constexpr std::uint32_t kPatternStride = 0x101U; // touch every region with varying data
+} // namespace
+
+auto main() -> int {
+    System sys;
+    sys.reset();
+    for (std::uint32_t off = 0; off < MMU::EWRAM_SIZE; off += kPatternStride) {
+        sys.bus().write8(MMU::EWRAM_BASE + off, static_cast<std::uint8_t>(off));
+    }
+    for (std::uint32_t off = 0; off < MMU::VRAM_SIZE; off += kPatternStride) {
+        sys.bus().write8(MMU::VRAM_BASE + off, static_cast<std::uint8_t>(off));
+    }
+    sys.run_frame();
+
+    std::vector<std::uint8_t> state;
+    sys.save_state(state); // first save sizes the buffer
+
+    std::chrono::duration<double, std::micro> saveTime{};
+    std::chrono::duration<double, std::micro> loadTime{};
+    bool ok = true;
+    for (int i = 0; i < kIterations; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        sys.save_state(state);
+        const auto t1 = std::chrono::steady_clock::now();
+        ok = sys.load_state(state) && ok;
+        const auto t2 = std::chrono::steady_clock::now();
+        saveTime += t1 - t0;
+        loadTime += t2 - t1;
+    }
+
+    std::cout << "state_bytes " << state.size() << '\n'
+              << std::fixed << std::setprecision(2) << "save_us " << (saveTime.count() / kIterations) << '\n'
+              << "load_us " << (loadTime.count() / kIterations) << '\n'
+              << "round_trip_us " << ((saveTime + loadTime).count() / kIterations) << '\n'
+              << "ok " << (ok ? "yes" : "no") << '\n';
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// bench/state_delta.cpp
+// Bytes and host time per frame: full save states vs dirty-page deltas, plus replay.
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "core/apu/apu.h"
+#include "core/mmu/mmu.h"
+#include "core/mmu/paged_memory.h"
+#include "core/system/system.h"
+
+using gba::AudioMode;
+using gba::MMU;
+using gba::PagedMemory;
+using gba::System;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    constexpr int kFrames = 120;
+    constexpr std::uint32_t kTouchedPerFrame = 24U; // scattered game-state writes
+    constexpr std::uint32_t kTouchStride = 0x2345U;
+
+    void touch(System &sys, int frame) {
+        for (std::uint32_t b = 0; b < kTouchedPerFrame; ++b) {
+            const std::uint32_t off = ((static_cast<std::uint32_t>(frame) * 7U) + (b * kTouchStride)) % MMU::EWRAM_SIZE;
+            sys.bus().write8(MMU::EWRAM_BASE + off, static_cast<std::uint8_t>(frame));
+        }
+        sys.bus().write8(MMU::IWRAM_BASE + static_cast<std::uint32_t>(frame), 1U);
+    }
+} // namespace
+
+auto main() -> int {
+    System sys;
+    sys.reset();
+    sys.bus().apu().set_mode(AudioMode::TimingOnly);
+
+    std::vector<std::uint8_t> keyframe;
+    sys.save_state(keyframe);
+    sys.checkpoint();
+
+    std::vector<std::uint8_t> full;
+    std::vector<std::uint8_t> delta;
+    std::vector<std::vector<std::uint8_t>> deltas;
+    Micros fullTime{};
+    Micros deltaTime{};
+    std::size_t fullBytes = 0;
+    std::size_t deltaBytes = 0;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        touch(sys, frame);
+        sys.run_frame();
+
+        const auto t0 = Clock::now();
+        sys.save_state(full);
+        const auto t1 = Clock::now();
+        sys.save_delta(delta);
+        const auto t2 = Clock::now();
+        fullTime += t1 - t0;
+        deltaTime += t2 - t1;
+        fullBytes += full.size();
+        deltaBytes += delta.size();
+        deltas.push_back(delta);
+    }
+
+    auto rebuilt = keyframe;
+    bool ok = true;
+    const auto r0 = Clock::now();
+    for (const auto &d : deltas) {
+        ok = System::apply_delta(rebuilt, d) && ok;
+    }
+    const Micros replayTime = Clock::now() - r0;
+    ok = ok && rebuilt == full;
+
+    std::cout << std::fixed << std::setprecision(2) << "frames " << kFrames << '\n'
+              << "full_bytes_per_frame " << (fullBytes / kFrames) << '\n'
+              << "delta_bytes_per_frame " << (deltaBytes / kFrames) << '\n'
+              << "size_ratio " << (static_cast<double>(fullBytes) / static_cast<double>(deltaBytes)) << "x\n"
+              << "full_save_us " << (fullTime.count() / kFrames) << '\n'
+              << "delta_save_us " << (deltaTime.count() / kFrames) << '\n'
+              << "replay_us_per_delta " << (replayTime.count() / kFrames) << '\n'
+              << "replay_matches " << (ok ? "yes" : "NO") << '\n';
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// bench/step_many.cpp
+// Vectorised stepping through the C ABI, as an embedding host calls it: 64
+// instances x 60 steps of one frame each, observations gathered into one buffer.
+// One call per instance (set keys, run frame, copy the framebuffer) against
+// gba_step_many() with 1 worker (call overhead only) and with one worker per
+// hardware thread. Aggregate emulated frames per second.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "gba_capi.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kInstances = 64U;
+    constexpr int kSteps = 60;
+    constexpr std::size_t kFrameBytes = static_cast<std::size_t>(GBA_SCREEN_WIDTH) * GBA_SCREEN_HEIGHT * 2U; // BGR555
+    // KEYINPUT echo into EWRAM (see tests/capi_smoke.c)
+    constexpr std::array<std::uint16_t, 10> kProgram{0x2104U, 0x0609U, 0x2026U, 0x00C0U, 0x1809U,
+                                                     0x2302U, 0x061BU, 0x780AU, 0x701AU, 0xE7FDU};
+
+    auto action_for(std::size_t instance, int step) -> std::uint16_t {
+        return static_cast<std::uint16_t>((instance + static_cast<std::size_t>(step)) & 0x3FFU);
+    }
+
+    void report(const char *name, std::size_t workers, double seconds) {
+        const double frames = static_cast<double>(kInstances) * kSteps;
+        std::cout << std::left << std::setw(12) << name << std::right << " workers " << std::setw(2) << workers
+                  << "  fps " << std::setw(9) << (frames / seconds) << "  calls/step " << std::setw(4)
+                  << (workers == 0U ? 3U * kInstances : 1U) << '\n';
+    }
+} // namespace
+
+auto main() -> int {
+    std::vector<std::uint8_t> rom(1024U, 0U);
+    for (std::size_t i = 0; i < kProgram.size(); ++i) {
+        rom[i * 2U] = static_cast<std::uint8_t>(kProgram[i] & 0xFFU);
+        rom[(i * 2U) + 1U] = static_cast<std::uint8_t>(kProgram[i] >> 8U);
+    }
+    std::vector<gba_instance *> handles;
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        gba_instance *gba = gba_create();
+        if (gba == nullptr || !gba_load_rom_memory(gba, rom.data(), rom.size())) {
+            return 1;
+        }
+        handles.push_back(gba);
+    }
+    std::vector<std::uint8_t> observations(kInstances * kFrameBytes);
+    std::vector<std::uint16_t> actions(kInstances);
+    std::cout << std::fixed << std::setprecision(1) << "instances " << kInstances << " x " << kSteps
+              << " steps, host threads " << std::thread::hardware_concurrency() << '\n';
+
+    // One call per instance and per operation
+    auto t0 = Clock::now();
+    for (int s = 0; s < kSteps; ++s) {
+        for (std::size_t i = 0; i < kInstances; ++i) {
+            gba_set_keys(handles[i], action_for(i, s));
+            gba_run_frame(handles[i]);
+            std::memcpy(observations.data() + (i * kFrameBytes), gba_framebuffer(handles[i]), kFrameBytes);
+        }
+    }
+    report("per-instance", 0U, std::chrono::duration<double>(Clock::now() - t0).count());
+
+    const std::size_t hw = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+    for (const std::size_t workers : {std::size_t{1}, hw}) {
+        gba_stepper *stepper = gba_stepper_create(workers);
+        if (stepper == nullptr) {
+            return 1;
+        }
+        t0 = Clock::now();
+        for (int s = 0; s < kSteps; ++s) {
+            for (std::size_t i = 0; i < kInstances; ++i) {
+                actions[i] = action_for(i, s);
+            }
+            if (!gba_step_many(stepper, handles.data(), actions.data(), kInstances, observations.data(), kFrameBytes)) {
+                return 1;
+            }
+        }
+        report("step_many", workers, std::chrono::duration<double>(Clock::now() - t0).count());
+        gba_stepper_destroy(stepper);
+        if (hw == 1U) {
+            break;
+        }
+    }
+
+    for (gba_instance *gba : handles) {
+        gba_destroy(gba);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+// bench/texture_upload.cpp
+// Per-frame cost of getting a published BGR555 frame into a streaming texture's
+// XRGB8888 pixels (pitch padded like a driver's), without a GPU:
+//   staged  - convert into an intermediate XRGB8888 frame, then copy it row by row
+//             into the pitched texture (what SDL_UpdateTexture does after we convert)
+//   direct  - convert straight into the pitched texture (SDL_LockTexture path)
+// The frontend prints the same timing for the real texture (--upload lock|copy).
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "core/ppu/pixel_convert.h"
+#include "core/ppu/ppu.h"
+
+using gba::PPU;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    constexpr int kFrames = 5000;
+    constexpr std::size_t kBytesPerPixel = sizeof(std::uint32_t);
+    constexpr std::size_t kPitch = 1024U; // 240 * 4 = 960 bytes rounded up, as drivers tend to
+    constexpr std::size_t kRowBytes = PPU::kScreenWidth * kBytesPerPixel;
+
+    volatile std::uint32_t sink = 0; // keeps the conversions observable
+
+    template <typename Upload> auto time_per_frame(Upload &&upload) -> double {
+        const auto t0 = Clock::now();
+        for (int i = 0; i < kFrames; ++i) {
+            upload(i);
+        }
+        return Micros(Clock::now() - t0).count() / kFrames;
+    }
+} // namespace
+
+auto main() -> int {
+    std::vector<std::uint16_t> frame(PPU::kPixels);
+    for (std::size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<std::uint16_t>((i * 2654435761U) >> 17U);
+    }
+    std::vector<std::uint8_t> texture(kPitch * PPU::kScreenHeight);
+    std::vector<std::uint32_t> staging(PPU::kPixels);
+
+    const double staged = time_per_frame([&](int i) {
+        frame[0] = static_cast<std::uint16_t>(i);
+        gba::convert_xrgb8888(frame, PPU::kScreenWidth, PPU::kScreenHeight, staging.data(), kRowBytes);
+        for (std::size_t y = 0; y < PPU::kScreenHeight; ++y) {
+            std::memcpy(&texture[y * kPitch], &staging[y * PPU::kScreenWidth], kRowBytes);
+        }
+        sink = sink + texture[0];
+    });
+    const double direct = time_per_frame([&](int i) {
+        frame[0] = static_cast<std::uint16_t>(i);
+        gba::convert_xrgb8888(frame, PPU::kScreenWidth, PPU::kScreenHeight, texture.data(), kPitch);
+        sink = sink + texture[0];
+    });
+
+    std::cout << std::fixed << std::setprecision(2) << "frames " << kFrames << '\n'
+              << "staged_us " << staged << '\n'
+              << "direct_us " << direct << '\n'
+              << "saved " << ((1.0 - (direct / staged)) * 100.0) << "%\n";
+    return 0;
+}
@@ -0,0 +1,274 @@
+// src/capi/gba_capi.cpp
+#include "capi/gba_capi.h"
+#include "core/mmu/mmu.h"
+#include "core/mmu/rom_image.h"
+#include "core/system/batch_step.h"
+#include "core/system/system.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+// The handle: a System plus the scratch buffer save states go through
+struct gba_instance {
+    gba::System system;
+    std::vector<std::uint8_t> state;
+};
+
+// A BatchStepper plus the handle-to-System table step_many() rebuilds each call
+struct gba_stepper {
+    explicit gba_stepper(std::size_t threads) : stepper(threads) {}
+    gba::BatchStepper stepper;
+    std::vector<gba::System *> systems;
+};
+
+namespace {
+    using gba::MMU;
+    using gba::PagedMemory;
+    using gba::System;
+
+    static_assert(GBA_SCREEN_WIDTH * GBA_SCREEN_HEIGHT == gba::PPU::kPixels);
+    static_assert(GBA_RAM_PAGE_BYTES == PagedMemory::kPageBytes);
+    static_assert(GBA_KEY_A == gba::IORegs::kKeyA && GBA_KEY_L == gba::IORegs::kKeyL);
+    static_assert(GBA_OBSERVATION_GRAY8 == static_cast<int>(gba::ObservationFormat::Gray8) &&
+                  GBA_OBSERVATION_PALETTE_INDEX8 == static_cast<int>(gba::ObservationFormat::PaletteIndex8));
+    static_assert(GBA_PIXEL_XRGB8888 == static_cast<int>(gba::PixelFormat::XRGB8888) &&
+                  GBA_PIXEL_YUV420 == static_cast<int>(gba::PixelFormat::YUV420));
+
+    constexpr std::size_t kRegions = MMU::kStateRegionSizes.size();
+
+    auto region_of(const gba_instance &gba, gba_ram_region region) noexcept -> const PagedMemory * {
+        const auto &bus = gba.system.bus();
+        const std::array<const PagedMemory *, kRegions> regions{&bus.ewram(), &bus.iwram(), &bus.pal(), &bus.vram(),
+                                                                &bus.oam()};
+        const auto index = static_cast<std::size_t>(region);
+        return index < kRegions ? regions[index] : nullptr;
+    }
+
+    // Power-on with the current content; no BIOS means no boot code, so start at the cartridge
+    void power_on(System &system) noexcept {
+        system.soft_reset();
+        system.bus().apu().set_mode(gba::AudioMode::TimingOnly);
+        if (system.bus().bios_image() == nullptr) {
+            system.cpu().debug_set_program_counter(MMU::WS0_BASE);
+        }
+    }
+} // namespace
+
+extern "C" {
+
+auto gba_api_version() -> std::uint32_t { return GBA_CAPI_VERSION; }
+
+auto gba_create() -> gba_instance * {
+    try {
+        auto *gba = new gba_instance();
+        gba->system.reset();
+        power_on(gba->system);
+        return gba;
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void gba_destroy(gba_instance *gba) { delete gba; }
+
+auto gba_load_rom_file(gba_instance *gba, const char *path) -> bool {
+    try {
+        auto image = gba::RomImage::load(path);
+        if (image == nullptr || image->empty()) {
+            return false;
+        }
+        gba->system.set_gamepak(std::move(image));
+    } catch (const std::exception &) { // bad_alloc, or a path the filesystem library rejects
+        return false;
+    }
+    power_on(gba->system);
+    return true;
+}
+
+auto gba_load_rom_memory(gba_instance *gba, const std::uint8_t *data, std::size_t size) -> bool {
+    if (data == nullptr || size == 0U) {
+        return false;
+    }
+    try {
+        gba->system.set_gamepak(gba::RomImage::copy_of(std::span(data, size)));
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+    power_on(gba->system);
+    return true;
+}
+
+auto gba_load_bios_file(gba_instance *gba, const char *path) -> bool {
+    try {
+        auto image = gba::RomImage::load(path, MMU::BIOS_SIZE);
+        if (image == nullptr || image->empty()) {
+            return false;
+        }
+        gba->system.set_bios(std::move(image));
+    } catch (const std::exception &) {
+        return false;
+    }
+    power_on(gba->system);
+    return true;
+}
+
+void gba_reset(gba_instance *gba) { power_on(gba->system); }
+
+void gba_set_keys(gba_instance *gba, std::uint16_t pressed) { gba->system.bus().io().set_keys_pressed(pressed); }
+
+void gba_run_frame(gba_instance *gba) { gba->system.run_frame(); }
+
+void gba_run_cycles(gba_instance *gba, std::uint32_t cycles) { gba->system.run(cycles); }
+
+auto gba_frame_count(const gba_instance *gba) -> std::uint64_t { return gba->system.frame(); }
+
+auto gba_framebuffer(const gba_instance *gba) -> const std::uint16_t * {
+    return gba->system.ppu().framebuffer().data();
+}
+
+auto gba_set_pixel_format(gba_instance *gba, gba_pixel_format format) -> bool {
+    if (format < GBA_PIXEL_BGR555 || format > GBA_PIXEL_YUV420) {
+        return false;
+    }
+    try {
+        gba->system.ppu().set_output_format(static_cast<gba::PixelFormat>(format));
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+    return true;
+}
+
+auto gba_output(const gba_instance *gba, std::size_t *bytes) -> const std::uint8_t * {
+    const auto output = gba->system.ppu().output();
+    if (bytes != nullptr) {
+        *bytes = output.size();
+    }
+    return output.data();
+}
+
+auto gba_set_observation(gba_instance *gba, gba_observation_format format, std::uint32_t width, std::uint32_t height)
+    -> bool {
+    if (format < GBA_OBSERVATION_NONE || format > GBA_OBSERVATION_PALETTE_INDEX8) {
+        return false;
+    }
+    try {
+        return gba->system.ppu().set_observation({static_cast<gba::ObservationFormat>(format), width, height});
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+}
+
+void gba_set_color_output(gba_instance *gba, bool enabled) { gba->system.ppu().set_color_output(enabled); }
+
+auto gba_observation(const gba_instance *gba, std::size_t *bytes) -> const std::uint8_t * {
+    const auto observation = gba->system.ppu().observation();
+    if (bytes != nullptr) {
+        *bytes = observation.size();
+    }
+    return observation.empty() ? nullptr : observation.data();
+}
+
+auto gba_ram_size(gba_ram_region region) -> std::size_t {
+    const auto index = static_cast<std::size_t>(region);
+    return index < kRegions ? MMU::kStateRegionSizes.at(index) : 0U;
+}
+
+auto gba_ram_page(const gba_instance *gba, gba_ram_region region, std::size_t page, std::size_t *bytes)
+    -> const std::uint8_t * {
+    const PagedMemory *memory = region_of(*gba, region);
+    if (memory == nullptr || page >= memory->page_count()) {
+        return nullptr;
+    }
+    const auto view = memory->page(page);
+    if (bytes != nullptr) {
+        *bytes = view.size();
+    }
+    return view.data();
+}
+
+auto gba_read_ram(const gba_instance *gba, gba_ram_region region, std::size_t offset, void *out, std::size_t size)
+    -> bool {
+    const PagedMemory *memory = region_of(*gba, region);
+    if (memory == nullptr || offset > memory->size() || size > memory->size() - offset ||
+        (out == nullptr && size != 0U)) {
+        return false;
+    }
+    auto *dest = static_cast<std::uint8_t *>(out);
+    while (size > 0U) {
+        const std::size_t index = offset >> PagedMemory::kPageShift;
+        const std::size_t within = offset & PagedMemory::kPageMask;
+        const auto page = memory->page(index).subspan(within);
+        const std::size_t chunk = std::min(size, page.size());
+        std::memcpy(dest, page.data(), chunk);
+        dest += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+auto gba_save_state(gba_instance *gba, std::uint8_t *out, std::size_t capacity) -> std::size_t {
+    try {
+        gba->system.save_state(gba->state);
+    } catch (const std::bad_alloc &) {
+        return 0U;
+    }
+    if (out != nullptr && capacity >= gba->state.size()) {
+        std::memcpy(out, gba->state.data(), gba->state.size());
+    }
+    return gba->state.size();
+}
+
+auto gba_load_state(gba_instance *gba, const std::uint8_t *data, std::size_t size) -> bool {
+    if (data == nullptr) {
+        return false;
+    }
+    return gba->system.load_state(std::span(data, size));
+}
+
+auto gba_stepper_create(std::size_t threads) -> gba_stepper * {
+    try {
+        return new gba_stepper(threads);
+    } catch (const std::exception &) { // bad_alloc, or std::system_error from thread creation
+        return nullptr;
+    }
+}
+
+void gba_stepper_destroy(gba_stepper *stepper) { delete stepper; }
+
+auto gba_step_many_bytes(const gba_instance *gba) -> std::size_t {
+    return gba::BatchStepper::observation_bytes(gba->system);
+}
+
+auto gba_step_many(gba_stepper *stepper, gba_instance *const *handles, const std::uint16_t *actions, std::size_t n,
+                   std::uint8_t *observations, std::size_t stride) -> bool {
+    if (n == 0U) {
+        return true;
+    }
+    if (handles == nullptr || actions == nullptr) {
+        return false;
+    }
+    if (observations != nullptr && (stride == 0U || stride > std::numeric_limits<std::size_t>::max() / n)) {
+        return false; // an empty or wrapped-around buffer would read as "no copies"
+    }
+    try {
+        stepper->systems.resize(n);
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        stepper->systems[i] = &handles[i]->system;
+    }
+    const std::span<std::uint8_t> pictures =
+        observations != nullptr ? std::span(observations, n * stride) : std::span<std::uint8_t>();
+    return stepper->stepper.step(stepper->systems, std::span(actions, n), pictures, stride);
+}
+
+} // extern "C"
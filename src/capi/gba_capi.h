@@ -0,0 +1,171 @@
+/* src/capi/gba_capi.h */
+#ifndef GBA_CAPI_H
+#define GBA_CAPI_H
+
+/*
+ * Stable C ABI for embedding the emulator core (Python ctypes/cffi, C# P/Invoke, ...).
+ *
+ * One opaque gba_instance per emulated machine; nothing C++ crosses this header.
+ * Instances are independent and may run on different threads, but each one must
+ * be used by one thread at a time.
+ *
+ * Conventions
+ * - Functions returning bool report failure with false and leave the instance as
+ *   it was; handles passed in must be valid (gba_destroy(NULL) is a no-op).
+ * - Loading a ROM or BIOS powers the machine on again. Without a BIOS execution
+ *   starts at the cartridge (0x08000000).
+ * - Audio is not synthesised (timing only); this API has no audio output.
+ * - gba_framebuffer() and gba_ram_page() point straight into the core (no copy).
+ *   The framebuffer pointer is stable for the instance's lifetime. RAM is held in
+ *   4 KiB copy-on-write pages, so a page pointer is valid only until the next call
+ *   that runs or changes the instance (run, reset, load, gba_load_state).
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(GBA_CAPI_BUILD)
+#define GBA_CAPI __declspec(dllexport)
+#else
+#define GBA_CAPI __declspec(dllimport)
+#endif
+#else
+#define GBA_CAPI __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever a signature or behaviour changes incompatibly */
+#define GBA_CAPI_VERSION 1U
+
+#define GBA_SCREEN_WIDTH 240U
+#define GBA_SCREEN_HEIGHT 160U
+#define GBA_RAM_PAGE_BYTES 4096U
+
+/* Keypad bits for gba_set_keys() (set = pressed), as in KEYINPUT */
+#define GBA_KEY_A 0x0001U
+#define GBA_KEY_B 0x0002U
+#define GBA_KEY_SELECT 0x0004U
+#define GBA_KEY_START 0x0008U
+#define GBA_KEY_RIGHT 0x0010U
+#define GBA_KEY_LEFT 0x0020U
+#define GBA_KEY_UP 0x0040U
+#define GBA_KEY_DOWN 0x0080U
+#define GBA_KEY_R 0x0100U
+#define GBA_KEY_L 0x0200U
+
+typedef struct gba_instance gba_instance;
+typedef struct gba_stepper gba_stepper;
+
+/* Guest RAM regions, in save-state order */
+typedef enum gba_ram_region {
+    GBA_RAM_EWRAM = 0, /* 256 KiB at 0x02000000 */
+    GBA_RAM_IWRAM = 1, /* 32 KiB at 0x03000000 */
+    GBA_RAM_PAL = 2,   /* 1 KiB at 0x05000000 */
+    GBA_RAM_VRAM = 3,  /* 96 KiB at 0x06000000 */
+    GBA_RAM_OAM = 4,   /* 1 KiB at 0x07000000 */
+} gba_ram_region;
+
+/* GBA_CAPI_VERSION of the library actually loaded */
+GBA_CAPI uint32_t gba_api_version(void);
+
+/* Lifecycle: NULL when out of memory */
+GBA_CAPI gba_instance *gba_create(void);
+GBA_CAPI void gba_destroy(gba_instance *gba);
+
+/* Content. The bytes are copied; the caller's buffer may be freed afterwards. */
+GBA_CAPI bool gba_load_rom_file(gba_instance *gba, const char *path);
+GBA_CAPI bool gba_load_rom_memory(gba_instance *gba, const uint8_t *data, size_t size);
+GBA_CAPI bool gba_load_bios_file(gba_instance *gba, const char *path);
+
+/* Power-on state with the loaded ROM and BIOS kept */
+GBA_CAPI void gba_reset(gba_instance *gba);
+
+/* Execution. Keys apply from the next instruction on and stay until changed. */
+GBA_CAPI void gba_set_keys(gba_instance *gba, uint16_t pressed);
+GBA_CAPI void gba_run_frame(gba_instance *gba);
+GBA_CAPI void gba_run_cycles(gba_instance *gba, uint32_t cycles);
+GBA_CAPI uint64_t gba_frame_count(const gba_instance *gba);
+
+/* GBA_SCREEN_WIDTH x GBA_SCREEN_HEIGHT BGR555 pixels, rows packed (updated only while the pixel format is BGR555) */
+GBA_CAPI const uint16_t *gba_framebuffer(const gba_instance *gba);
+
+/*
+ * Native output formats: the PPU writes the picture in this format as it draws
+ * (default BGR555, where gba_output() is the framebuffer). XRGB8888 is one
+ * 0x00RRGGBB uint32_t per pixel, RGB24 three bytes R, G, B, and YUV420 planar
+ * I420 (BT.601 limited range: Y plane, then U and V at half size).
+ */
+typedef enum gba_pixel_format {
+    GBA_PIXEL_BGR555 = 0,
+    GBA_PIXEL_XRGB8888 = 1,
+    GBA_PIXEL_RGB24 = 2,
+    GBA_PIXEL_YUV420 = 3,
+} gba_pixel_format;
+
+/* false for an unknown format or out of memory, with the old format kept */
+GBA_CAPI bool gba_set_pixel_format(gba_instance *gba, gba_pixel_format format);
+/* The picture in the current format, rows packed; stable until the next gba_set_pixel_format() */
+GBA_CAPI const uint8_t *gba_output(const gba_instance *gba, size_t *bytes);
+
+/*
+ * Observations: a reduced picture the PPU writes while drawing, so agents need not
+ * convert the framebuffer. GRAY8 averages the source pixels behind each output
+ * pixel; PALETTE_INDEX8 samples the mode 4 palette index. gba_set_color_output(false)
+ * stops the full-colour framebuffer from being updated at all.
+ */
+typedef enum gba_observation_format {
+    GBA_OBSERVATION_NONE = 0,
+    GBA_OBSERVATION_GRAY8 = 1,
+    GBA_OBSERVATION_PALETTE_INDEX8 = 2,
+} gba_observation_format;
+
+/* false, with the old setting kept, for an unknown format or a size outside 1..240 x 1..160 */
+GBA_CAPI bool gba_set_observation(gba_instance *gba, gba_observation_format format, uint32_t width, uint32_t height);
+GBA_CAPI void gba_set_color_output(gba_instance *gba, bool enabled);
+/* width x height bytes, rows packed, stable until the next gba_set_observation(); NULL for NONE */
+GBA_CAPI const uint8_t *gba_observation(const gba_instance *gba, size_t *bytes);
+
+/* RAM: region size in bytes; zero-copy page `page` (NULL past the end; *bytes gets its length) */
+GBA_CAPI size_t gba_ram_size(gba_ram_region region);
+GBA_CAPI const uint8_t *gba_ram_page(const gba_instance *gba, gba_ram_region region, size_t page, size_t *bytes);
+/* Copy `size` bytes from `offset` of a region; false if the range is out of bounds */
+GBA_CAPI bool gba_read_ram(const gba_instance *gba, gba_ram_region region, size_t offset, void *out, size_t size);
+
+/*
+ * Save states. gba_save_state() returns the state's size and writes it to `out`
+ * only if `capacity` is large enough (call with NULL, 0 to size a buffer); 0 on
+ * allocation failure. gba_load_state() validates the blob (framing, every section's
+ * size, the save chip) before touching anything.
+ */
+GBA_CAPI size_t gba_save_state(gba_instance *gba, uint8_t *out, size_t capacity);
+GBA_CAPI bool gba_load_state(gba_instance *gba, const uint8_t *data, size_t size);
+
+/*
+ * Vectorised stepping. A stepper owns worker threads (0 = one per hardware
+ * thread; NULL if they cannot be started). gba_step_many() gives handles[i] the
+ * keys actions[i], runs one frame on every instance in parallel and copies each
+ * picture to observations + i * stride (NULL: no copies). The picture is the
+ * instance's observation when one is set (gba_set_observation), otherwise its
+ * gba_output() bytes; gba_step_many_bytes() gives its size. It returns when all
+ * are done; false, with nothing run, if handles or actions is NULL while n > 0,
+ * or if observations is not NULL and the instances are not configured alike
+ * (same observation, or none and the same pixel format), draw nothing (no
+ * observation and colour output off) or stride is below the picture size. The
+ * handles must be distinct; one call per stepper at a time.
+ */
+GBA_CAPI gba_stepper *gba_stepper_create(size_t threads);
+GBA_CAPI void gba_stepper_destroy(gba_stepper *stepper);
+GBA_CAPI size_t gba_step_many_bytes(const gba_instance *gba);
+GBA_CAPI bool gba_step_many(gba_stepper *stepper, gba_instance *const *handles, const uint16_t *actions, size_t n,
+                            uint8_t *observations, size_t stride);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GBA_CAPI_H */
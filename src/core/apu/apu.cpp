@@ -0,0 +1,216 @@
+// src/core/apu/apu.cpp
+#include "core/apu/apu.h"
+#include "core/state/state_io.h"
+
+#include <algorithm>
+
+namespace gba {
+
+    namespace {
+        constexpr std::uint32_t kByteBits = 8U;
+        constexpr std::uint32_t kByteMask = 0xFFU;
+        constexpr std::uint32_t kResolutionMask = 0x3U;
+
+        // DAC: 10-bit unsigned output (bias centred), DirectSound is 8-bit scaled x2 (50%) or x4 (100%)
+        constexpr int kDacMax = 0x3FF;
+        constexpr int kDacCenter = 0x200;
+        constexpr int kDacToPcmShift = 6; // 10-bit -> 16-bit signed
+        constexpr int kFullVolumeScale = 4;
+        constexpr int kHalfVolumeScale = 2;
+    } // namespace
+
+    // ------------------------------ FIFO -------------------------------------------
+
+    void APU::Fifo::push(std::int8_t sample) noexcept {
+        if (count == kFifoBytes) {
+            return; // overflow: hardware drops the write
+        }
+        data[(read + count) % kFifoBytes] = sample;
+        ++count;
+    }
+
+    void APU::Fifo::pop_into_latch() noexcept {
+        if (count == 0) {
+            return; // underflow: the DAC keeps the last sample
+        }
+        latched = data[read];
+        read = (read + 1U) % kFifoBytes;
+        --count;
+    }
+
+    // ------------------------------ lifecycle -------------------------------------------
+
+    APU::APU() : native_(kNativeChunk), output_(kOutputFrames) { reset(); }
+
+    void APU::reset() noexcept {
+        regs_.fill(0U);
+        regs_[kOffSOUNDBIAS - kOffSoundBase] = static_cast<u8>(kBiasResetValue & kByteMask);
+        regs_[kOffSOUNDBIAS + 1U - kOffSoundBase] = static_cast<u8>(kBiasResetValue >> kByteBits);
+        for (auto &fifo : fifos_) {
+            fifo.clear();
+            fifo.latched = 0;
+        }
+        dma_requests_ = 0;
+
+        sample_cycles_ = 0;
+        native_count_ = 0;
+        output_count_ = 0;
+        resampler_.reset();
+        resampler_.configure(static_cast<double>(sample_rate()), resampler_.output_rate());
+    }
+
+    void APU::save_state(StateWriter &out) const {
+        out.write(regs_);
+        out.write(fifos_);
+        out.write(dma_requests_);
+    }
+
+    auto APU::load_state(StateReader &in) noexcept -> bool {
+        if (!in.read(regs_) || !in.read(fifos_) || !in.read(dma_requests_)) {
+            return false;
+        }
+        // Host side follows the restored rate; the mixer phase carries on as on real time
+        native_count_ = 0;
+        resampler_.configure(static_cast<double>(sample_rate()), resampler_.output_rate());
+        return true;
+    }
+
+    // ------------------------------ registers -------------------------------------------
+
+    auto APU::reg16(u32 offset) const noexcept -> u16 {
+        const auto idx = static_cast<std::size_t>(offset - kOffSoundBase);
+        return static_cast<u16>(regs_.at(idx) | (regs_.at(idx + 1U) << kByteBits));
+    }
+
+    auto APU::read8(u32 offset) const noexcept -> u8 {
+        if (offset >= kOffFIFO_A) {
+            return 0U; // FIFOs are write-only
+        }
+        return regs_.at(static_cast<std::size_t>(offset - kOffSoundBase));
+    }
+
+    void APU::write8(u32 offset, u8 value) noexcept {
+        if (offset >= kOffFIFO_A && offset < kOffFIFO_A + kFifoRegBytes) {
+            fifos_[0].push(static_cast<std::int8_t>(value));
+            return;
+        }
+        if (offset >= kOffFIFO_B && offset < kOffFIFO_B + kFifoRegBytes) {
+            fifos_[1].push(static_cast<std::int8_t>(value));
+            return;
+        }
+
+        auto &slot = regs_.at(static_cast<std::size_t>(offset - kOffSoundBase));
+        slot = value;
+
+        // SOUNDCNT_H high byte: FIFO reset strobes act and read back as 0
+        if (offset == kOffSOUNDCNT_H + 1U) {
+            if ((value & (kCntHResetA >> kByteBits)) != 0U) {
+                fifos_[0].clear();
+            }
+            if ((value & (kCntHResetB >> kByteBits)) != 0U) {
+                fifos_[1].clear();
+            }
+            slot = static_cast<u8>(value & ~((kCntHResetA | kCntHResetB) >> kByteBits));
+            return;
+        }
+
+        // SOUNDBIAS resolution selects the mixer rate; the resampler follows
+        if (offset == kOffSOUNDBIAS + 1U && mode_ == AudioMode::Full) {
+            resampler_.configure(static_cast<double>(sample_rate()), resampler_.output_rate());
+        }
+    }
+
+    auto APU::sample_rate() const noexcept -> u32 {
+        const u32 resolution = (static_cast<u32>(reg16(kOffSOUNDBIAS)) >> kBiasResolutionShift) & kResolutionMask;
+        return kBaseSampleHz << resolution;
+    }
+
+    // ------------------------------ timing -------------------------------------------
+
+    void APU::on_timer_overflow(u32 timer) noexcept {
+        const u16 cntH = reg16(kOffSOUNDCNT_H);
+        if ((reg16(kOffSOUNDCNT_X) & kCntXMasterEnable) == 0U) {
+            return;
+        }
+        const std::array<u16, kFifoCount> timerSelect{kCntHTimerA, kCntHTimerB};
+        const std::array<u32, kFifoCount> request{kDmaRequestA, kDmaRequestB};
+        for (std::size_t i = 0; i < kFifoCount; ++i) {
+            const u32 selected = (cntH & timerSelect[i]) != 0U ? 1U : 0U;
+            if (selected != timer) {
+                continue;
+            }
+            fifos_[i].pop_into_latch();
+            if (fifos_[i].count <= kFifoDmaThreshold) {
+                dma_requests_ |= request[i];
+            }
+        }
+    }
+
+    void APU::advance(u32 cycles) noexcept {
+        if (mode_ == AudioMode::TimingOnly) {
+            return;
+        }
+        const u32 period = kCpuHz / sample_rate();
+        sample_cycles_ += cycles;
+        while (sample_cycles_ >= period) {
+            sample_cycles_ -= period;
+            native_[native_count_++] = mix_frame();
+            if (native_count_ == kNativeChunk) {
+                flush_native();
+            }
+        }
+    }
+
+    void APU::end_frame() noexcept {
+        if (native_count_ != 0U) {
+            flush_native();
+        }
+    }
+
+    // ------------------------------ mixer / host -------------------------------------------
+
+    auto APU::mix_frame() const noexcept -> AudioFrame {
+        const u16 cntH = reg16(kOffSOUNDCNT_H);
+        int left = 0;
+        int right = 0;
+        if ((reg16(kOffSOUNDCNT_X) & kCntXMasterEnable) != 0U) {
+            const int chanA = fifos_[0].latched * (((cntH & kCntHVolumeA) != 0U) ? kFullVolumeScale : kHalfVolumeScale);
+            const int chanB = fifos_[1].latched * (((cntH & kCntHVolumeB) != 0U) ? kFullVolumeScale : kHalfVolumeScale);
+            left += ((cntH & kCntHLeftA) != 0U) ? chanA : 0;
+            left += ((cntH & kCntHLeftB) != 0U) ? chanB : 0;
+            right += ((cntH & kCntHRightA) != 0U) ? chanA : 0;
+            right += ((cntH & kCntHRightB) != 0U) ? chanB : 0;
+        }
+
+        const int bias = static_cast<int>(reg16(kOffSOUNDBIAS) & kBiasLevelMask);
+        const auto toPcm = [bias](int level) {
+            const int dac = std::clamp(level + bias, 0, kDacMax);
+            return static_cast<std::int16_t>((dac - kDacCenter) * (1 << kDacToPcmShift));
+        };
+        return AudioFrame{toPcm(left), toPcm(right)};
+    }
+
+    void APU::flush_native() noexcept {
+        const auto pending = std::span<const AudioFrame>(native_.data(), native_count_);
+        const auto room = std::span<AudioFrame>(output_).subspan(output_count_);
+        output_count_ += resampler_.process(pending, room).produced;
+        native_count_ = 0; // anything that did not fit is dropped: the host is not draining
+    }
+
+    void APU::set_mode(AudioMode mode) noexcept {
+        if (mode == mode_) {
+            return;
+        }
+        mode_ = mode;
+        native_count_ = 0; // sample_cycles_ is frozen while TimingOnly and resumes with Full
+        // Resampler history is kept: toggling around hidden frames (run-ahead) must not click
+        if (mode_ == AudioMode::Full) {
+            resampler_.configure(static_cast<double>(sample_rate()), resampler_.output_rate());
+        }
+    }
+
+    void APU::set_host_rate(double hostHz) noexcept {
+        resampler_.configure(static_cast<double>(sample_rate()), hostHz);
+    }
+
+} // namespace gba
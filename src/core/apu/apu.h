@@ -0,0 +1,182 @@
+// src/core/apu/apu.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "core/apu/resampler.h"
+
+namespace gba {
+
+    class StateReader;
+    class StateWriter;
+
+    // What the APU spends host time on. Emulated state is identical in both modes.
+    enum class AudioMode : std::uint8_t {
+        Full,       // mix, filter and resample to the host rate
+        TimingOnly, // FIFOs, timer-driven sample latching and DMA requests only
+    };
+
+    /**
+     * Sound register block (0x04000060 – 0x040000A7), DirectSound subset.
+     *
+     * We model:
+     *   - SOUNDCNT_H (0x082) FIFO volume/enables/timer select, FIFO reset bits
+     *   - SOUNDCNT_X (0x084) master enable (bit 7)
+     *   - SOUNDBIAS  (0x088) bias level and sampling rate (bits 14-15)
+     *   - FIFO_A/B   (0x0A0/0x0A4, write-only, 32-byte queues of signed 8-bit samples)
+     * PSG channels 1-4 are storage only for now.
+     *
+     * Notes
+     * - A timer overflow (on_timer_overflow) pops the next sample of each FIFO bound to
+     *   that timer and raises a DMA request when 16 bytes or fewer remain; the DMA unit
+     *   collects them with take_dma_requests().
+     * - advance(cycles) runs the mixer at the SOUNDBIAS rate and feeds the resampler.
+     *   In AudioMode::TimingOnly it returns immediately: nothing the mixer does ever
+     *   feeds back into emulated state, so skipping it cannot desync a game.
+     */
+    class APU {
+      public:
+        using u8 = std::uint8_t;
+        using u16 = std::uint16_t;
+        using u32 = std::uint32_t;
+
+        // Offsets within the I/O window (relative to 0x04000000)
+        static constexpr u32 kOffSoundBase = 0x0060U;
+        static constexpr u32 kOffSoundEnd = 0x00A8U; // one past FIFO_B
+        static constexpr u32 kOffSOUNDCNT_H = 0x0082U;
+        static constexpr u32 kOffSOUNDCNT_X = 0x0084U;
+        static constexpr u32 kOffSOUNDBIAS = 0x0088U;
+        static constexpr u32 kOffFIFO_A = 0x00A0U;
+        static constexpr u32 kOffFIFO_B = 0x00A4U;
+        static constexpr u32 kFifoRegBytes = 4U;
+
+        // SOUNDCNT_H bits
+        static constexpr u16 kCntHVolumeA = 1U << 2; // 0 = 50%, 1 = 100%
+        static constexpr u16 kCntHVolumeB = 1U << 3;
+        static constexpr u16 kCntHRightA = 1U << 8;
+        static constexpr u16 kCntHLeftA = 1U << 9;
+        static constexpr u16 kCntHTimerA = 1U << 10; // 0 = timer 0, 1 = timer 1
+        static constexpr u16 kCntHResetA = 1U << 11; // write-only strobe
+        static constexpr u16 kCntHRightB = 1U << 12;
+        static constexpr u16 kCntHLeftB = 1U << 13;
+        static constexpr u16 kCntHTimerB = 1U << 14;
+        static constexpr u16 kCntHResetB = 1U << 15;
+        static constexpr u16 kCntXMasterEnable = 1U << 7;
+
+        // SOUNDBIAS fields
+        static constexpr u16 kBiasLevelMask = 0x03FFU;
+        static constexpr u16 kBiasResolutionShift = 14U;
+        static constexpr u16 kBiasResetValue = 0x0200U;
+
+        // Clocking
+        static constexpr u32 kCpuHz = 1U << 24U;     // 16.78 MHz system clock
+        static constexpr u32 kBaseSampleHz = 32768U; // SOUNDBIAS resolution 0
+
+        // DirectSound FIFOs
+        static constexpr std::size_t kFifoBytes = 32U;
+        static constexpr std::size_t kFifoDmaThreshold = 16U; // request a refill at <= 16 bytes
+        static constexpr std::size_t kFifoCount = 2U;
+        static constexpr u32 kDmaRequestA = 1U << 0;
+        static constexpr u32 kDmaRequestB = 1U << 1;
+
+        // Output staging
+        static constexpr std::size_t kNativeChunk = 256U;   // mixer frames per resampler call
+        static constexpr std::size_t kOutputFrames = 8192U; // host frames held until drained
+
+        APU();
+
+        void reset() noexcept;
+
+        [[nodiscard]] static constexpr auto owns(u32 offset) noexcept -> bool {
+            return offset >= kOffSoundBase && offset < kOffSoundEnd;
+        }
+
+        // Register access (offset relative to 0x04000000; MMU routes owns() here)
+        [[nodiscard]] auto read8(u32 offset) const noexcept -> u8;
+        void write8(u32 offset, u8 value) noexcept;
+
+        // Driven by the timer unit when timer 0 or 1 overflows
+        void on_timer_overflow(u32 timer) noexcept;
+
+        // DMA requests raised since the last call (kDmaRequestA | kDmaRequestB)
+        [[nodiscard]] auto take_dma_requests() noexcept -> u32 {
+            const u32 pending = dma_requests_;
+            dma_requests_ = 0;
+            return pending;
+        }
+
+        // Run the mixer for `cycles` system clocks (no-op in TimingOnly)
+        void advance(u32 cycles) noexcept;
+
+        // Push the mixer frames staged so far through the resampler (once per video frame)
+        void end_frame() noexcept;
+
+        // Host side
+        void set_mode(AudioMode mode) noexcept;
+        [[nodiscard]] auto mode() const noexcept -> AudioMode { return mode_; }
+        void set_host_rate(double hostHz) noexcept;
+        void set_ratio_adjust(double adjust) noexcept { resampler_.set_ratio_adjust(adjust); }
+        [[nodiscard]] auto sample_rate() const noexcept -> u32;
+
+        // Resampled host frames since the last consume_output()
+        [[nodiscard]] auto output() const noexcept -> std::span<const AudioFrame> {
+            return {output_.data(), output_count_};
+        }
+        void consume_output() noexcept { output_count_ = 0; }
+
+        // Host-side buffers (mixer, resampler, output)
+        void add_footprint(MemoryFootprint &footprint) const noexcept {
+            footprint.add((native_.capacity() + output_.capacity()) * sizeof(AudioFrame), false);
+            resampler_.add_footprint(footprint);
+        }
+
+        // Save states: registers, FIFOs and pending DMA requests. Host-side mixer state is
+        // not saved; loading keeps its phase, so run-ahead's restore every frame drops no samples.
+        void save_state(StateWriter &out) const;
+        [[nodiscard]] auto load_state(StateReader &in) noexcept -> bool;
+        [[nodiscard]] static constexpr auto state_bytes() noexcept -> std::size_t {
+            return sizeof(regs_) + sizeof(fifos_) + sizeof(dma_requests_);
+        }
+
+        // Inspection (tests, debugger)
+        [[nodiscard]] auto fifo_size(std::size_t fifo) const noexcept -> std::size_t { return fifos_.at(fifo).count; }
+        [[nodiscard]] auto fifo_latched(std::size_t fifo) const noexcept -> std::int8_t {
+            return fifos_.at(fifo).latched;
+        }
+
+      private:
+        struct Fifo {
+            std::array<std::int8_t, kFifoBytes> data{};
+            std::size_t read = 0;
+            std::size_t count = 0;
+            std::int8_t latched = 0; // sample currently driving the DAC
+
+            void clear() noexcept {
+                read = 0;
+                count = 0;
+            }
+            void push(std::int8_t sample) noexcept;
+            void pop_into_latch() noexcept;
+        };
+
+        std::array<u8, kOffSoundEnd - kOffSoundBase> regs_{};
+        std::array<Fifo, kFifoCount> fifos_{};
+        u32 dma_requests_ = 0;
+
+        // Mixer/host side (not emulated state)
+        AudioMode mode_ = AudioMode::Full;
+        u32 sample_cycles_ = 0; // cycles towards the next mixer frame (kept across loads and mode toggles)
+        Resampler resampler_;
+        std::vector<AudioFrame> native_;
+        std::size_t native_count_ = 0;
+        std::vector<AudioFrame> output_;
+        std::size_t output_count_ = 0;
+
+        [[nodiscard]] auto reg16(u32 offset) const noexcept -> u16;
+        [[nodiscard]] auto mix_frame() const noexcept -> AudioFrame;
+        void flush_native() noexcept;
+    };
+
+} // namespace gba
@@ -0,0 +1,78 @@
+// src/core/apu/audio_ring.h
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "core/apu/resampler.h" // AudioFrame
+
+namespace gba {
+
+    /**
+     * Single-producer / single-consumer lock-free ring of host-rate audio frames.
+     *
+     * The emulation thread pushes resampled frames; the SDL audio callback pops them.
+     * Neither side ever blocks or takes a lock: push() writes what fits, pop() reads
+     * what is there (the callback pads the rest with silence).
+     *
+     * Notes
+     * - Capacity is rounded up to a power of two so indices wrap with a mask.
+     * - head_ (consumer) and tail_ (producer) live on separate cache lines.
+     * - Indices grow monotonically; size is tail - head with unsigned wraparound.
+     */
+    class AudioRing {
+      public:
+        static constexpr std::size_t kCacheLine = 64;
+
+        explicit AudioRing(std::size_t capacity) : frames_(round_up_pow2(capacity)), mask_(frames_.size() - 1U) {}
+
+        // Producer side. Returns frames actually written (0..input.size()).
+        auto push(std::span<const AudioFrame> input) noexcept -> std::size_t {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            const std::size_t count = std::min(input.size(), capacity() - (tail - head));
+            for (std::size_t i = 0; i < count; ++i) {
+                frames_[(tail + i) & mask_] = input[i];
+            }
+            tail_.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        // Consumer side. Returns frames actually read (0..output.size()).
+        auto pop(std::span<AudioFrame> output) noexcept -> std::size_t {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            const std::size_t count = std::min(output.size(), tail - head);
+            for (std::size_t i = 0; i < count; ++i) {
+                output[i] = frames_[(head + i) & mask_];
+            }
+            head_.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        // Approximate from either side (exact from the side that is not running).
+        [[nodiscard]] auto size() const noexcept -> std::size_t {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+        [[nodiscard]] auto capacity() const noexcept -> std::size_t { return frames_.size(); }
+        [[nodiscard]] auto fill_ratio() const noexcept -> double {
+            return static_cast<double>(size()) / static_cast<double>(capacity());
+        }
+
+      private:
+        std::vector<AudioFrame> frames_;
+        std::size_t mask_;
+        alignas(kCacheLine) std::atomic<std::size_t> head_{0}; // next frame to pop
+        alignas(kCacheLine) std::atomic<std::size_t> tail_{0}; // next slot to push
+
+        static auto round_up_pow2(std::size_t value) noexcept -> std::size_t {
+            std::size_t pow2 = 1;
+            while (pow2 < value) {
+                pow2 <<= 1U;
+            }
+            return pow2;
+        }
+    };
+
+} // namespace gba
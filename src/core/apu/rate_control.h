@@ -0,0 +1,48 @@
+// src/core/apu/rate_control.h
+#pragma once
+#include <algorithm>
+
+namespace gba {
+
+    /**
+     * Dynamic rate control for the host audio path.
+     *
+     * The emulator and the audio device run on different clocks (59.73 Hz video vs
+     * a 48 kHz DAC crystal), so a fixed resampling ratio slowly under- or overruns
+     * the ring. Instead of a large safety margin we steer the ratio from the ring's
+     * fill level: above half full we produce slightly fewer host frames, below half
+     * full slightly more. The correction is bounded by kMaxDelta (0.5%), far below
+     * what is audible as pitch.
+     *
+     * The returned value feeds Resampler::set_ratio_adjust() (input consumed per
+     * output frame), so > 1.0 means "fewer output frames".
+     */
+    class DynamicRateControl {
+      public:
+        static constexpr double kMaxDelta = 0.005;  // +/-0.5% pitch budget
+        static constexpr double kTargetFill = 0.5;  // keep the ring half full
+        static constexpr double kSmoothing = 0.125; // one-pole filter on the measured fill
+
+        // Call once per produced batch with the ring's current fill (0..1).
+        [[nodiscard]] auto update(double fillRatio) noexcept -> double {
+            const double fill = std::clamp(fillRatio, 0.0, 1.0);
+            smoothed_fill_ += kSmoothing * (fill - smoothed_fill_);
+            const double error = (smoothed_fill_ - kTargetFill) / kTargetFill; // -1..1
+            adjust_ = 1.0 + (kMaxDelta * std::clamp(error, -1.0, 1.0));
+            return adjust_;
+        }
+
+        void reset() noexcept {
+            smoothed_fill_ = kTargetFill;
+            adjust_ = 1.0;
+        }
+
+        [[nodiscard]] auto adjust() const noexcept -> double { return adjust_; }
+        [[nodiscard]] auto smoothed_fill() const noexcept -> double { return smoothed_fill_; }
+
+      private:
+        double smoothed_fill_ = kTargetFill;
+        double adjust_ = 1.0;
+    };
+
+} // namespace gba
@@ -0,0 +1,184 @@
+// src/core/apu/resampler.cpp
+#include "core/apu/resampler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <new>
+#include <numbers>
+
+namespace gba {
+
+    namespace {
+        constexpr float kSampleMin = -32768.0F;
+        constexpr float kSampleMax = 32767.0F;
+        constexpr int kBesselTerms = 32; // I0 series converges well before this for beta <= 10
+
+        // Zeroth-order modified Bessel function of the first kind (Kaiser window).
+        auto bessel_i0(double value) noexcept -> double {
+            double sum = 1.0;
+            double term = 1.0;
+            const double halfSquared = (value * value) / 4.0;
+            for (int k = 1; k < kBesselTerms; ++k) {
+                term *= halfSquared / (static_cast<double>(k) * static_cast<double>(k));
+                sum += term;
+            }
+            return sum;
+        }
+
+        auto sinc(double value) noexcept -> double {
+            if (value == 0.0) {
+                return 1.0;
+            }
+            const double arg = std::numbers::pi * value;
+            return std::sin(arg) / arg;
+        }
+
+        auto to_sample(float value) noexcept -> std::int16_t {
+            return static_cast<std::int16_t>(std::lrint(std::clamp(value, kSampleMin, kSampleMax)));
+        }
+    } // namespace
+
+    Resampler::Resampler() : bank_(std::make_shared<std::vector<float>>((kPhases + 1) * kMaxTaps, 0.0F)) {
+        build_bank();
+        reset();
+    }
+
+    void Resampler::configure(double inputHz, double outputHz) noexcept {
+        if (inputHz <= 0.0 || outputHz <= 0.0) {
+            return;
+        }
+        if (inputHz == input_hz_ && outputHz == output_hz_) {
+            return;
+        }
+        if (bank_.use_count() != 1) { // shared with a fork: copy on write
+            try {
+                bank_ = std::make_shared<std::vector<float>>(bank_->size(), 0.0F);
+            } catch (const std::bad_alloc &) {
+                return; // keep filtering at the old rates
+            }
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire); // see PagedMemory::writable()
+        }
+        input_hz_ = inputHz;
+        output_hz_ = outputHz;
+        build_bank();
+    }
+
+    void Resampler::set_ratio_adjust(double adjust) noexcept {
+        if (adjust <= 0.0) {
+            return;
+        }
+        adjust_ = adjust;
+        step_ = (input_hz_ / output_hz_) * adjust_;
+    }
+
+    void Resampler::reset() noexcept {
+        for (auto &channel : history_) {
+            channel.fill(0.0F);
+        }
+        write_ = 0;
+        frac_ = 1.0; // >= 1 means "need another input before emitting"
+    }
+
+    // Tabulate h(d) = 2fc * sinc(2fc * d) * kaiser(d / half) for every phase, into a bank no fork shares.
+    void Resampler::build_bank() noexcept {
+        const double ratio = input_hz_ / output_hz_;
+        const double scaled = std::ceil(static_cast<double>(kBaseTaps) * std::max(1.0, ratio));
+        const auto wanted = static_cast<std::size_t>(scaled);
+        taps_ = std::min(kMaxTaps, (wanted + kTapAlign - 1) / kTapAlign * kTapAlign);
+
+        // Normalised to the input rate (cycles/sample): follow whichever Nyquist is lower.
+        const double cutoff = 0.5 * std::min(1.0, 1.0 / ratio) * kCutoffFraction;
+        const double half = static_cast<double>(taps_) / 2.0;
+        const double windowNorm = bessel_i0(kKaiserBeta);
+
+        for (std::size_t phase = 0; phase <= kPhases; ++phase) {
+            const double frac = static_cast<double>(phase) / static_cast<double>(kPhases);
+            float *row = &(*bank_)[phase * kMaxTaps];
+
+            double rowSum = 0.0;
+            for (std::size_t tap = 0; tap < taps_; ++tap) {
+                // distance (in input samples) between this tap and the output position
+                const double dist = static_cast<double>(tap) - half + 1.0 - frac;
+                const double x = std::clamp(dist / half, -1.0, 1.0);
+                const double window = bessel_i0(kKaiserBeta * std::sqrt(1.0 - (x * x))) / windowNorm;
+                const double coeff = 2.0 * cutoff * sinc(2.0 * cutoff * dist) * window;
+                row[tap] = static_cast<float>(coeff);
+                rowSum += coeff;
+            }
+            // Unity DC gain per phase so a rate change never shifts the level
+            for (std::size_t tap = 0; tap < taps_; ++tap) {
+                row[tap] = static_cast<float>(static_cast<double>(row[tap]) / rowSum);
+            }
+            std::fill(row + taps_, row + kMaxTaps, 0.0F);
+        }
+
+        set_ratio_adjust(adjust_);
+    }
+
+    void Resampler::push(const AudioFrame &frame) noexcept {
+        const auto left = static_cast<float>(frame.left);
+        const auto right = static_cast<float>(frame.right);
+        history_[0][write_] = left;
+        history_[0][write_ + kMaxTaps] = left;
+        history_[1][write_] = right;
+        history_[1][write_ + kMaxTaps] = right;
+        write_ = (write_ + 1) % kMaxTaps;
+    }
+
+    auto Resampler::emit(double frac) noexcept -> AudioFrame {
+        const double position = frac * static_cast<double>(kPhases);
+        const auto phase = std::min(static_cast<std::size_t>(position), kPhases - 1);
+        const auto blend = static_cast<float>(position - static_cast<double>(phase));
+
+        const float *row0 = &(*bank_)[phase * kMaxTaps];
+        const float *row1 = row0 + kMaxTaps;
+        const std::size_t taps = taps_;
+        for (std::size_t tap = 0; tap < taps; ++tap) {
+            blended_[tap] = row0[tap] + (blend * (row1[tap] - row0[tap]));
+        }
+
+        // Oldest sample of the window; the mirror half keeps it contiguous.
+        const std::size_t start = write_ + kMaxTaps - taps;
+        const float *left = &history_[0][start];
+        const float *right = &history_[1][start];
+        // One accumulator per lane: a strict float reduction would not vectorize without
+        // fast-math, kTapAlign independent partial sums do (and taps is a multiple of it).
+        std::array<float, kTapAlign> accLeft{};
+        std::array<float, kTapAlign> accRight{};
+        for (std::size_t tap = 0; tap < taps; tap += kTapAlign) {
+            for (std::size_t lane = 0; lane < kTapAlign; ++lane) {
+                accLeft[lane] += blended_[tap + lane] * left[tap + lane];
+                accRight[lane] += blended_[tap + lane] * right[tap + lane];
+            }
+        }
+        float sumLeft = 0.0F;
+        float sumRight = 0.0F;
+        for (std::size_t lane = 0; lane < kTapAlign; ++lane) {
+            sumLeft += accLeft[lane];
+            sumRight += accRight[lane];
+        }
+        return AudioFrame{to_sample(sumLeft), to_sample(sumRight)};
+    }
+
+    auto Resampler::process(std::span<const AudioFrame> input, std::span<AudioFrame> output) noexcept -> Result {
+        Result result{};
+        for (;;) {
+            // Drain every output that falls before the newest input sample
+            while (frac_ < 1.0) {
+                if (result.produced == output.size()) {
+                    return result;
+                }
+                output[result.produced++] = emit(frac_);
+                frac_ += step_;
+            }
+            if (result.consumed == input.size()) {
+                return result;
+            }
+            frac_ -= 1.0;
+            push(input[result.consumed++]);
+        }
+    }
+
+} // namespace gba
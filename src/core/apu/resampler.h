@@ -0,0 +1,106 @@
+// src/core/apu/resampler.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "core/mmu/footprint.h"
+
+namespace gba {
+
+    // One interleaved stereo sample as handed to the host (SDL AUDIO_S16 layout).
+    struct AudioFrame {
+        std::int16_t left = 0;
+        std::int16_t right = 0;
+    };
+
+    /**
+     * Polyphase windowed-sinc resampler for the APU output stage.
+     *
+     * The GBA mixer runs at the SOUNDBIAS rate (32/64/128/256 KiHz) while the host
+     * device wants 44.1/48 kHz. We convert with a Kaiser-windowed sinc whose taps are
+     * tabulated for kPhases sub-sample offsets; the output position between two
+     * phases linearly blends the neighbouring coefficient rows.
+     *
+     * Notes
+     * - The filter bank is allocated in the constructor and never resized.
+     *   configure() re-tabulates it when the nominal rates change (SOUNDBIAS
+     *   writes are rare): in place, or into a fresh bank while a fork still shares
+     *   this one (copy on write, allocated before the rates change).
+     *   set_ratio_adjust() only nudges the step and is cheap enough to call every
+     *   audio callback (dynamic rate control).
+     * - When downsampling the cutoff follows the output rate and the tap count
+     *   grows with the ratio (capped at kMaxTaps), so 256 KiHz -> 48 kHz does not alias.
+     * - The inner loops are straight float multiply-adds over contiguous arrays so
+     *   the compiler can vectorize them; the history is written twice (ring + mirror)
+     *   so a window of taps is always contiguous.
+     */
+    class Resampler {
+      public:
+        static constexpr std::size_t kPhases = 128;    // sub-sample offsets tabulated
+        static constexpr std::size_t kBaseTaps = 40;   // taps at ratio <= 1 (upsampling)
+        static constexpr std::size_t kMaxTaps = 224;   // cap for the steepest downsampling
+        static constexpr std::size_t kTapAlign = 8;    // keep tap counts a multiple of a SIMD width
+        static constexpr double kCutoffFraction = 0.9; // -6 dB point relative to the lower Nyquist
+        static constexpr double kKaiserBeta = 7.0;     // ~70 dB stopband
+
+        static constexpr double kDefaultInputHz = 32768.0; // SOUNDBIAS reset value
+        static constexpr double kDefaultOutputHz = 48000.0;
+
+        struct Result {
+            std::size_t consumed = 0; // input frames taken
+            std::size_t produced = 0; // output frames written
+        };
+
+        Resampler();
+
+        // Nominal rates; re-tabulates the bank, keeps history. A bank shared with a fork is
+        // replaced by a new allocation first; if that fails the old rates stay.
+        void configure(double inputHz, double outputHz) noexcept;
+
+        // Multiplier on the nominal input/output ratio (e.g. 0.995..1.005 for rate control).
+        void set_ratio_adjust(double adjust) noexcept;
+
+        // Clear history and fractional position (e.g. on APU reset).
+        void reset() noexcept;
+
+        // Consume input until it is exhausted or the output span is full.
+        [[nodiscard]] auto process(std::span<const AudioFrame> input, std::span<AudioFrame> output) noexcept
+            -> Result;
+
+        [[nodiscard]] auto input_rate() const noexcept -> double { return input_hz_; }
+        [[nodiscard]] auto output_rate() const noexcept -> double { return output_hz_; }
+        [[nodiscard]] auto ratio_adjust() const noexcept -> double { return adjust_; }
+        [[nodiscard]] auto taps() const noexcept -> std::size_t { return taps_; }
+
+        // Filter bank (shared with forks until reconfigured)
+        void add_footprint(MemoryFootprint &footprint) const noexcept {
+            footprint.add(bank_, bank_->size() * sizeof(float));
+        }
+
+      private:
+        static constexpr std::size_t kChannels = 2;
+        static constexpr std::size_t kHistorySize = kMaxTaps * 2; // ring + contiguous mirror
+
+        // (kPhases + 1) rows of kMaxTaps; the extra row lets phase interpolation read p + 1.
+        // Copies share it until one of them re-tabulates (forked instances).
+        std::shared_ptr<std::vector<float>> bank_;
+        std::array<std::array<float, kHistorySize>, kChannels> history_{};
+        std::array<float, kMaxTaps> blended_{}; // per-output scratch: interpolated coefficients
+
+        double input_hz_ = kDefaultInputHz;
+        double output_hz_ = kDefaultOutputHz;
+        double adjust_ = 1.0;
+        double step_ = 1.0; // input samples advanced per output sample
+        double frac_ = 0.0; // position of the next output between the last two inputs
+        std::size_t taps_ = kBaseTaps;
+        std::size_t write_ = 0; // next ring slot in history_
+
+        void build_bank() noexcept;
+        void push(const AudioFrame &frame) noexcept;
+        [[nodiscard]] auto emit(double frac) noexcept -> AudioFrame;
+    };
+
+} // namespace gba
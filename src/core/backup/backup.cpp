@@ -0,0 +1,458 @@
+// src/core/backup/backup.cpp
+#include "core/backup/backup.h"
+#include "core/state/state_io.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <utility>
+
+namespace gba {
+
+    namespace {
+        constexpr std::uint32_t kSramMask = 0x7FFFU;
+        constexpr std::uint32_t kFlashWindowMask = 0xFFFFU;
+        constexpr std::uint32_t kFlashSectorMask = ~(Backup::kFlashSectorBytes - 1U);
+
+        // Flash command bytes (written to 0x5555 after the AA/55 unlock)
+        constexpr std::uint8_t kFlashUnlockA = 0xAAU;
+        constexpr std::uint8_t kFlashUnlockB = 0x55U;
+        constexpr std::uint8_t kFlashEnterId = 0x90U;
+        constexpr std::uint8_t kFlashExitId = 0xF0U;
+        constexpr std::uint8_t kFlashErase = 0x80U;
+        constexpr std::uint8_t kFlashChipErase = 0x10U;
+        constexpr std::uint8_t kFlashSectorErase = 0x30U;
+        constexpr std::uint8_t kFlashProgram = 0xA0U;
+        constexpr std::uint8_t kFlashSelectBank = 0xB0U;
+
+        // EEPROM request codes (first two bits) and address widths
+        constexpr std::uint64_t kEepromRead = 0b11U;
+        constexpr std::uint64_t kEepromWrite = 0b10U;
+        constexpr std::size_t kEepromCodeBits = 2U;
+        constexpr std::size_t kEepromSmallAddressBits = 6U;
+        constexpr std::size_t kEepromLargeAddressBits = 14U;
+        constexpr std::size_t kEepromReadRequest = kEepromCodeBits + 1U; // plus the address
+        constexpr std::size_t kEepromWriteRequest = kEepromCodeBits + Backup::kEepromBlockBits + 1U;
+        constexpr std::uint32_t kEepromDummyBits = 4U;
+        constexpr std::size_t kEepromBlockBytes = 8U;
+        constexpr std::uint32_t kByteBits = 8U;
+
+        // Every EEPROM keeps room for the larger chip, so the size can settle later
+        constexpr auto storage_size(BackupType type) noexcept -> std::size_t {
+            const bool eeprom =
+                type == BackupType::EEPROM512 || type == BackupType::EEPROM8K || type == BackupType::EEPROM;
+            return eeprom ? backup_size(BackupType::EEPROM8K) : backup_size(type);
+        }
+
+        // BKUP payload before the contents: type, Flash and EEPROM state, contents size
+        constexpr std::size_t kStateFixedBytes =
+            sizeof(BackupType) + 1U + (4U * sizeof(bool)) + sizeof(std::uint32_t) +
+            Backup::kEepromMaxRequestBits + sizeof(std::size_t) + sizeof(std::uint64_t) + sizeof(std::uint32_t) +
+            sizeof(std::uint32_t);
+
+        auto contains(std::span<const std::uint8_t> rom, std::string_view needle) noexcept -> bool {
+            const std::boyer_moore_horspool_searcher searcher(needle.begin(), needle.end());
+            const auto *const first = reinterpret_cast<const char *>(rom.data()); // NOLINT(*-reinterpret-cast)
+            const auto *const last = first + rom.size();
+            return std::search(first, last, searcher) != last;
+        }
+    } // namespace
+
+    auto detect_backup_type(std::span<const std::uint8_t> rom) noexcept -> BackupType {
+        if (contains(rom, "EEPROM_V")) {
+            return BackupType::EEPROM;
+        }
+        if (contains(rom, "SRAM_V") || contains(rom, "SRAM_F_V")) {
+            return BackupType::SRAM;
+        }
+        if (contains(rom, "FLASH1M_V")) {
+            return BackupType::Flash128K;
+        }
+        if (contains(rom, "FLASH_V") || contains(rom, "FLASH512_V")) {
+            return BackupType::Flash64K;
+        }
+        return BackupType::None;
+    }
+
+    // ------------------------------ lifecycle -------------------------------------------
+
+    Backup::Backup(const Backup &other)
+        : type_(other.type_), memory_(other.contents().begin(), other.contents().end()),
+          flash_step_(other.flash_step_), flash_id_mode_(other.flash_id_mode_),
+          flash_erase_armed_(other.flash_erase_armed_), flash_program_next_(other.flash_program_next_),
+          flash_bank_next_(other.flash_bank_next_), flash_bank_(other.flash_bank_), eeprom_in_(other.eeprom_in_),
+          eeprom_in_bits_(other.eeprom_in_bits_), eeprom_out_(other.eeprom_out_),
+          eeprom_out_pos_(other.eeprom_out_pos_) {}
+
+    auto Backup::operator=(const Backup &other) -> Backup & {
+        restore(other);
+        return *this;
+    }
+
+    void Backup::restore(const Backup &snapshot) {
+        if (this == &snapshot) {
+            return;
+        }
+        const auto bytes = snapshot.contents();
+        memory_.assign(bytes.begin(), bytes.end()); // reuses the capacity; throws before anything changed
+        MappedFile::close_async(std::move(file_));
+        type_ = snapshot.type_;
+        flash_step_ = snapshot.flash_step_;
+        flash_id_mode_ = snapshot.flash_id_mode_;
+        flash_erase_armed_ = snapshot.flash_erase_armed_;
+        flash_program_next_ = snapshot.flash_program_next_;
+        flash_bank_next_ = snapshot.flash_bank_next_;
+        flash_bank_ = snapshot.flash_bank_;
+        eeprom_in_ = snapshot.eeprom_in_;
+        eeprom_in_bits_ = snapshot.eeprom_in_bits_;
+        eeprom_out_ = snapshot.eeprom_out_;
+        eeprom_out_pos_ = snapshot.eeprom_out_pos_;
+        dirty_ = true;
+    }
+
+    void Backup::set_type(BackupType type) {
+        MappedFile::close_async(std::move(file_));
+        type_ = type;
+        memory_.assign(storage_size(type), kErased);
+        dirty_ = true;
+        reset();
+    }
+
+    void Backup::erase() noexcept {
+        MappedFile::close_async(std::move(file_));
+        std::ranges::fill(memory_, kErased);
+        dirty_ = true;
+        reset();
+    }
+
+    auto Backup::attach_file(const std::filesystem::path &file, std::chrono::milliseconds idle) noexcept -> bool {
+        if (type_ == BackupType::None) {
+            return false;
+        }
+        auto mapped = MappedFile::open(file, storage_size(type_), kErased, idle);
+        if (!mapped) {
+            return false;
+        }
+        MappedFile::close_async(std::move(file_));
+        file_ = std::move(mapped);
+        dirty_ = true;
+        reset();
+        return true;
+    }
+
+    void Backup::request_flush() noexcept {
+        if (file_) {
+            file_->request_flush();
+        }
+    }
+
+    void Backup::reset() noexcept {
+        flash_step_ = FlashStep::Idle;
+        flash_id_mode_ = false;
+        flash_erase_armed_ = false;
+        flash_program_next_ = false;
+        flash_bank_next_ = false;
+        flash_bank_ = 0;
+        eeprom_in_bits_ = 0;
+        eeprom_out_ = 0;
+        eeprom_out_pos_ = kEepromReadBits;
+    }
+
+    // ------------------------------ storage -------------------------------------------
+
+    auto Backup::contents() const noexcept -> std::span<const std::uint8_t> {
+        if (file_) {
+            return file_->bytes();
+        }
+        return memory_;
+    }
+
+    auto Backup::storage() noexcept -> std::span<std::uint8_t> {
+        if (file_) {
+            return file_->bytes();
+        }
+        return memory_;
+    }
+
+    void Backup::store(std::size_t index, std::uint8_t value) noexcept {
+        storage()[index] = value;
+        note_write();
+    }
+
+    void Backup::fill_range(std::size_t begin, std::size_t count) noexcept {
+        std::ranges::fill(storage().subspan(begin, count), kErased);
+        note_write();
+    }
+
+    void Backup::note_write() noexcept {
+        dirty_ = true;
+        if (file_) {
+            file_->note_write();
+        }
+    }
+
+    // ------------------------------ save states -------------------------------------------
+
+    void Backup::save_state(StateWriter &out) const { write_state(out, true); }
+
+    void Backup::save_delta(StateWriter &out) const { write_state(out, dirty_); }
+
+    void Backup::write_state(StateWriter &out, bool contents) const {
+        out.write(type_);
+        out.write(flash_step_);
+        out.write(flash_id_mode_);
+        out.write(flash_erase_armed_);
+        out.write(flash_program_next_);
+        out.write(flash_bank_next_);
+        out.write(flash_bank_);
+        out.write(eeprom_in_);
+        out.write(eeprom_in_bits_);
+        out.write(eeprom_out_);
+        out.write(eeprom_out_pos_);
+        const auto bytes = contents ? this->contents() : std::span<const std::uint8_t>{};
+        out.write(static_cast<std::uint32_t>(bytes.size()));
+        out.write_bytes(bytes);
+    }
+
+    // Protocol state goes into a scratch Backup first: a mismatch leaves this chip untouched
+    auto Backup::read_fixed_state(StateReader &in, Backup &loaded, std::uint32_t &size) const noexcept -> bool {
+        if (!in.read(loaded.type_) || !in.read(loaded.flash_step_) || !in.read(loaded.flash_id_mode_) ||
+            !in.read(loaded.flash_erase_armed_) || !in.read(loaded.flash_program_next_) ||
+            !in.read(loaded.flash_bank_next_) || !in.read(loaded.flash_bank_) || !in.read(loaded.eeprom_in_) ||
+            !in.read(loaded.eeprom_in_bits_) || !in.read(loaded.eeprom_out_) || !in.read(loaded.eeprom_out_pos_) ||
+            !in.read(size)) {
+            return false;
+        }
+        const bool sameChip = loaded.type_ == type_ || (loaded.is_eeprom() && is_eeprom());
+        return sameChip && size == contents().size() && loaded.flash_step_ <= FlashStep::Unlock2 &&
+               loaded.flash_bank_ <= 1U && loaded.eeprom_in_bits_ <= kEepromMaxRequestBits &&
+               loaded.eeprom_out_pos_ <= kEepromReadBits && in.remaining() >= size;
+    }
+
+    auto Backup::accepts_state(std::span<const std::uint8_t> payload) const noexcept -> bool {
+        StateReader in(payload);
+        Backup loaded;
+        std::uint32_t size = 0;
+        return read_fixed_state(in, loaded, size) && in.remaining() == size;
+    }
+
+    auto Backup::load_state(StateReader &in) noexcept -> bool {
+        Backup loaded;
+        std::uint32_t size = 0;
+        if (!read_fixed_state(in, loaded, size)) {
+            return false;
+        }
+        (void)in.read_bytes(storage());
+        type_ = loaded.type_;
+        flash_step_ = loaded.flash_step_;
+        flash_id_mode_ = loaded.flash_id_mode_;
+        flash_erase_armed_ = loaded.flash_erase_armed_;
+        flash_program_next_ = loaded.flash_program_next_;
+        flash_bank_next_ = loaded.flash_bank_next_;
+        flash_bank_ = loaded.flash_bank_;
+        eeprom_in_ = loaded.eeprom_in_;
+        eeprom_in_bits_ = loaded.eeprom_in_bits_;
+        eeprom_out_ = loaded.eeprom_out_;
+        eeprom_out_pos_ = loaded.eeprom_out_pos_;
+        note_write();
+        return true;
+    }
+
+    auto Backup::delta_bytes(std::span<const std::uint8_t> state, std::span<const std::uint8_t> delta) noexcept
+        -> std::size_t {
+        if (delta.size() == state.size() && state.size() >= kStateFixedBytes) {
+            return delta.size();
+        }
+        std::uint32_t size = 0;
+        if (delta.size() != kStateFixedBytes || state.size() < kStateFixedBytes) {
+            return 0U;
+        }
+        std::memcpy(&size, delta.data() + kStateFixedBytes - sizeof(size), sizeof(size));
+        return (size == 0U) ? kStateFixedBytes - sizeof(size) : 0U; // keep the state's contents and their size
+    }
+
+    // ------------------------------ SRAM / Flash -------------------------------------------
+
+    auto Backup::read8(std::uint32_t offset) const noexcept -> std::uint8_t {
+        const auto bytes = contents();
+        if (type_ == BackupType::SRAM) {
+            return bytes[offset & kSramMask];
+        }
+        const std::uint32_t off = offset & kFlashWindowMask;
+        if (flash_id_mode_ && off < kFlash64KId.size()) {
+            return (type_ == BackupType::Flash128K) ? kFlash128KId[off] : kFlash64KId[off];
+        }
+        return bytes[(flash_bank_ * kFlashBankBytes) + off];
+    }
+
+    void Backup::write8(std::uint32_t offset, std::uint8_t value) noexcept {
+        if (type_ == BackupType::SRAM) {
+            store(offset & kSramMask, value);
+            return;
+        }
+        flash_command(offset & kFlashWindowMask, value);
+    }
+
+    void Backup::flash_command(std::uint32_t offset, std::uint8_t value) noexcept {
+        if (flash_program_next_) {
+            flash_program_next_ = false;
+            store((flash_bank_ * kFlashBankBytes) + offset, value);
+            return;
+        }
+        if (flash_bank_next_) {
+            flash_bank_next_ = false;
+            if (offset == 0U) {
+                flash_bank_ = value & 1U;
+            }
+            return;
+        }
+
+        switch (flash_step_) {
+        case FlashStep::Idle:
+            if (offset == kFlashCmd1 && value == kFlashUnlockA) {
+                flash_step_ = FlashStep::Unlock1;
+            } else if (value == kFlashExitId) {
+                flash_id_mode_ = false; // bare F0 resets on some chips
+            }
+            return;
+        case FlashStep::Unlock1:
+            flash_step_ = (offset == kFlashCmd2 && value == kFlashUnlockB) ? FlashStep::Unlock2 : FlashStep::Idle;
+            return;
+        case FlashStep::Unlock2:
+            flash_step_ = FlashStep::Idle;
+            break;
+        }
+
+        if (flash_erase_armed_) {
+            flash_erase_armed_ = false;
+            if (offset == kFlashCmd1 && value == kFlashChipErase) {
+                fill_range(0U, backup_size(type_));
+            } else if (value == kFlashSectorErase) {
+                fill_range((flash_bank_ * kFlashBankBytes) + (offset & kFlashSectorMask), kFlashSectorBytes);
+            }
+            return;
+        }
+        if (offset != kFlashCmd1) {
+            return;
+        }
+        switch (value) {
+        case kFlashEnterId:
+            flash_id_mode_ = true;
+            break;
+        case kFlashExitId:
+            flash_id_mode_ = false;
+            break;
+        case kFlashErase:
+            flash_erase_armed_ = true;
+            break;
+        case kFlashProgram:
+            flash_program_next_ = true;
+            break;
+        case kFlashSelectBank:
+            flash_bank_next_ = type_ == BackupType::Flash128K;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // ------------------------------ EEPROM -------------------------------------------
+
+    auto Backup::eeprom_address_bits() const noexcept -> std::size_t {
+        switch (type_) {
+        case BackupType::EEPROM512:
+            return kEepromSmallAddressBits;
+        case BackupType::EEPROM8K:
+            return kEepromLargeAddressBits;
+        default:
+            return 0U; // not settled yet
+        }
+    }
+
+    auto Backup::eeprom_field(std::size_t first, std::size_t count) const noexcept -> std::uint64_t {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            value = (value << 1U) | eeprom_in_[first + i];
+        }
+        return value;
+    }
+
+    auto Backup::read_eeprom() noexcept -> std::uint16_t {
+        if (type_ == BackupType::EEPROM && eeprom_in_bits_ != 0U) {
+            settle_eeprom_size(); // the game is done sending its first request
+        }
+        if (eeprom_out_pos_ >= kEepromReadBits) {
+            return 1U; // ready
+        }
+        const std::uint32_t pos = eeprom_out_pos_++;
+        if (pos < kEepromDummyBits) {
+            return 0U;
+        }
+        return static_cast<std::uint16_t>((eeprom_out_ >> (kEepromBlockBits - 1U - (pos - kEepromDummyBits))) & 1U);
+    }
+
+    void Backup::write_eeprom(std::uint16_t value) noexcept {
+        if (eeprom_in_bits_ < eeprom_in_.size()) {
+            eeprom_in_[eeprom_in_bits_++] = static_cast<std::uint8_t>(value & 1U);
+        }
+        if (eeprom_in_bits_ < kEepromCodeBits) {
+            return;
+        }
+        const std::uint64_t code = eeprom_field(0U, kEepromCodeBits);
+        if (code != kEepromRead && code != kEepromWrite) {
+            eeprom_in_bits_ = 0; // not a request: resynchronise
+            return;
+        }
+        if (type_ == BackupType::EEPROM) {
+            if (eeprom_in_bits_ == kEepromWriteRequest + kEepromLargeAddressBits) {
+                settle_eeprom_size(); // no 512-byte request is this long
+            }
+            return;
+        }
+        const std::size_t header = kEepromCodeBits + eeprom_address_bits();
+        if (code == kEepromRead && eeprom_in_bits_ == header + 1U) {
+            eeprom_request_done();
+        } else if (code == kEepromWrite && eeprom_in_bits_ == header + kEepromBlockBits + 1U) {
+            eeprom_request_done();
+        }
+    }
+
+    void Backup::settle_eeprom_size() noexcept {
+        const std::size_t base =
+            (eeprom_field(0U, kEepromCodeBits) == kEepromRead) ? kEepromReadRequest : kEepromWriteRequest;
+        if (eeprom_in_bits_ == base + kEepromSmallAddressBits) {
+            type_ = BackupType::EEPROM512;
+        } else if (eeprom_in_bits_ == base + kEepromLargeAddressBits) {
+            type_ = BackupType::EEPROM8K;
+        } else {
+            eeprom_in_bits_ = 0; // a malformed request says nothing about the chip
+            return;
+        }
+        eeprom_request_done();
+    }
+
+    void Backup::eeprom_request_done() noexcept {
+        const std::size_t addressBits = eeprom_address_bits();
+        const std::size_t blocks = backup_size(type_) / kEepromBlockBytes;
+        const std::size_t base = (eeprom_field(kEepromCodeBits, addressBits) & (blocks - 1U)) * kEepromBlockBytes;
+        const auto bytes = storage().subspan(base, kEepromBlockBytes);
+
+        if (eeprom_field(0U, kEepromCodeBits) == kEepromRead) {
+            eeprom_out_ = 0;
+            for (const std::uint8_t byte : bytes) {
+                eeprom_out_ = (eeprom_out_ << kByteBits) | byte;
+            }
+            eeprom_out_pos_ = 0;
+        } else {
+            const std::uint64_t data = eeprom_field(kEepromCodeBits + addressBits, kEepromBlockBits);
+            for (std::size_t i = 0; i < kEepromBlockBytes; ++i) {
+                bytes[i] = static_cast<std::uint8_t>(data >> (kEepromBlockBits - (kByteBits * (i + 1U))));
+            }
+            note_write();
+            eeprom_out_pos_ = kEepromReadBits;
+        }
+        eeprom_in_bits_ = 0;
+    }
+
+} // namespace gba
@@ -0,0 +1,187 @@
+// src/core/backup/backup.h
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+#include "core/backup/mapped_file.h"
+
+namespace gba {
+
+    class StateReader;
+    class StateWriter;
+
+    enum class BackupType : std::uint8_t {
+        None,
+        SRAM,      // 32 KiB battery RAM, 8-bit bus at 0x0E000000
+        Flash64K,  // 64 KiB flash (Panasonic ID), command protocol at 0x0E000000
+        Flash128K, // 128 KiB flash (Sanyo ID), two 64 KiB banks
+        EEPROM512, // 512 B serial EEPROM (6-bit block addresses) at 0x0D000000
+        EEPROM8K,  // 8 KiB serial EEPROM (14-bit block addresses)
+        EEPROM,    // serial EEPROM of either size, settled by the length of the first request
+    };
+
+    // Library ID strings the SDK links into every ROM ("SRAM_V", "FLASH1M_V", ...).
+    // EEPROM size is not in the string; EEPROM_V reports EEPROM (see Backup::read_eeprom).
+    [[nodiscard]] auto detect_backup_type(std::span<const std::uint8_t> rom) noexcept -> BackupType;
+
+    [[nodiscard]] constexpr auto backup_size(BackupType type) noexcept -> std::size_t {
+        switch (type) {
+        case BackupType::SRAM:
+            return 0x8000U;
+        case BackupType::Flash64K:
+            return 0x10000U;
+        case BackupType::Flash128K:
+            return 0x20000U;
+        case BackupType::EEPROM512:
+            return 0x200U;
+        case BackupType::EEPROM8K:
+        case BackupType::EEPROM: // room for the larger chip until the size is known
+            return 0x2000U;
+        case BackupType::None:
+            break;
+        }
+        return 0U;
+    }
+
+    /**
+     * Cartridge backup chip: SRAM, Flash or EEPROM, with its bus protocol.
+     *
+     * Contents live either in memory or in a save file mapped by attach_file();
+     * either way a game write is a plain store (plus a relaxed counter bump for the
+     * MappedFile flusher), so the emulation thread never waits on the disk.
+     *
+     * Bus view (the MMU routes these)
+     * - SRAM/Flash: 8-bit accesses at 0x0E000000, mirrored through 0x0FFFFFFF.
+     * - EEPROM: bit 0 of 16-bit accesses at 0x0D000000 (games drive it with DMA3).
+     *   Requests are "11"+address+"0" (read: the next 68 reads return 4 dummy bits and
+     *   64 data bits, MSB first) and "10"+address+64 bits+"0" (write: reads return 1,
+     *   ready, as the write completes instantly). The address width (6 or 14 bits)
+     *   follows the type. For BackupType::EEPROM it is read off the first request:
+     *   games send a whole request by DMA and then read, so the bits written before
+     *   that first read (9 or 17 for a read, 73 or 81 for a write) give the width,
+     *   and the type becomes EEPROM512 or EEPROM8K. The contents keep their 8 KiB
+     *   storage; a 512-byte chip uses the first 512 bytes.
+     *
+     * Copies (System::fork) get a private in-memory copy of the contents; only the
+     * instance that attached the file writes through to it.
+     */
+    class Backup {
+      public:
+        Backup() = default;
+        Backup(const Backup &other);
+        auto operator=(const Backup &other) -> Backup &;
+        Backup(Backup &&) noexcept = default;
+        auto operator=(Backup &&) noexcept -> Backup & = default;
+        ~Backup() = default;
+
+        // Become a copy of `snapshot` (type, protocol state, contents) in this instance's
+        // buffer: no allocation once it has held a chip that size. Any file is released.
+        void restore(const Backup &snapshot);
+
+        // Select the chip; contents start erased (0xFF) in memory, any file is released
+        // (its final sync runs on the flusher thread, see MappedFile::close_async).
+        void set_type(BackupType type);
+        // set_type(type()) without allocating: the in-memory buffer keeps its size while
+        // a file is attached
+        void erase() noexcept;
+        [[nodiscard]] auto type() const noexcept -> BackupType { return type_; }
+
+        // Map `file` as the contents (created/grown as needed, existing data kept).
+        // false leaves the in-memory contents in place.
+        [[nodiscard]] auto attach_file(const std::filesystem::path &file,
+                                       std::chrono::milliseconds idle = MappedFile::kDefaultIdle) noexcept -> bool;
+        [[nodiscard]] auto file() const noexcept -> const MappedFile * { return file_.get(); }
+        void request_flush() noexcept;
+
+        // Chip protocol state back to power-on; contents are kept
+        void reset() noexcept;
+
+        [[nodiscard]] auto contents() const noexcept -> std::span<const std::uint8_t>;
+
+        // SRAM/Flash window, offset within 0x0E000000 (mirroring applied here)
+        [[nodiscard]] auto read8(std::uint32_t offset) const noexcept -> std::uint8_t;
+        void write8(std::uint32_t offset, std::uint8_t value) noexcept;
+
+        // EEPROM serial port (bit 0). Reads advance the output stream and may settle the size.
+        [[nodiscard]] auto read_eeprom() noexcept -> std::uint16_t;
+        void write_eeprom(std::uint16_t value) noexcept;
+
+        // Save states (the BKUP section): type, Flash/EEPROM protocol state, contents.
+        // save_delta() leaves the contents out unless they changed since clear_dirty().
+        // load_state() checks the chip before changing anything (an EEPROM may differ in
+        // size only) and writes the contents through to an attached file.
+        void save_state(StateWriter &out) const;
+        void save_delta(StateWriter &out) const;
+        [[nodiscard]] auto load_state(StateReader &in) noexcept -> bool;
+        // load_state() would succeed on this BKUP payload (checked before loading a whole state)
+        [[nodiscard]] auto accepts_state(std::span<const std::uint8_t> payload) const noexcept -> bool;
+        void clear_dirty() noexcept { dirty_ = false; }
+        // Bytes of a BKUP delta payload to copy over the full payload `state`: all of
+        // it, or the protocol state alone when the delta has no contents. 0: mismatch.
+        [[nodiscard]] static auto delta_bytes(std::span<const std::uint8_t> state,
+                                              std::span<const std::uint8_t> delta) noexcept -> std::size_t;
+
+        [[nodiscard]] auto is_eeprom() const noexcept -> bool {
+            return type_ == BackupType::EEPROM512 || type_ == BackupType::EEPROM8K || type_ == BackupType::EEPROM;
+        }
+        [[nodiscard]] auto is_sram_or_flash() const noexcept -> bool {
+            return type_ == BackupType::SRAM || type_ == BackupType::Flash64K || type_ == BackupType::Flash128K;
+        }
+
+        // Flash command addresses and IDs
+        static constexpr std::uint32_t kFlashCmd1 = 0x5555U;
+        static constexpr std::uint32_t kFlashCmd2 = 0x2AAAU;
+        static constexpr std::uint32_t kFlashBankBytes = 0x10000U;
+        static constexpr std::uint32_t kFlashSectorBytes = 0x1000U;
+        static constexpr std::array<std::uint8_t, 2> kFlash64KId{0x32U, 0x1BU};  // Panasonic MN63F805MNP
+        static constexpr std::array<std::uint8_t, 2> kFlash128KId{0x62U, 0x13U}; // Sanyo LE26FV10N1TS
+        static constexpr std::uint8_t kErased = 0xFFU;
+
+        // EEPROM request framing
+        static constexpr std::size_t kEepromBlockBits = 64U;
+        static constexpr std::size_t kEepromMaxRequestBits = 2U + 14U + kEepromBlockBits + 1U;
+        static constexpr std::uint32_t kEepromReadBits = 4U + kEepromBlockBits;
+
+      private:
+        enum class FlashStep : std::uint8_t { Idle, Unlock1, Unlock2 };
+
+        BackupType type_ = BackupType::None;
+        std::vector<std::uint8_t> memory_; // contents when no file is attached (kept sized for erase())
+        std::unique_ptr<MappedFile> file_; // contents when attached
+
+        // Flash command state
+        FlashStep flash_step_ = FlashStep::Idle;
+        bool flash_id_mode_ = false;
+        bool flash_erase_armed_ = false;
+        bool flash_program_next_ = false;
+        bool flash_bank_next_ = false;
+        std::uint32_t flash_bank_ = 0;
+
+        // EEPROM serial state
+        std::array<std::uint8_t, kEepromMaxRequestBits> eeprom_in_{};
+        std::size_t eeprom_in_bits_ = 0;
+        std::uint64_t eeprom_out_ = 0;
+        std::uint32_t eeprom_out_pos_ = kEepromReadBits; // == kEepromReadBits: idle (reads 1)
+
+        bool dirty_ = true; // contents written since clear_dirty()
+
+        [[nodiscard]] auto storage() noexcept -> std::span<std::uint8_t>;
+        void store(std::size_t index, std::uint8_t value) noexcept;
+        void fill_range(std::size_t begin, std::size_t count) noexcept;
+        void note_write() noexcept;
+        void write_state(StateWriter &out, bool contents) const;
+        [[nodiscard]] auto read_fixed_state(StateReader &in, Backup &loaded, std::uint32_t &size) const noexcept
+            -> bool;
+        void flash_command(std::uint32_t offset, std::uint8_t value) noexcept;
+        [[nodiscard]] auto eeprom_address_bits() const noexcept -> std::size_t;
+        [[nodiscard]] auto eeprom_field(std::size_t first, std::size_t count) const noexcept -> std::uint64_t;
+        void eeprom_request_done() noexcept;
+        void settle_eeprom_size() noexcept;
+    };
+
+} // namespace gba
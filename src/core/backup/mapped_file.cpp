@@ -0,0 +1,201 @@
+// src/core/backup/mapped_file.cpp
+#include "core/backup/mapped_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gba {
+
+    namespace {
+        // A game saving every frame never goes idle; sync anyway after this many busy intervals
+        constexpr int kMaxBusyRounds = 8;
+    } // namespace
+
+    auto MappedFile::open(const std::filesystem::path &file, std::size_t bytes, std::uint8_t fill,
+                          std::chrono::milliseconds idle) noexcept -> std::unique_ptr<MappedFile> {
+        if (bytes == 0U) {
+            return nullptr;
+        }
+        std::unique_ptr<MappedFile> mapped(new (std::nothrow) MappedFile()); // private constructor
+        if (!mapped) {
+            return nullptr;
+        }
+        std::size_t existing = 0;
+
+#if defined(_WIN32)
+        HANDLE handle = ::CreateFileW(file.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                      OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+        mapped->file_handle_ = handle;
+        LARGE_INTEGER size{};
+        if (::GetFileSizeEx(handle, &size) == 0) {
+            mapped->unmap();
+            return nullptr;
+        }
+        existing = static_cast<std::size_t>(size.QuadPart);
+        // Mapping past the end grows the file (zero filled)
+        const auto mappingSize = static_cast<std::uint64_t>(std::max(existing, bytes));
+        HANDLE mapping = ::CreateFileMappingW(handle, nullptr, PAGE_READWRITE, static_cast<DWORD>(mappingSize >> 32U),
+                                              static_cast<DWORD>(mappingSize & 0xFFFFFFFFU), nullptr);
+        if (mapping == nullptr) {
+            mapped->unmap();
+            return nullptr;
+        }
+        mapped->mapping_handle_ = mapping;
+        void *view = ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, bytes);
+        if (view == nullptr) {
+            mapped->unmap();
+            return nullptr;
+        }
+        mapped->data_ = static_cast<std::uint8_t *>(view);
+#else
+        const int fd = ::open(file.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644); // NOLINT(*-vararg)
+        if (fd < 0) {
+            return nullptr;
+        }
+        mapped->fd_ = fd;
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            mapped->unmap();
+            return nullptr;
+        }
+        existing = static_cast<std::size_t>(info.st_size);
+        if (existing < bytes && ::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            mapped->unmap();
+            return nullptr;
+        }
+        void *view = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (view == MAP_FAILED) {
+            mapped->unmap();
+            return nullptr;
+        }
+        mapped->data_ = static_cast<std::uint8_t *>(view);
+#endif
+
+        mapped->size_ = bytes;
+        mapped->idle_ = idle;
+        if (existing < bytes) {
+            std::memset(mapped->data_ + existing, fill, bytes - existing); // erased chip state
+        }
+        mapped->flusher_ = std::thread([raw = mapped.get()] { raw->flusher_loop(); });
+        return mapped;
+    }
+
+    MappedFile::~MappedFile() {
+        if (flusher_.joinable()) {
+            {
+                const std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_one();
+            flusher_.join(); // the flusher syncs once more on its way out
+        }
+        unmap();
+    }
+
+    void MappedFile::close_async(std::unique_ptr<MappedFile> file) noexcept {
+        if (!file || !file->flusher_.joinable()) {
+            return; // nothing running to hand over to: the destructor closes it here
+        }
+        MappedFile *raw = file.release();
+        raw->flusher_.detach(); // before stop_: from then on the flusher may delete raw
+        const std::lock_guard lock(raw->mutex_);
+        raw->self_delete_ = true;
+        raw->stop_ = true;
+        raw->wake_.notify_one(); // under the lock: the flusher cannot run on until it is released
+    }
+
+    void MappedFile::request_flush() noexcept {
+        {
+            const std::lock_guard lock(mutex_);
+            flush_requested_ = true;
+        }
+        wake_.notify_one();
+    }
+
+    void MappedFile::flusher_loop() {
+        std::uint64_t synced = 0; // writes_ starts at 0 and the file is in sync at open
+        std::uint64_t seen = 0;
+        int busyRounds = 0;
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            wake_.wait_for(lock, idle_, [this] { return stop_ || flush_requested_; });
+            const bool stopping = stop_;
+            const bool requested = flush_requested_;
+            flush_requested_ = false;
+
+            const std::uint64_t now = writes_.load(std::memory_order_relaxed);
+            const bool idle = now == seen;
+            busyRounds = idle ? 0 : busyRounds + 1;
+            if (now != synced && (stopping || requested || idle || busyRounds >= kMaxBusyRounds)) {
+                lock.unlock();
+                if (sync()) {
+                    synced = now;
+                    flushes_.fetch_add(1U, std::memory_order_release);
+                }
+                busyRounds = 0;
+                lock.lock();
+            }
+            seen = now;
+            if (stopping) {
+                if (self_delete_) {
+                    lock.unlock();
+                    delete this; // NOLINT(*-owning-memory): handed over by close_async()
+                }
+                return;
+            }
+        }
+    }
+
+    auto MappedFile::sync() noexcept -> bool {
+#if defined(_WIN32)
+        return ::FlushViewOfFile(data_, size_) != 0 && ::FlushFileBuffers(static_cast<HANDLE>(file_handle_)) != 0;
+#else
+        return ::msync(data_, size_, MS_SYNC) == 0;
+#endif
+    }
+
+    void MappedFile::unmap() noexcept {
+#if defined(_WIN32)
+        if (data_ != nullptr) {
+            ::UnmapViewOfFile(data_);
+        }
+        if (mapping_handle_ != nullptr) {
+            ::CloseHandle(static_cast<HANDLE>(mapping_handle_));
+        }
+        if (file_handle_ != nullptr) {
+            ::CloseHandle(static_cast<HANDLE>(file_handle_));
+        }
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+#else
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+    }
+
+} // namespace gba
@@ -0,0 +1,93 @@
+// src/core/backup/mapped_file.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace gba {
+
+    /**
+     * A fixed-size file mapped read/write into memory, flushed in the background.
+     *
+     * Writers store straight into bytes() (the OS page cache) and call note_write();
+     * nothing on that path touches the disk. A flusher thread syncs the mapping to
+     * disk once no write has been noted for one idle interval, when asked via
+     * request_flush(), and a last time when the object is destroyed.
+     *
+     * Notes
+     * - open() creates the file if needed and grows it to `bytes`, filling the new
+     *   tail with `fill`; existing contents are kept (a longer file is not truncated).
+     * - Destruction waits for the final sync: do it at shutdown/unload, not per frame.
+     *   close_async() leaves the final sync and the unmap to the flusher thread instead.
+     * - bytes() may be written by one thread while the flusher syncs; a sync racing a
+     *   write just leaves that write for the next round.
+     */
+    class MappedFile {
+      public:
+        using Clock = std::chrono::steady_clock;
+        static constexpr std::chrono::milliseconds kDefaultIdle{500};
+
+        // nullptr if the file cannot be created, resized or mapped
+        [[nodiscard]] static auto open(const std::filesystem::path &file, std::size_t bytes, std::uint8_t fill,
+                                       std::chrono::milliseconds idle = kDefaultIdle) noexcept
+            -> std::unique_ptr<MappedFile>;
+
+        MappedFile(const MappedFile &) = delete;
+        auto operator=(const MappedFile &) -> MappedFile & = delete;
+        MappedFile(MappedFile &&) = delete;
+        auto operator=(MappedFile &&) -> MappedFile & = delete;
+        ~MappedFile();
+
+        [[nodiscard]] auto bytes() noexcept -> std::span<std::uint8_t> { return {data_, size_}; }
+        [[nodiscard]] auto bytes() const noexcept -> std::span<const std::uint8_t> { return {data_, size_}; }
+
+        // Emulation thread: one relaxed increment, no locks, no syscalls
+        void note_write() noexcept { writes_.fetch_add(1U, std::memory_order_relaxed); }
+
+        // Ask the flusher to sync pending writes now (e.g. on pause); does not wait
+        void request_flush() noexcept;
+
+        // Release without waiting: the flusher syncs, unmaps and deletes the object on its way out
+        static void close_async(std::unique_ptr<MappedFile> file) noexcept;
+
+        // Completed syncs that had pending writes (tests, stats)
+        [[nodiscard]] auto flush_count() const noexcept -> std::uint64_t {
+            return flushes_.load(std::memory_order_acquire);
+        }
+
+      private:
+        MappedFile() = default;
+
+        std::uint8_t *data_ = nullptr;
+        std::size_t size_ = 0;
+#if defined(_WIN32)
+        void *file_handle_ = nullptr;
+        void *mapping_handle_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+        std::chrono::milliseconds idle_ = kDefaultIdle;
+
+        std::atomic<std::uint64_t> writes_{0};
+        std::atomic<std::uint64_t> flushes_{0};
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        bool flush_requested_ = false;
+        bool stop_ = false;
+        bool self_delete_ = false; // close_async(): the flusher owns the object
+        std::thread flusher_;
+
+        void flusher_loop();
+        auto sync() noexcept -> bool;
+        void unmap() noexcept;
+    };
+
+} // namespace gba
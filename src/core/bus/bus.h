@@ -9,6 +9,7 @@ namespace gba {
       public:
         // lifecycle
         void reset() noexcept { mmu_.reset(); }
+        void soft_reset() noexcept { mmu_.soft_reset(); }
 
         // BIOS plumbing exposed for tests & future UI
         [[nodiscard]] auto load_bios(const std::filesystem::path &file) noexcept -> bool {
@@ -18,11 +19,42 @@ namespace gba {
             return mmu_.load_gamepak(file);
         }
         void load_gamepak(std::span<const u8> bytes) noexcept { mmu_.load_gamepak(bytes); }
+        void set_bios(std::shared_ptr<const RomImage> image) noexcept { mmu_.set_bios(std::move(image)); }
+        void set_gamepak(std::shared_ptr<const RomImage> image) noexcept { mmu_.set_gamepak(std::move(image)); }
+        [[nodiscard]] auto bios_image() const noexcept -> const std::shared_ptr<const RomImage> & {
+            return mmu_.bios_image();
+        }
+        [[nodiscard]] auto gamepak_image() const noexcept -> const std::shared_ptr<const RomImage> & {
+            return mmu_.gamepak_image();
+        }
 
         // I/O debug hook passthroughs
         void debug_set_vcount_for_tests(std::uint16_t scanline) noexcept { mmu_.debug_set_vcount_for_tests(scanline); }
         void debug_set_hblank_for_tests(bool inHBlank) noexcept { mmu_.debug_set_hblank_for_tests(inHBlank); }
 
+        // Devices
+        [[nodiscard]] auto io() noexcept -> IORegs & { return mmu_.io(); }
+        [[nodiscard]] auto io() const noexcept -> const IORegs & { return mmu_.io(); }
+        [[nodiscard]] auto apu() noexcept -> APU & { return mmu_.apu(); }
+        [[nodiscard]] auto apu() const noexcept -> const APU & { return mmu_.apu(); }
+        [[nodiscard]] auto backup() noexcept -> Backup & { return mmu_.backup(); }
+        [[nodiscard]] auto backup() const noexcept -> const Backup & { return mmu_.backup(); }
+        [[nodiscard]] auto ewram() const noexcept -> const PagedMemory & { return mmu_.ewram(); }
+        [[nodiscard]] auto iwram() const noexcept -> const PagedMemory & { return mmu_.iwram(); }
+        [[nodiscard]] auto vram() const noexcept -> const PagedMemory & { return mmu_.vram(); }
+        [[nodiscard]] auto pal() const noexcept -> const PagedMemory & { return mmu_.pal(); }
+        [[nodiscard]] auto oam() const noexcept -> const PagedMemory & { return mmu_.oam(); }
+
+        // Save states (memory, I/O, APU)
+        void save_state(StateWriter &out) const { mmu_.save_state(out); }
+        [[nodiscard]] auto load_state(StateReader &in) noexcept -> bool { return mmu_.load_state(in); }
+        void save_delta(StateWriter &out) const { mmu_.save_delta(out); }
+        void clear_dirty() noexcept { mmu_.clear_dirty(); }
+
+        auto restore(const Bus &snapshot) -> std::size_t { return mmu_.restore(snapshot.mmu_); }
+
+        void add_footprint(MemoryFootprint &footprint) const noexcept { mmu_.add_footprint(footprint); }
+
         // Byte access
         [[nodiscard]] auto read8(u32 addr) const noexcept -> u8 { return mmu_.read8(addr); }
         void write8(u32 addr, u8 value) noexcept { mmu_.write8(addr, value); }
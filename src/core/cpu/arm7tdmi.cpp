@@ -1,6 +1,7 @@
 // src/core/cpu/arm7tdmi.cpp
 #include "core/cpu/arm7tdmi.h"
 #include "core/bus/bus.h"
+#include "core/state/state_io.h"
 
 namespace gba {
 
@@ -11,6 +12,13 @@ namespace gba {
         cpsr_ = kFlagT; // start in Thumb state
     }
 
+    void ARM7TDMI::save_state(StateWriter &out) const {
+        out.write(regs_);
+        out.write(cpsr_);
+    }
+
+    auto ARM7TDMI::load_state(StateReader &in) noexcept -> bool { return in.read(regs_) && in.read(cpsr_); }
+
     // -------------------------- flag helpers --------------------------
 
     void ARM7TDMI::set_nz(u32 result) noexcept {
@@ -1,11 +1,14 @@
 // src/core/cpu/arm7tdmi.h
 #pragma once
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace gba {
 
     class Bus; // fwd
+    class StateReader;
+    class StateWriter;
 
     class ARM7TDMI {
       public:
@@ -54,6 +57,13 @@ namespace gba {
         }
         [[nodiscard]] auto debug_cpsr() const noexcept -> u32 { return cpsr_; }
 
+        // -------- Save states (register file + CPSR) --------
+        void save_state(StateWriter &out) const;
+        [[nodiscard]] auto load_state(StateReader &in) noexcept -> bool;
+        [[nodiscard]] static constexpr auto state_bytes() noexcept -> std::size_t {
+            return sizeof(regs_) + sizeof(cpsr_);
+        }
+
       private:
         std::array<u32, kNumRegs> regs_{}; // r0..r15 (r15==PC)
         u32 cpsr_ = kFlagT;
@@ -1,3 +1,19 @@
 // src/core/io/io.cpp
 #include "core/io/io.h"
-// (All methods are header-defined for now; we keep the TU for future expansion.)
+#include "core/state/state_io.h"
+// (Register access is header-defined; out-of-line pieces live here.)
+
+namespace gba {
+
+    void IORegs::save_state(StateWriter &out) const {
+        out.write(raw_);
+        out.write(vcount_);
+        out.write(hblank_);
+        out.write(dispstat_shadow_);
+    }
+
+    auto IORegs::load_state(StateReader &in) noexcept -> bool {
+        return in.read(raw_) && in.read(vcount_) && in.read(hblank_) && in.read(dispstat_shadow_);
+    }
+
+} // namespace gba
@@ -1,11 +1,16 @@
 // src/core/io/io.h
 #pragma once
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm> // std::ranges::fill lives here
+#include <utility>
 
 namespace gba {
 
+    class StateReader;
+    class StateWriter;
+
     /**
      * I/O register block (0x04000000 – 0x040003FE).
      *
@@ -13,6 +18,7 @@ namespace gba {
      *   - DISPCNT  (0x0000, 16-bit, read/write)
      *   - DISPSTAT (0x0004, 16-bit, read/write placeholder)
      *   - VCOUNT   (0x0006, 16-bit, READ-ONLY; written value is ignored)
+     *   - KEYINPUT (0x0130, 16-bit, READ-ONLY; active-low, driven by the frontend)
      *
      * Notes
      * - The real hardware has many more regs. We’ll add them incrementally.
@@ -32,6 +38,7 @@ namespace gba {
         static constexpr u32 kOffDISPCNT = 0x0000U;  // 16-bit
         static constexpr u32 kOffDISPSTAT = 0x0004U; // 16-bit
         static constexpr u32 kOffVCOUNT = 0x0006U;   // 16-bit (read-only)
+        static constexpr u32 kOffKEYINPUT = 0x0130U; // 16-bit (read-only)
 
         // Bit/byte helpers
         static constexpr u32 kBitsPerByte = 8U;
@@ -52,9 +59,24 @@ namespace gba {
         static constexpr u16 kDispstatLycShift = 8U;
         static constexpr u16 kDispstatLycMask = static_cast<u16>(0xFFU << kDispstatLycShift);
 
+        // KEYINPUT bits (0 = pressed on hardware; the API below takes 1 = pressed)
+        static constexpr u16 kKeyA = static_cast<u16>(1U << 0);
+        static constexpr u16 kKeyB = static_cast<u16>(1U << 1);
+        static constexpr u16 kKeySelect = static_cast<u16>(1U << 2);
+        static constexpr u16 kKeyStart = static_cast<u16>(1U << 3);
+        static constexpr u16 kKeyRight = static_cast<u16>(1U << 4);
+        static constexpr u16 kKeyLeft = static_cast<u16>(1U << 5);
+        static constexpr u16 kKeyUp = static_cast<u16>(1U << 6);
+        static constexpr u16 kKeyDown = static_cast<u16>(1U << 7);
+        static constexpr u16 kKeyR = static_cast<u16>(1U << 8);
+        static constexpr u16 kKeyL = static_cast<u16>(1U << 9);
+        static constexpr u16 kKeyMask = 0x03FFU;
+
         void reset() noexcept {
             std::ranges::fill(raw_, u8{0x00});
             vcount_ = 0; // PPU will drive this later; 0..227 lines on GBA
+            set_keys_pressed(0U);
+            keyinput_read_ = false;
         }
 
         // ---- 8/16/32-bit API (offset is relative to 0x04000000) ----
@@ -73,12 +95,16 @@ namespace gba {
                 const bool high = (offset == kOffDISPSTAT + 1U);
                 return static_cast<u8>((high ? (disp >> kBitsPerByte) : disp) & kByteMask);
             }
+            if (offset == kOffKEYINPUT || offset == kOffKEYINPUT + 1U) {
+                keyinput_read_ = true;
+            }
             return raw_.at(static_cast<std::size_t>(offset));
         }
 
         void write8(u32 offset, u8 value) noexcept {
             // VCOUNT is read-only
-            if (offset == kOffVCOUNT || offset == kOffVCOUNT + 1U) {
+            if (offset == kOffVCOUNT || offset == kOffVCOUNT + 1U || offset == kOffKEYINPUT ||
+                offset == kOffKEYINPUT + 1U) {
                 // read-only: ignore
                 return;
             }
@@ -138,15 +164,41 @@ namespace gba {
             write8(offset + 3U, static_cast<u8>((value >> kBits3Bytes) & kByteMask));
         }
 
-        // Hook the PPU/scheduler will use later
-        void debug_set_vcount_for_tests(u16 scanline) noexcept { vcount_ = scanline; }
-        void debug_set_hblank_for_tests(bool hblank) noexcept { hblank_ = hblank; }
+        // System-driven video timing (scheduler)
+        void set_vcount(u16 scanline) noexcept { vcount_ = scanline; }
+        void set_hblank(bool hblank) noexcept { hblank_ = hblank; }
+        [[nodiscard]] auto vcount() const noexcept -> u16 { return vcount_; }
+
+        // Frontend-driven input; lives in raw_ so save states carry it
+        void set_keys_pressed(u16 pressed) noexcept {
+            const auto keyinput = static_cast<u16>(~pressed & kKeyMask);
+            raw_[kOffKEYINPUT] = static_cast<u8>(keyinput & kByteMask);
+            raw_[kOffKEYINPUT + 1U] = static_cast<u8>(keyinput >> kBitsPerByte);
+        }
+        [[nodiscard]] auto keys_pressed() const noexcept -> u16 {
+            const auto keyinput = static_cast<u16>(raw_[kOffKEYINPUT] | (raw_[kOffKEYINPUT + 1U] << kBitsPerByte));
+            return static_cast<u16>(~keyinput & kKeyMask);
+        }
+        // Latency probes: true if the guest read KEYINPUT since the last call. Not emulated state.
+        [[nodiscard]] auto take_keyinput_read() noexcept -> bool { return std::exchange(keyinput_read_, false); }
+
+        // Test hooks (same effect as the scheduler setters)
+        void debug_set_vcount_for_tests(u16 scanline) noexcept { set_vcount(scanline); }
+        void debug_set_hblank_for_tests(bool hblank) noexcept { set_hblank(hblank); }
+
+        // Save states: raw register bytes plus the system-driven and shadow fields
+        void save_state(StateWriter &out) const;
+        [[nodiscard]] auto load_state(StateReader &in) noexcept -> bool;
+        [[nodiscard]] static constexpr auto state_bytes() noexcept -> std::size_t {
+            return sizeof(raw_) + sizeof(vcount_) + sizeof(hblank_) + sizeof(dispstat_shadow_);
+        }
 
       private:
         std::array<u8, kSizeBytes> raw_{};
         u16 vcount_ = 0;          // system-driven (PPU)
         bool hblank_ = false;     // system-driven (PPU)
         u16 dispstat_shadow_ = 0; // writable bits of DISPSTAT (IRQ enables + LYC)
+        mutable bool keyinput_read_ = false; // see take_keyinput_read()
 
         // Compose DISPSTAT value on read: flags are live, others are the shadow
         [[nodiscard]] auto composed_dispstat() const noexcept -> u16 {
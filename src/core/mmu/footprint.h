@@ -0,0 +1,27 @@
+// src/core/mmu/footprint.h
+#pragma once
+#include <cstddef>
+#include <memory>
+
+namespace gba {
+
+    /**
+     * Host memory one instance uses, split by ownership. Shared bytes are referenced
+     * by at least one other owner (another instance, a fork) and counted in each of
+     * them; private bytes belong to this instance alone.
+     */
+    struct MemoryFootprint {
+        std::size_t private_bytes = 0;
+        std::size_t shared_bytes = 0;
+
+        [[nodiscard]] auto total() const noexcept -> std::size_t { return private_bytes + shared_bytes; }
+
+        void add(std::size_t bytes, bool shared) noexcept { (shared ? shared_bytes : private_bytes) += bytes; }
+        template <typename T> void add(const std::shared_ptr<T> &owned, std::size_t bytes) noexcept {
+            if (owned) {
+                add(bytes, owned.use_count() > 1);
+            }
+        }
+    };
+
+} // namespace gba
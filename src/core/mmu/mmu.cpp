@@ -1,5 +1,6 @@
 // src/core/mmu/mmu.cpp
 #include "core/mmu/mmu.h"
+#include "core/state/state_io.h"
 
 #include <algorithm>
 #include <filesystem>
@@ -15,121 +16,288 @@ namespace gba {
         constexpr u32 kHalfBits = 16U;
         constexpr u32 kThreeBytes = 24U;
         constexpr u32 kByteMask = 0xFFU;
+        constexpr u32 kRepeatByte16 = 0x0101U;     // 8-bit bus seen through a 16-bit read
+        constexpr u32 kRepeatByte32 = 0x01010101U; // ... and through a 32-bit read
     } // namespace
 
     void MMU::reset() noexcept {
-        bios_loaded_ = false;
-        std::ranges::fill(bios_, u8{0x00});
-        std::ranges::fill(ewram_, u8{0x00});
-        std::ranges::fill(iwram_, u8{0x00});
+        bios_.reset();
+        gamepak_.reset();
+        backup_.set_type(BackupType::None); // releases any save file without waiting for its sync
+        soft_reset();
+    }
+
+    void MMU::soft_reset() noexcept {
+        ewram_.fill(u8{0x00});
+        iwram_.fill(u8{0x00});
         io_.reset();
-        std::ranges::fill(pal_, u8{0x00});
-        std::ranges::fill(vram_, u8{0x00});
-        std::ranges::fill(oam_, u8{0x00});
-        gamepak_.clear();
+        apu_.reset();
+        pal_.fill(u8{0x00});
+        vram_.fill(u8{0x00});
+        oam_.fill(u8{0x00});
+        backup_.erase(); // erased, as after load_gamepak(); detaches any save file without waiting for its sync
     }
 
-    // ------------------------------ LOADERS -------------------------------------------
+    auto MMU::restore(const MMU &snapshot) -> std::size_t {
+        const std::size_t pages = ewram_.restore(snapshot.ewram_) + iwram_.restore(snapshot.iwram_) +
+                                  pal_.restore(snapshot.pal_) + vram_.restore(snapshot.vram_) +
+                                  oam_.restore(snapshot.oam_);
+        bios_ = snapshot.bios_;
+        gamepak_ = snapshot.gamepak_;
+        io_ = snapshot.io_;
+        apu_ = snapshot.apu_;       // vectors keep their capacity
+        backup_.restore(snapshot.backup_); // into the existing buffer; any save file is released
+        return pages;
+    }
 
-    // Read BIOS (<=16 KiB). If file is shorter, remaining bytes become 0x00.
-    auto MMU::load_bios(const std::filesystem::path &file) noexcept -> bool {
-        std::ifstream ifs(file, std::ios::binary);
-        if (!ifs) {
+    // ------------------------------ SAVE STATES -------------------------------------------
+
+    namespace {
+        // Page by page, so the payload is the plain concatenation of each region
+        void write_region(StateWriter &out, const PagedMemory &region) {
+            for (std::size_t i = 0; i < region.page_count(); ++i) {
+                out.write_bytes(region.page(i));
+            }
+        }
+        auto read_region(StateReader &in, PagedMemory &region) noexcept -> bool {
+            for (std::size_t i = 0; i < region.page_count(); ++i) {
+                if (!in.read_bytes(region.mutable_page(i))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    void MMU::save_state(StateWriter &out) const {
+        const auto memory = out.begin_section(kStateTagMemory);
+        write_region(out, ewram_);
+        write_region(out, iwram_);
+        write_region(out, pal_);
+        write_region(out, vram_);
+        write_region(out, oam_);
+        out.end_section(memory);
+
+        const auto io = out.begin_section(kStateTagIO);
+        io_.save_state(out);
+        out.end_section(io);
+
+        const auto apu = out.begin_section(kStateTagAPU);
+        apu_.save_state(out);
+        out.end_section(apu);
+
+        const auto backup = out.begin_section(kStateTagBackup);
+        backup_.save_state(out);
+        out.end_section(backup);
+    }
+
+    auto MMU::load_state(StateReader &in) noexcept -> bool {
+        if (!in.enter_section(kStateTagMemory) || !read_region(in, ewram_) || !read_region(in, iwram_) ||
+            !read_region(in, pal_) || !read_region(in, vram_) || !read_region(in, oam_) || !in.leave_section()) {
+            return false;
+        }
+        if (!in.enter_section(kStateTagIO) || !io_.load_state(in) || !in.leave_section()) {
+            return false;
+        }
+        if (!in.enter_section(kStateTagAPU) || !apu_.load_state(in) || !in.leave_section()) {
             return false;
         }
+        return in.enter_section(kStateTagBackup) && backup_.load_state(in) && in.leave_section();
+    }
+
+    void MMU::save_delta(StateWriter &out) const {
+        const auto pages = out.begin_section(kStateTagPages);
+        for (const PagedMemory *region : state_regions()) {
+            const std::uint64_t mask = region->dirty_mask();
+            out.write(mask);
+            for (std::size_t i = 0; i < region->page_count(); ++i) {
+                if (((mask >> i) & 1U) != 0U) {
+                    out.write_bytes(region->page(i));
+                }
+            }
+        }
+        out.end_section(pages);
+
+        const auto io = out.begin_section(kStateTagIO);
+        io_.save_state(out);
+        out.end_section(io);
 
-        std::array<char, BIOS_SIZE> tmp{};
-        ifs.read(tmp.data(), static_cast<std::streamsize>(tmp.size()));
-        const auto got = static_cast<std::size_t>(ifs.gcount());
+        const auto apu = out.begin_section(kStateTagAPU);
+        apu_.save_state(out);
+        out.end_section(apu);
 
-        // Copy (char->u8)
-        std::transform(tmp.begin(), tmp.begin() + static_cast<std::ptrdiff_t>(got), bios_.begin(),
-                       [](char srcChar) -> u8 { return static_cast<u8>(srcChar); });
+        const auto backup = out.begin_section(kStateTagBackup);
+        backup_.save_delta(out);
+        out.end_section(backup);
+    }
+
+    void MMU::clear_dirty() noexcept {
+        ewram_.clear_dirty();
+        iwram_.clear_dirty();
+        pal_.clear_dirty();
+        vram_.clear_dirty();
+        oam_.clear_dirty();
+        backup_.clear_dirty();
+    }
 
-        // Zero the tail if the BIOS file was short
-        if (got < BIOS_SIZE) {
-            auto tail = std::ranges::subrange(bios_.begin() + static_cast<std::ptrdiff_t>(got), bios_.end());
-            std::ranges::fill(tail, u8{0x00});
+    auto MMU::apply_dirty_pages(std::span<u8> memory, std::span<const u8> pages) noexcept -> bool {
+        // Pass 0 validates every mask and length, pass 1 copies: a bad delta changes nothing
+        for (int pass = 0; pass < 2; ++pass) {
+            StateReader in(pages);
+            std::size_t regionBase = 0;
+            for (const std::size_t regionSize : kStateRegionSizes) {
+                const std::size_t pageCount = (regionSize + PagedMemory::kPageMask) >> PagedMemory::kPageShift;
+                std::uint64_t mask = 0;
+                if (!in.read(mask) || (pageCount < PagedMemory::kMaxPages && (mask >> pageCount) != 0U)) {
+                    return false;
+                }
+                for (std::size_t i = 0; i < pageCount; ++i) {
+                    if (((mask >> i) & 1U) == 0U) {
+                        continue;
+                    }
+                    const std::size_t offset = i << PagedMemory::kPageShift;
+                    const std::size_t bytes = std::min(PagedMemory::kPageBytes, regionSize - offset);
+                    if (regionBase + offset + bytes > memory.size()) {
+                        return false;
+                    }
+                    const auto target = memory.subspan(regionBase + offset, bytes);
+                    if (pass == 0) {
+                        if (in.remaining() < bytes) {
+                            return false;
+                        }
+                        in.skip(bytes);
+                    } else if (!in.read_bytes(target)) {
+                        return false;
+                    }
+                }
+                regionBase += regionSize;
+            }
+            if (in.remaining() != 0U || regionBase != memory.size()) {
+                return false;
+            }
         }
+        return true;
+    }
+
+    // ------------------------------ LOADERS -------------------------------------------
 
-        bios_loaded_ = true;
+    // Read BIOS (<=16 KiB). If file is shorter, the missing tail reads as 0x00.
+    auto MMU::load_bios(const std::filesystem::path &file) noexcept -> bool {
+        auto image = RomImage::load(file, BIOS_SIZE);
+        if (!image) {
+            return false;
+        }
+        set_bios(std::move(image));
         return true;
     }
 
     auto MMU::load_gamepak(const std::filesystem::path &file) noexcept -> bool {
-        std::ifstream ifs(file, std::ios::binary);
-        if (!ifs) {
+        auto image = RomImage::load(file);
+        if (!image) {
             return false;
         }
-        gamepak_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
-        // Cast char bytes to u8 in place
-        for (auto &chr : gamepak_) {
-            chr = static_cast<u8>(chr);
-        }
-        return !gamepak_.empty();
+        const bool loaded = !image->empty();
+        set_gamepak(std::move(image));
+        return loaded;
+    }
+
+    void MMU::load_gamepak(std::span<const u8> bytes) noexcept { set_gamepak(RomImage::copy_of(bytes)); }
+
+    void MMU::set_gamepak(std::shared_ptr<const RomImage> image) noexcept {
+        backup_.set_type(image ? detect_backup_type(image->bytes()) : BackupType::None);
+        gamepak_ = std::move(image);
     }
 
-    void MMU::load_gamepak(std::span<const u8> bytes) noexcept { gamepak_.assign(bytes.begin(), bytes.end()); }
+    void MMU::add_footprint(MemoryFootprint &footprint) const noexcept {
+        for (const PagedMemory *region : state_regions()) {
+            for (std::size_t i = 0; i < region->page_count(); ++i) {
+                footprint.add(region->page_bytes(i), region->page_shared(i));
+            }
+        }
+        footprint.add(bios_, bios_ ? bios_->size() : 0U);
+        footprint.add(gamepak_, gamepak_ ? gamepak_->size() : 0U);
+        footprint.add(backup_.contents().size(), false);
+        apu_.add_footprint(footprint);
+    }
 
     // ------------------------------ ADDRESS HELPERS -------------------------------------------
 
     auto MMU::gamepak_index(u32 addr) const noexcept -> std::size_t {
-        if (gamepak_.empty()) {
+        if (!gamepak_ || gamepak_->empty()) {
             return 0; // caller will return open bus if empty
         }
         const u32 regionBase = ws_base_of(addr);
         const u32 regionOffest = addr - regionBase; // 0..(32 MiB - 1)
 
         // mirror by rom size inside the 32 MiB window
-        const std::size_t romSize = gamepak_.size();
+        const std::size_t romSize = gamepak_->size();
         const std::size_t index = static_cast<std::size_t>(regionOffest) % romSize;
         return index;
     }
 
+    auto MMU::eeprom_at(u32 addr) const noexcept -> bool {
+        if (!backup_.is_eeprom() || !in_window(addr, EEPROM_BASE, SRAM_BASE - EEPROM_BASE)) {
+            return false;
+        }
+        const bool largeRom = gamepak_ && gamepak_->size() > kEepromSmallRomLimit;
+        return !largeRom || addr >= EEPROM_LARGE_ROM_BASE;
+    }
+
     // ------------------------------ READS/WRITES -------------------------------------------
 
     auto MMU::read8(u32 addr) const noexcept -> u8 {
         // BIOS (open-bus if not loaded)
         if (in(addr, BIOS_BASE, BIOS_SIZE)) {
             const auto idx = static_cast<std::size_t>(addr - BIOS_BASE);
-            return bios_loaded_ ? bios_.at(idx) : kOpenBus;
+            if (!bios_) {
+                return kOpenBus;
+            }
+            return idx < bios_->size() ? (*bios_)[idx] : u8{0x00};
         }
 
         // Work RAM
         if (in(addr, EWRAM_BASE, EWRAM_SIZE)) {
-            return ewram_.at(static_cast<std::size_t>(addr - EWRAM_BASE));
+            return ewram_.read8(static_cast<std::size_t>(addr - EWRAM_BASE));
         }
         if (in(addr, IWRAM_BASE, IWRAM_SIZE)) {
-            return iwram_.at(static_cast<std::size_t>(addr - IWRAM_BASE));
+            return iwram_.read8(static_cast<std::size_t>(addr - IWRAM_BASE));
         }
 
-        // I/O (stub)
+        // I/O (stub; sound block is owned by the APU)
         if (in(addr, IO_BASE, IO_SIZE)) {
             const u32 off = addr - IO_BASE;
+            if (APU::owns(off)) {
+                return apu_.read8(off);
+            }
             return io_.read8(off);
         }
 
         // Palette (mirrored every 0x400 within 16 MiB)
         if (in_window(addr, PAL_BASE, kWindow16MiB)) {
-            return pal_.at(pal_offset(addr));
+            return pal_.read8(pal_offset(addr));
         }
 
         // VRAM: 96 KiB valid + 32 KiB alias to first 32 KiB in 128 KiB window
         if (in_window(addr, VRAM_BASE, kVRAMWindow128KiB)) {
-            return vram_.at(vram_offset(addr));
+            return vram_.read8(vram_offset(addr));
         }
 
         // OAM (mirrored every 0x400 within 16 MiB)
         if (in_window(addr, OAM_BASE, kWindow16MiB)) {
-            return oam_.at(oam_offset(addr));
+            return oam_.read8(oam_offset(addr));
         }
 
         // gamepak ROM (three 32 MiB windows)
         if (in_any_ws(addr)) {
-            if (gamepak_.empty()) {
+            if (!gamepak_ || gamepak_->empty()) {
                 return kOpenBus;
             }
-            return gamepak_[gamepak_index(addr)];
+            return (*gamepak_)[gamepak_index(addr)];
+        }
+
+        // SRAM/Flash (8-bit bus, mirrored)
+        if (sram_at(addr)) {
+            return backup_.read8(addr - SRAM_BASE);
         }
 
         return kOpenBus; // unmapped for now
@@ -139,39 +307,53 @@ namespace gba {
         // BIOS is read-only: ignore writes
 
         if (in(addr, EWRAM_BASE, EWRAM_SIZE)) {
-            ewram_.at(static_cast<std::size_t>(addr - EWRAM_BASE)) = value;
+            ewram_.write8(static_cast<std::size_t>(addr - EWRAM_BASE), value);
             return;
         }
         if (in(addr, IWRAM_BASE, IWRAM_SIZE)) {
-            iwram_.at(static_cast<std::size_t>(addr - IWRAM_BASE)) = value;
+            iwram_.write8(static_cast<std::size_t>(addr - IWRAM_BASE), value);
             return;
         }
         if (in(addr, IO_BASE, IO_SIZE)) {
             const u32 off = addr - IO_BASE;
+            if (APU::owns(off)) {
+                apu_.write8(off, value);
+                return;
+            }
             io_.write8(off, value);
             return;
         }
         if (in_window(addr, PAL_BASE, kWindow16MiB)) {
-            pal_.at(pal_offset(addr)) = value; // hardware prefers 16/32-bit; 8-bit ok for tests
+            pal_.write8(pal_offset(addr), value); // hardware prefers 16/32-bit; 8-bit ok for tests
             return;
         }
         if (in_window(addr, VRAM_BASE, kVRAMWindow128KiB)) {
-            vram_.at(vram_offset(addr)) = value; // hardware prefers 16/32-bit; 8-bit ok for tests
+            vram_.write8(vram_offset(addr), value); // hardware prefers 16/32-bit; 8-bit ok for tests
             return;
         }
         if (in_window(addr, OAM_BASE, kWindow16MiB)) {
-            oam_.at(oam_offset(addr)) = value; // hardware prefers 16/32-bit; 8-bit ok for tests
+            oam_.write8(oam_offset(addr), value); // hardware prefers 16/32-bit; 8-bit ok for tests
             return;
         }
         if (in_any_ws(addr)) {
             // ROM is read-only ignore writes
             return;
         }
+        if (sram_at(addr)) {
+            backup_.write8(addr - SRAM_BASE, value);
+            return;
+        }
         // ignore the rest for now
     }
 
     // ---- 16-bit access (little-endian; unaligned allowed) ----
     auto MMU::read16(u32 addr) const noexcept -> std::uint16_t {
+        if (eeprom_at(addr)) {
+            return backup_.read_eeprom();
+        }
+        if (sram_at(addr)) {
+            return static_cast<std::uint16_t>(read8(addr) * kRepeatByte16);
+        }
         const u8 low = read8(addr);
         const u8 high = read8(addr + 1);
         return static_cast<std::uint16_t>(static_cast<std::uint16_t>(low) |
@@ -179,12 +361,23 @@ namespace gba {
     }
 
     void MMU::write16(u32 addr, std::uint16_t value) noexcept {
+        if (eeprom_at(addr)) {
+            backup_.write_eeprom(value);
+            return;
+        }
+        if (sram_at(addr)) {
+            write8(addr, static_cast<u8>((value >> (kByteBits * (addr & 1U))) & kByteMask)); // one byte lane
+            return;
+        }
         write8(addr, static_cast<u8>(value & kByteMask));
         write8(addr + 1, static_cast<u8>((value >> kByteBits) & kByteMask));
     }
 
     // ---- 32-bit access (little-endian; unaligned allowed) ----
     auto MMU::read32(u32 addr) const noexcept -> std::uint32_t {
+        if (sram_at(addr)) {
+            return read8(addr) * kRepeatByte32;
+        }
         const u8 byte0 = read8(addr + 0);
         const u8 byte1 = read8(addr + 1);
         const u8 byte2 = read8(addr + 2);
@@ -195,6 +388,10 @@ namespace gba {
     }
 
     void MMU::write32(u32 addr, std::uint32_t value) noexcept {
+        if (sram_at(addr)) {
+            write8(addr, static_cast<u8>((value >> (kByteBits * (addr & 3U))) & kByteMask));
+            return;
+        }
         write8(addr + 0, static_cast<u8>(value & kByteMask));
         write8(addr + 1, static_cast<u8>((value >> kByteBits) & kByteMask));
         write8(addr + 2, static_cast<u8>((value >> kHalfBits) & kByteMask));
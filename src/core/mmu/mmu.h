@@ -3,12 +3,22 @@
 #include <array>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <span>
+#include <utility>
 #include <vector>
+#include "core/apu/apu.h"
+#include "core/backup/backup.h"
 #include "core/io/io.h"
+#include "core/mmu/footprint.h"
+#include "core/mmu/paged_memory.h"
+#include "core/mmu/rom_image.h"
 
 namespace gba {
 
+    class StateReader;
+    class StateWriter;
+
     using u8 = std::uint8_t;
     using u32 = std::uint32_t;
 
@@ -42,6 +52,14 @@ namespace gba {
         static constexpr u32 WS2_BASE = 0x0C000000U;
         static constexpr u32 WS_REGION_SIZE_32MiB = 0x02000000U; // 32 MiB per region
 
+        // Cartridge backup: EEPROM in the top of WS2 (last 256 bytes only for ROMs over
+        // 16 MiB), SRAM/Flash in the 8-bit window after the ROM windows
+        static constexpr u32 EEPROM_BASE = 0x0D000000U;
+        static constexpr u32 EEPROM_LARGE_ROM_BASE = 0x0DFFFF00U;
+        static constexpr std::size_t kEepromSmallRomLimit = 0x01000000U; // 16 MiB
+        static constexpr u32 SRAM_BASE = 0x0E000000U;
+        static constexpr u32 SRAM_WINDOW = 0x02000000U; // 0x0E000000–0x0FFFFFFF
+
         // --- Window constants used for aliasing behaviour (names beat hex) ---
         static constexpr u32 kWindow16MiB = 0x01000000U;                     // palette/OAM mirror window
         static constexpr u32 kVRAMWindow128KiB = 0x00020000U;                // 128 KiB window 0x06000000–0x0601FFFF
@@ -51,6 +69,7 @@ namespace gba {
 
         // lifecycle & ROM
         void reset() noexcept;
+        void soft_reset() noexcept; // as reset(), but the BIOS and GamePak images stay loaded
 
         auto load_bios(const std::filesystem::path &file) noexcept -> bool;
 
@@ -58,6 +77,21 @@ namespace gba {
         auto load_gamepak(const std::filesystem::path &file) noexcept -> bool;
         void load_gamepak(std::span<const u8> bytes) noexcept;
 
+        // Map images shared with other instances (null unloads). set_gamepak() detects the backup type.
+        void set_bios(std::shared_ptr<const RomImage> image) noexcept { bios_ = std::move(image); }
+        void set_gamepak(std::shared_ptr<const RomImage> image) noexcept;
+        [[nodiscard]] auto bios_image() const noexcept -> const std::shared_ptr<const RomImage> & { return bios_; }
+        [[nodiscard]] auto gamepak_image() const noexcept -> const std::shared_ptr<const RomImage> & {
+            return gamepak_;
+        }
+
+        // Become a copy of `snapshot` (as the MMU copy constructor would make): RAM pages that
+        // differ are re-shared from it, devices and images copied. Returns the pages re-shared.
+        auto restore(const MMU &snapshot) -> std::size_t;
+
+        // Host memory behind this MMU: RAM pages, images, backup contents and device buffers
+        void add_footprint(MemoryFootprint &footprint) const noexcept;
+
         // byte access (we’ll add timings and alignment rules later per width)
         [[nodiscard]] auto read8(u32 addr) const noexcept -> u8;
         void write8(u32 addr, u8 value) noexcept;
@@ -73,6 +107,43 @@ namespace gba {
         void debug_set_vcount_for_tests(std::uint16_t scanline) noexcept { io_.debug_set_vcount_for_tests(scanline); }
         void debug_set_hblank_for_tests(bool hblank) noexcept { io_.debug_set_hblank_for_tests(hblank); }
 
+        // Devices behind the I/O window
+        [[nodiscard]] auto io() noexcept -> IORegs & { return io_; }
+        [[nodiscard]] auto io() const noexcept -> const IORegs & { return io_; }
+        [[nodiscard]] auto apu() noexcept -> APU & { return apu_; }
+        [[nodiscard]] auto apu() const noexcept -> const APU & { return apu_; }
+        [[nodiscard]] auto backup() noexcept -> Backup & { return backup_; }
+        [[nodiscard]] auto backup() const noexcept -> const Backup & { return backup_; }
+
+        // Guest RAM regions (no mirroring, no access side effects)
+        [[nodiscard]] auto ewram() const noexcept -> const PagedMemory & { return ewram_; }
+        [[nodiscard]] auto iwram() const noexcept -> const PagedMemory & { return iwram_; }
+
+        // Video memory as the PPU sees it
+        [[nodiscard]] auto vram() const noexcept -> const PagedMemory & { return vram_; }
+        [[nodiscard]] auto pal() const noexcept -> const PagedMemory & { return pal_; }
+        [[nodiscard]] auto oam() const noexcept -> const PagedMemory & { return oam_; }
+
+        // Save states: writable memory arrays (one raw copy each), I/O, APU and BKUP
+        // (backup contents and chip protocol state) sections. BIOS and GamePak images
+        // are content, not state, and are left untouched.
+        void save_state(StateWriter &out) const;
+        [[nodiscard]] auto load_state(StateReader &in) noexcept -> bool;
+
+        // Incremental save states: PAGE (pages dirtied since clear_dirty()), I/O, APU and
+        // BKUP (contents only if written since clear_dirty()).
+        void save_delta(StateWriter &out) const;
+        void clear_dirty() noexcept;
+        // Patch a full state's MEM payload with a PAGE payload; validates it all before writing.
+        [[nodiscard]] static auto apply_dirty_pages(std::span<u8> memory, std::span<const u8> pages) noexcept
+            -> bool;
+
+        // RAM regions in save-state order (EWRAM, IWRAM, PAL, VRAM, OAM)
+        static constexpr std::array<std::size_t, 5> kStateRegionSizes{EWRAM_SIZE, IWRAM_SIZE, PAL_SIZE, VRAM_SIZE,
+                                                                      OAM_SIZE};
+        static constexpr std::size_t kStateMemoryBytes = EWRAM_SIZE + IWRAM_SIZE + PAL_SIZE + VRAM_SIZE + OAM_SIZE;
+        static_assert(EWRAM_SIZE <= PagedMemory::kMaxBytes, "dirty masks are one word per region");
+
       private:
         // helpers
         [[nodiscard]] static constexpr auto in(u32 addr, u32 base, std::size_t size) noexcept -> bool {
@@ -116,20 +187,29 @@ namespace gba {
 
         // GamePak helpers
         [[nodiscard]] auto gamepak_index(u32 addr) const noexcept -> std::size_t;
+        [[nodiscard]] auto eeprom_at(u32 addr) const noexcept -> bool;
+        [[nodiscard]] auto sram_at(u32 addr) const noexcept -> bool {
+            return in_window(addr, SRAM_BASE, SRAM_WINDOW) && backup_.is_sram_or_flash();
+        }
 
-        // backing stores (simple arrays for now)
-        std::array<u8, BIOS_SIZE> bios_{};
-        std::array<u8, EWRAM_SIZE> ewram_{};
-        std::array<u8, IWRAM_SIZE> iwram_{};
-        IORegs io_{};
-        std::array<u8, PAL_SIZE> pal_{};
-        std::array<u8, VRAM_SIZE> vram_{};
-        std::array<u8, OAM_SIZE> oam_{};
-
-        // GamePak ROM (dynamic size mirrors by size inside each 32 MiB window)
-        std::vector<u8> gamepak_;
+        [[nodiscard]] auto state_regions() const noexcept -> std::array<const PagedMemory *, 5> {
+            return {&ewram_, &iwram_, &pal_, &vram_, &oam_};
+        }
 
-        bool bios_loaded_ = false;
+        // backing stores; guest RAM is paged so copies share it copy-on-write
+        std::shared_ptr<const RomImage> bios_; // up to BIOS_SIZE; reads past a short image return 0
+        PagedMemory ewram_{EWRAM_SIZE};
+        PagedMemory iwram_{IWRAM_SIZE};
+        IORegs io_{};
+        APU apu_{}; // sound block 0x060..0x0A7 of the I/O window
+        PagedMemory pal_{PAL_SIZE};
+        PagedMemory vram_{VRAM_SIZE};
+        PagedMemory oam_{OAM_SIZE};
+
+        // GamePak ROM (dynamic size mirrors by size inside each 32 MiB window).
+        // Immutable once loaded, so copies of the MMU share one image.
+        std::shared_ptr<const RomImage> gamepak_;
+        mutable Backup backup_; // type detected from the GamePak image; EEPROM reads drive its serial protocol
     };
 
 } // namespace gba
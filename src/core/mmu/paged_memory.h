@@ -0,0 +1,128 @@
+// src/core/mmu/paged_memory.h
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace gba {
+
+    /**
+     * Guest RAM split into 4 KiB pages, shared copy-on-write between copies.
+     *
+     * Copying a PagedMemory copies its page table only (one refcount bump per
+     * page); the first write to a shared page gives the writer its own copy.
+     * This is what makes System::fork() cheap: children share everything until
+     * they diverge, and then only per touched page.
+     *
+     * Every write also marks its page dirty (one bit per page, cleared by
+     * clear_dirty()); incremental save states record only those pages.
+     *
+     * Notes
+     * - Regions smaller than a page (PAL/OAM, 1 KiB) are a single short page.
+     * - At most kMaxPages pages (256 KiB, EWRAM's size) so the dirty set is one word.
+     * - An instance must be used by one thread at a time, but instances that share
+     *   pages may run on different threads: shared pages are never written, and a
+     *   page is written in place only once this instance holds the sole reference.
+     */
+    class PagedMemory {
+      public:
+        using u8 = std::uint8_t;
+
+        static constexpr std::size_t kPageShift = 12U;
+        static constexpr std::size_t kPageBytes = std::size_t{1} << kPageShift; // 4 KiB
+        static constexpr std::size_t kPageMask = kPageBytes - 1U;
+        static constexpr std::size_t kMaxPages = 64U;
+        static constexpr std::size_t kMaxBytes = kMaxPages * kPageBytes;
+
+        explicit PagedMemory(std::size_t bytes) : size_(bytes), pages_((bytes + kPageMask) >> kPageShift) {
+            for (auto &page : pages_) {
+                page = std::make_shared<Page>();
+            }
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+        [[nodiscard]] auto page_count() const noexcept -> std::size_t { return pages_.size(); }
+        [[nodiscard]] auto page_bytes(std::size_t index) const noexcept -> std::size_t {
+            return std::min(kPageBytes, size_ - (index << kPageShift));
+        }
+
+        [[nodiscard]] auto read8(std::size_t offset) const noexcept -> u8 {
+            return pages_[offset >> kPageShift]->bytes[offset & kPageMask];
+        }
+        void write8(std::size_t offset, u8 value) noexcept {
+            writable(offset >> kPageShift)[offset & kPageMask] = value;
+        }
+
+        // Whole-page views (save states, bulk fills). mutable_page() unshares.
+        [[nodiscard]] auto page(std::size_t index) const noexcept -> std::span<const u8> {
+            return {pages_[index]->bytes.data(), page_bytes(index)};
+        }
+        [[nodiscard]] auto mutable_page(std::size_t index) noexcept -> std::span<u8> {
+            return {writable(index).data(), page_bytes(index)};
+        }
+
+        void fill(u8 value) noexcept {
+            for (std::size_t i = 0; i < pages_.size(); ++i) {
+                std::ranges::fill(mutable_page(i), value);
+            }
+        }
+
+        // Share `source`'s page wherever this copy holds a different one (it wrote there since
+        // both were last equal): contents become source's with no bytes copied. Same-size
+        // regions only; the pages taken are marked dirty. Returns how many were taken.
+        auto restore(const PagedMemory &source) noexcept -> std::size_t {
+            std::size_t restored = 0;
+            for (std::size_t i = 0; i < pages_.size(); ++i) {
+                if (pages_[i] != source.pages_[i]) {
+                    pages_[i] = source.pages_[i];
+                    dirty_ |= std::uint64_t{1} << i;
+                    ++restored;
+                }
+            }
+            return restored;
+        }
+
+        // Pages written (or unshared for writing) since the last clear_dirty(); bit i = page i
+        [[nodiscard]] auto dirty_mask() const noexcept -> std::uint64_t { return dirty_; }
+        void clear_dirty() noexcept { dirty_ = 0; }
+
+        // Sharing introspection (tests, fork benchmarks)
+        [[nodiscard]] auto shares_page_with(const PagedMemory &other, std::size_t index) const noexcept -> bool {
+            return pages_[index] == other.pages_[index];
+        }
+        [[nodiscard]] auto page_shared(std::size_t index) const noexcept -> bool {
+            return pages_[index].use_count() > 1;
+        }
+        [[nodiscard]] auto shared_page_count() const noexcept -> std::size_t {
+            return static_cast<std::size_t>(
+                std::ranges::count_if(pages_, [](const auto &page) { return page.use_count() > 1; }));
+        }
+
+      private:
+        struct Page {
+            std::array<u8, kPageBytes> bytes{};
+        };
+
+        std::size_t size_;
+        std::vector<std::shared_ptr<Page>> pages_;
+        std::uint64_t dirty_ = 0;
+
+        auto writable(std::size_t index) noexcept -> std::array<u8, kPageBytes> & {
+            dirty_ |= std::uint64_t{1} << index;
+            auto &page = pages_[index];
+            if (page.use_count() != 1) {
+                page = std::make_shared<Page>(*page); // copy-on-write
+            } else {
+                // Sole owner now; order our writes after a sibling's last reads before it let go
+                std::atomic_thread_fence(std::memory_order_acquire);
+            }
+            return page->bytes;
+        }
+    };
+
+} // namespace gba
@@ -0,0 +1,55 @@
+// src/core/mmu/rom_image.cpp
+#include "core/mmu/rom_image.h"
+
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+namespace gba {
+
+    auto RomImage::load(const std::filesystem::path &file, std::size_t maxBytes) -> std::shared_ptr<const RomImage> {
+        std::ifstream ifs(file, std::ios::binary | std::ios::ate);
+        if (!ifs) {
+            return nullptr;
+        }
+        const auto end = ifs.tellg();
+        const std::size_t size = end > 0 ? std::min(static_cast<std::size_t>(end), maxBytes) : 0U;
+        std::vector<u8> bytes(size);
+        ifs.seekg(0);
+        ifs.read(reinterpret_cast<char *>(bytes.data()), // NOLINT(*-reinterpret-cast)
+                 static_cast<std::streamsize>(bytes.size()));
+        bytes.resize(static_cast<std::size_t>(std::max<std::streamsize>(ifs.gcount(), 0)));
+        return std::make_shared<const RomImage>(std::move(bytes));
+    }
+
+    auto RomImage::copy_of(std::span<const u8> bytes) -> std::shared_ptr<const RomImage> {
+        return std::make_shared<const RomImage>(std::vector<u8>(bytes.begin(), bytes.end()));
+    }
+
+    auto RomCache::load(const std::filesystem::path &file, std::size_t maxBytes) -> std::shared_ptr<const RomImage> {
+        std::error_code error;
+        const auto canonical = std::filesystem::weakly_canonical(file, error);
+        const auto modified = std::filesystem::last_write_time(file, error);
+        const auto size = std::filesystem::file_size(file, error);
+        if (error) {
+            return RomImage::load(file, maxBytes); // not a plain file: no identity to cache by
+        }
+
+        const std::scoped_lock lock(mutex_);
+        Entry &entry = entries_[{canonical.string(), maxBytes}];
+        if (auto image = entry.image.lock(); image && entry.modified == modified && entry.size == size) {
+            return image;
+        }
+        auto image = RomImage::load(file, maxBytes);
+        entry = Entry{image, modified, size};
+        std::erase_if(entries_, [](const auto &item) { return item.second.image.expired(); });
+        return image;
+    }
+
+    auto RomCache::live() const -> std::size_t {
+        const std::scoped_lock lock(mutex_);
+        return static_cast<std::size_t>(
+            std::ranges::count_if(entries_, [](const auto &item) { return !item.second.image.expired(); }));
+    }
+
+} // namespace gba
@@ -0,0 +1,73 @@
+// src/core/mmu/rom_image.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gba {
+
+    /**
+     * Immutable BIOS or GamePak image, shared by reference count.
+     *
+     * MMUs hold a std::shared_ptr<const RomImage>; any number of instances (forks,
+     * batch workers, parallel agents) can map the same image, on any threads,
+     * because nothing ever writes to it after construction. The image is freed with
+     * its last user.
+     */
+    class RomImage {
+      public:
+        using u8 = std::uint8_t;
+
+        static constexpr std::size_t kNoLimit = static_cast<std::size_t>(-1);
+
+        // Reads at most `maxBytes` of `file`; nullptr if it cannot be opened. An empty file gives an empty image.
+        [[nodiscard]] static auto load(const std::filesystem::path &file, std::size_t maxBytes = kNoLimit)
+            -> std::shared_ptr<const RomImage>;
+        [[nodiscard]] static auto copy_of(std::span<const u8> bytes) -> std::shared_ptr<const RomImage>;
+
+        [[nodiscard]] auto bytes() const noexcept -> std::span<const u8> { return bytes_; }
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return bytes_.size(); }
+        [[nodiscard]] auto empty() const noexcept -> bool { return bytes_.empty(); }
+        [[nodiscard]] auto operator[](std::size_t index) const noexcept -> u8 { return bytes_[index]; }
+
+        explicit RomImage(std::vector<u8> bytes) noexcept : bytes_(std::move(bytes)) {}
+
+      private:
+        std::vector<u8> bytes_;
+    };
+
+    /**
+     * Loads each file once and hands out the same image while anyone still uses it.
+     *
+     * Entries are weak: the cache never keeps an image alive by itself, so dropping
+     * every instance that maps a ROM frees it. A file rewritten on disk (new size or
+     * modification time) is loaded afresh. Thread-safe; owners (batch runners, agent
+     * pools, frontends) keep one per process or per pool, there is no global cache.
+     */
+    class RomCache {
+      public:
+        [[nodiscard]] auto load(const std::filesystem::path &file, std::size_t maxBytes = RomImage::kNoLimit)
+            -> std::shared_ptr<const RomImage>;
+
+        // Images currently alive (held by at least one user)
+        [[nodiscard]] auto live() const -> std::size_t;
+
+      private:
+        struct Entry {
+            std::weak_ptr<const RomImage> image;
+            std::filesystem::file_time_type modified{};
+            std::uintmax_t size = 0;
+        };
+
+        mutable std::mutex mutex_;
+        std::map<std::pair<std::string, std::size_t>, Entry> entries_; // (canonical path, byte limit)
+    };
+
+} // namespace gba
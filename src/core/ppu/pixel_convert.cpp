@@ -0,0 +1,121 @@
+// src/core/ppu/pixel_convert.cpp
+#include "core/ppu/pixel_convert.h"
+
+namespace gba {
+
+    namespace {
+        constexpr std::uint32_t kByteMask = 0xFFU;
+        constexpr std::uint32_t kRedShift = 16U;
+        constexpr std::uint32_t kGreenShift = 8U;
+        // BT.601 chroma in 1/256ths: the +128 offset and rounding, added first so the sums stay unsigned
+        constexpr std::uint32_t kChromaBias = (128U << 8U) + 128U;
+
+        // Mean 8-bit channels of a 2x2 block
+        struct Rgb {
+            std::uint32_t r;
+            std::uint32_t g;
+            std::uint32_t b;
+        };
+
+        auto block_mean(std::uint16_t a, std::uint16_t b, std::uint16_t c, std::uint16_t d) noexcept -> Rgb {
+            Rgb sum{0U, 0U, 0U};
+            for (const std::uint16_t pixel : {a, b, c, d}) {
+                const std::uint32_t rgb = bgr555_to_xrgb8888(pixel);
+                sum.r += (rgb >> kRedShift) & kByteMask;
+                sum.g += (rgb >> kGreenShift) & kByteMask;
+                sum.b += rgb & kByteMask;
+            }
+            return {(sum.r + 2U) >> 2U, (sum.g + 2U) >> 2U, (sum.b + 2U) >> 2U};
+        }
+
+        auto chroma_u(const Rgb &c) noexcept -> std::uint8_t {
+            return static_cast<std::uint8_t>(((112U * c.b) + kChromaBias - (38U * c.r) - (74U * c.g)) >> 8U);
+        }
+
+        auto chroma_v(const Rgb &c) noexcept -> std::uint8_t {
+            return static_cast<std::uint8_t>(((112U * c.r) + kChromaBias - (94U * c.g) - (18U * c.b)) >> 8U);
+        }
+    } // namespace
+
+    void convert_xrgb8888(std::span<const std::uint16_t> source, std::size_t width, std::size_t height, void *dest,
+                          std::size_t pitch) noexcept {
+        auto *row = static_cast<std::uint8_t *>(dest);
+        for (std::size_t y = 0; y < height; ++y) {
+            convert_line(PixelFormat::XRGB8888, source.subspan(y * width, width), row);
+            row += pitch; // NOLINT(*-pointer-arithmetic)
+        }
+    }
+
+    void convert_line(PixelFormat format, std::span<const std::uint16_t> line, std::uint8_t *dest) noexcept {
+        const std::size_t width = line.size();
+        switch (format) {
+        case PixelFormat::BGR555:
+            for (std::size_t x = 0; x < width; ++x) {
+                dest[x * 2U] = static_cast<std::uint8_t>(line[x] & kByteMask);  // NOLINT(*-pointer-arithmetic)
+                dest[(x * 2U) + 1U] = static_cast<std::uint8_t>(line[x] >> 8U); // NOLINT(*-pointer-arithmetic)
+            }
+            break;
+        case PixelFormat::XRGB8888: {
+            // Locked texture rows and the PPU's output buffer are at least 4-byte aligned
+            auto *out = reinterpret_cast<std::uint32_t *>(dest); // NOLINT(*-reinterpret-cast)
+            for (std::size_t x = 0; x < width; ++x) {
+                out[x] = bgr555_to_xrgb8888(line[x]); // NOLINT(*-pointer-arithmetic)
+            }
+            break;
+        }
+        case PixelFormat::RGB24:
+            for (std::size_t x = 0; x < width; ++x) {
+                const std::uint32_t rgb = bgr555_to_xrgb8888(line[x]);
+                dest[x * 3U] = static_cast<std::uint8_t>(rgb >> kRedShift);                         // NOLINT
+                dest[(x * 3U) + 1U] = static_cast<std::uint8_t>((rgb >> kGreenShift) & kByteMask); // NOLINT
+                dest[(x * 3U) + 2U] = static_cast<std::uint8_t>(rgb & kByteMask);                  // NOLINT
+            }
+            break;
+        case PixelFormat::YUV420: // planar: see convert_line_luma/convert_line_chroma
+            break;
+        }
+    }
+
+    void convert_line_luma(std::span<const std::uint16_t> line, std::uint8_t *y) noexcept {
+        for (std::size_t x = 0; x < line.size(); ++x) {
+            y[x] = bgr555_to_y(line[x]); // NOLINT(*-pointer-arithmetic)
+        }
+    }
+
+    void convert_line_chroma(std::span<const std::uint16_t> upper, std::span<const std::uint16_t> lower,
+                             std::uint8_t *u, std::uint8_t *v) noexcept {
+        for (std::size_t x = 0; x < upper.size() / 2U; ++x) {
+            const Rgb mean = block_mean(upper[x * 2U], upper[(x * 2U) + 1U], lower[x * 2U], lower[(x * 2U) + 1U]);
+            u[x] = chroma_u(mean); // NOLINT(*-pointer-arithmetic)
+            v[x] = chroma_v(mean); // NOLINT(*-pointer-arithmetic)
+        }
+    }
+
+    auto convert_frame(PixelFormat format, std::span<const std::uint16_t> source, std::size_t width,
+                       std::size_t height, std::span<std::uint8_t> dest) noexcept -> bool {
+        const std::size_t bytes = pixel_format_bytes(format, width, height);
+        if (bytes == 0U || dest.size() < bytes || source.size() < width * height) {
+            return false;
+        }
+        if (format != PixelFormat::YUV420) {
+            const std::size_t row = bytes / height;
+            for (std::size_t y = 0; y < height; ++y) {
+                convert_line(format, source.subspan(y * width, width), dest.subspan(y * row).data());
+            }
+            return true;
+        }
+        const std::size_t pixels = width * height;
+        const std::size_t half = width / 2U;
+        const auto u = dest.subspan(pixels, pixels / 4U);
+        const auto v = dest.subspan(pixels + (pixels / 4U), pixels / 4U);
+        for (std::size_t y = 0; y < height; ++y) {
+            convert_line_luma(source.subspan(y * width, width), dest.subspan(y * width).data());
+        }
+        for (std::size_t y = 0; y < height; y += 2U) {
+            convert_line_chroma(source.subspan(y * width, width), source.subspan((y + 1U) * width, width),
+                                u.subspan((y / 2U) * half).data(), v.subspan((y / 2U) * half).data());
+        }
+        return true;
+    }
+
+} // namespace gba
@@ -0,0 +1,92 @@
+// src/core/ppu/pixel_convert.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gba {
+
+    /**
+     * Framebuffer conversion for presentation.
+     *
+     * The PPU draws native BGR555; displays want 8 bits per channel. These convert
+     * a whole frame straight into a caller-owned, pitched destination, typically
+     * the pixels of a locked streaming texture, so the frontend touches each pixel
+     * once instead of converting into a staging frame and copying that.
+     *
+     * Notes
+     * - 5 -> 8 bit expansion replicates the top bits ((c << 3) | (c >> 2)), so 0x1F
+     *   maps to 0xFF and black stays black. Bit 15 is ignored.
+     * - XRGB8888 is one little-endian u32 per pixel, 0x00RRGGBB (SDL's XRGB8888 /
+     *   RGB888): the native layout of most GPUs, so no driver-side conversion.
+     * - `pitch` is in bytes and may exceed the row size; padding is left untouched.
+     *
+     * Output formats
+     * The PPU can also emit one of these directly from its line buffers (PPU::
+     * set_output_format), and convert_frame() produces the same bytes from a
+     * finished BGR555 frame. All are tightly packed, row-major:
+     * - BGR555: the native u16 pixels (little-endian bytes), as the framebuffer.
+     * - XRGB8888: u32 0x00RRGGBB per pixel, as above.
+     * - RGB24: three bytes R, G, B per pixel (numpy-style HxWx3).
+     * - YUV420: planar I420 for video encoders, BT.601 limited range (Y 16..235,
+     *   U/V 16..240): the full Y plane, then U and V at half width and height, each
+     *   chroma sample from the mean colour of its 2x2 block. Width and height must
+     *   be even.
+     */
+    enum class PixelFormat : std::uint8_t {
+        BGR555,
+        XRGB8888,
+        RGB24,
+        YUV420,
+    };
+
+    // Bytes of one width x height frame in `format` (0 for YUV420 with an odd dimension)
+    constexpr auto pixel_format_bytes(PixelFormat format, std::size_t width, std::size_t height) noexcept
+        -> std::size_t {
+        const std::size_t pixels = width * height;
+        switch (format) {
+        case PixelFormat::BGR555:
+            return pixels * 2U;
+        case PixelFormat::XRGB8888:
+            return pixels * 4U;
+        case PixelFormat::RGB24:
+            return pixels * 3U;
+        case PixelFormat::YUV420:
+            return (width % 2U == 0U && height % 2U == 0U) ? pixels + (pixels / 2U) : 0U;
+        }
+        return 0U;
+    }
+
+    constexpr auto bgr555_to_xrgb8888(std::uint16_t pixel) noexcept -> std::uint32_t {
+        const std::uint32_t r = pixel & 0x1FU;
+        const std::uint32_t g = (pixel >> 5U) & 0x1FU;
+        const std::uint32_t b = (pixel >> 10U) & 0x1FU;
+        return (((r << 3U) | (r >> 2U)) << 16U) | (((g << 3U) | (g >> 2U)) << 8U) | ((b << 3U) | (b >> 2U));
+    }
+
+    // BT.601 limited-range luma of a BGR555 pixel: 16 for black, 235 for white
+    constexpr auto bgr555_to_y(std::uint16_t pixel) noexcept -> std::uint8_t {
+        const std::uint32_t rgb = bgr555_to_xrgb8888(pixel);
+        const std::uint32_t r = (rgb >> 16U) & 0xFFU;
+        const std::uint32_t g = (rgb >> 8U) & 0xFFU;
+        const std::uint32_t b = rgb & 0xFFU;
+        return static_cast<std::uint8_t>((((66U * r) + (129U * g) + (25U * b) + 128U) >> 8U) + 16U);
+    }
+
+    // `source` holds `height` rows of `width` BGR555 pixels; `dest` holds `height` rows `pitch` bytes apart
+    void convert_xrgb8888(std::span<const std::uint16_t> source, std::size_t width, std::size_t height, void *dest,
+                          std::size_t pitch) noexcept;
+
+    // One line of BGR555 pixels into a packed format (BGR555, XRGB8888 or RGB24); `dest` holds the whole row
+    void convert_line(PixelFormat format, std::span<const std::uint16_t> line, std::uint8_t *dest) noexcept;
+
+    // YUV420 pieces: a row of Y, and the U/V samples of the line pair `upper`/`lower` (width / 2 each)
+    void convert_line_luma(std::span<const std::uint16_t> line, std::uint8_t *y) noexcept;
+    void convert_line_chroma(std::span<const std::uint16_t> upper, std::span<const std::uint16_t> lower,
+                             std::uint8_t *u, std::uint8_t *v) noexcept;
+
+    // A whole tightly packed frame; false, with nothing written, if `dest` is smaller than pixel_format_bytes()
+    [[nodiscard]] auto convert_frame(PixelFormat format, std::span<const std::uint16_t> source, std::size_t width,
+                                     std::size_t height, std::span<std::uint8_t> dest) noexcept -> bool;
+
+} // namespace gba
@@ -0,0 +1,200 @@
+// src/core/ppu/ppu.cpp
+#include "core/ppu/ppu.h"
+#include "core/mmu/mmu.h"
+
+#include <algorithm>
+
+namespace gba {
+
+    namespace {
+        constexpr std::uint32_t kByteBits = 8U;
+        constexpr std::uint16_t kColorMask = 0x7FFFU; // bit 15 is unused in BGR555
+        constexpr std::uint32_t kChannelMask = 0x1FU;
+        constexpr std::uint32_t kGreenShift = 5U;
+        constexpr std::uint32_t kBlueShift = 10U;
+        // BT.601 luma weights in 1/256ths; they sum to 256 so white stays 255
+        constexpr std::uint32_t kLumaR = 77U;
+        constexpr std::uint32_t kLumaG = 150U;
+        constexpr std::uint32_t kLumaB = 29U;
+        constexpr std::uint32_t kLumaRound = 128U;
+
+        auto load_color(const PagedMemory &memory, std::size_t offset) noexcept -> std::uint16_t {
+            return static_cast<std::uint16_t>((memory.read8(offset) | (memory.read8(offset + 1U) << kByteBits)) &
+                                              kColorMask);
+        }
+
+        constexpr auto expand5(std::uint32_t channel) noexcept -> std::uint32_t {
+            return (channel << 3U) | (channel >> 2U);
+        }
+
+        constexpr auto luma(std::uint16_t pixel) noexcept -> std::uint32_t {
+            const std::uint32_t r = expand5(pixel & kChannelMask);
+            const std::uint32_t g = expand5((pixel >> kGreenShift) & kChannelMask);
+            const std::uint32_t b = expand5((pixel >> kBlueShift) & kChannelMask);
+            return ((kLumaR * r) + (kLumaG * g) + (kLumaB * b) + kLumaRound) >> kByteBits;
+        }
+        static_assert(luma(0x7FFFU) == 255U && luma(0U) == 0U);
+
+        // First source row/column of output row/column `index` when `source` maps onto `output`
+        constexpr auto bin_start(std::uint32_t index, std::uint32_t source, std::uint32_t output) noexcept
+            -> std::uint32_t {
+            return ((index * source) + output - 1U) / output;
+        }
+    } // namespace
+
+    void PPU::reset() noexcept {
+        framebuffer_.fill(0U);
+        std::ranges::fill(observation_, u8{0});
+        if (!output_.empty()) {
+            (void)convert_frame(output_format_, framebuffer_, kScreenWidth, kScreenHeight, output_);
+        }
+    }
+
+    void PPU::set_output_format(PixelFormat format) {
+        if (format == PixelFormat::BGR555) {
+            output_ = {};
+        } else {
+            output_.resize(pixel_format_bytes(format, kScreenWidth, kScreenHeight));
+            (void)convert_frame(format, framebuffer_, kScreenWidth, kScreenHeight, output_);
+        }
+        output_format_ = format;
+    }
+
+    auto PPU::output() const noexcept -> std::span<const u8> {
+        if (output_format_ != PixelFormat::BGR555) {
+            return output_;
+        }
+        const auto *bytes = reinterpret_cast<const u8 *>(framebuffer_.data()); // NOLINT(*-reinterpret-cast)
+        return {bytes, sizeof(framebuffer_)};
+    }
+
+    auto PPU::set_observation(const ObservationConfig &config) -> bool {
+        if (config.width == 0U || config.width > kScreenWidth || config.height == 0U ||
+            config.height > kScreenHeight) {
+            return false;
+        }
+        const bool active = config.format != ObservationFormat::None;
+        observation_.assign(active ? std::size_t{config.width} * config.height : 0U, u8{0});
+        column_start_.resize(config.width + 1U);
+        for (u32 x = 0; x <= config.width; ++x) {
+            column_start_[x] = static_cast<u16>(bin_start(x, kScreenWidth, config.width));
+        }
+        column_sums_.assign(config.width, 0U);
+        observation_config_ = config;
+        return true;
+    }
+
+    void PPU::render_line(u16 line, const Bus &bus) noexcept {
+        if (!render_enabled_ || line >= kScreenHeight) {
+            return;
+        }
+        compose_line(line, bus);
+        if (color_output_ && output_format_ == PixelFormat::BGR555) {
+            std::ranges::copy(line_, framebuffer_.begin() + (std::ptrdiff_t{line} * kScreenWidth));
+        } else if (color_output_) {
+            write_output(line);
+        }
+        if (observation_config_.format != ObservationFormat::None) {
+            observe_line(line);
+        }
+    }
+
+    void PPU::compose_line(u16 line, const Bus &bus) noexcept {
+        indices_.fill(0U);
+        const u16 dispcnt = bus.read16(MMU::IO_BASE + IORegs::kOffDISPCNT);
+        if ((dispcnt & kDispcntForcedBlank) != 0U) {
+            line_.fill(kWhite);
+            return;
+        }
+
+        const auto vram = bus.vram();
+        const auto pal = bus.pal();
+        const u16 backdrop = load_color(pal, 0U);
+        const u32 mode = dispcnt & kDispcntModeMask;
+        const u32 page = ((dispcnt & kDispcntFrameSelect) != 0U) ? kPageBytes : 0U;
+        if ((dispcnt & kDispcntBg2) == 0U || mode < kMode3 || mode > kMode5) {
+            line_.fill(backdrop);
+            return;
+        }
+
+        if (mode == kMode3) {
+            const std::size_t base = std::size_t{line} * kScreenWidth * 2U;
+            for (u32 x = 0; x < kScreenWidth; ++x) {
+                line_[x] = load_color(vram, base + (x * 2U));
+            }
+        } else if (mode == kMode4) {
+            const std::size_t base = page + (std::size_t{line} * kScreenWidth);
+            for (u32 x = 0; x < kScreenWidth; ++x) {
+                indices_[x] = vram.read8(base + x);
+                line_[x] = load_color(pal, std::size_t{indices_[x]} * 2U);
+            }
+        } else {
+            line_.fill(backdrop);
+            if (line < kMode5Height) {
+                const std::size_t base = page + (std::size_t{line} * kMode5Width * 2U);
+                for (u32 x = 0; x < kMode5Width; ++x) {
+                    line_[x] = load_color(vram, base + (x * 2U));
+                }
+            }
+        }
+    }
+
+    void PPU::write_output(u32 line) noexcept {
+        if (output_format_ != PixelFormat::YUV420) {
+            const std::size_t row = pixel_format_bytes(output_format_, kScreenWidth, 1U);
+            convert_line(output_format_, line_, std::span(output_).subspan(line * row).data());
+            return;
+        }
+        const auto planes = std::span(output_);
+        convert_line_luma(line_, planes.subspan(std::size_t{line} * kScreenWidth).data());
+        if ((line & 1U) == 0U) {
+            upper_line_ = line_;
+            return;
+        }
+        const std::size_t chroma = (line / 2U) * (kScreenWidth / 2U);
+        convert_line_chroma(upper_line_, line_, planes.subspan(kPixels + chroma).data(),
+                            planes.subspan(kPixels + (kPixels / 4U) + chroma).data());
+    }
+
+    void PPU::observe_line(u32 line) noexcept {
+        const u32 width = observation_config_.width;
+        const u32 height = observation_config_.height;
+        const u32 row = line * height / kScreenHeight;
+        const u32 firstLine = bin_start(row, kScreenHeight, height);
+        const u32 endLine = bin_start(row + 1U, kScreenHeight, height);
+        const auto out = std::span<u8>(observation_).subspan(std::size_t{row} * width, width);
+
+        if (observation_config_.format == ObservationFormat::PaletteIndex8) {
+            if (line == firstLine) {
+                for (u32 x = 0; x < width; ++x) {
+                    out[x] = indices_[column_start_[x]];
+                }
+            }
+            return;
+        }
+
+        // Gray8: luma of the whole line (vectorises), then box sums per output column
+        std::array<u16, kScreenWidth> gray{};
+        for (u32 x = 0; x < kScreenWidth; ++x) {
+            gray[x] = static_cast<u16>(luma(line_[x]));
+        }
+        if (line == firstLine) {
+            std::ranges::fill(column_sums_, 0U);
+        }
+        for (u32 x = 0; x < width; ++x) {
+            u32 sum = 0;
+            for (u32 source = column_start_[x]; source < column_start_[x + 1U]; ++source) {
+                sum += gray[source];
+            }
+            column_sums_[x] += sum;
+        }
+        if (line + 1U == endLine) {
+            const u32 rows = endLine - firstLine;
+            for (u32 x = 0; x < width; ++x) {
+                const u32 count = rows * (column_start_[x + 1U] - column_start_[x]);
+                out[x] = static_cast<u8>((column_sums_[x] + (count / 2U)) / count);
+            }
+        }
+    }
+
+} // namespace gba
@@ -0,0 +1,129 @@
+// src/core/ppu/ppu.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "core/bus/bus.h"
+#include "core/ppu/pixel_convert.h"
+
+namespace gba {
+
+    // Reduced picture for agents, written by the PPU next to (or instead of) the framebuffer
+    enum class ObservationFormat : std::uint8_t {
+        None,          // no observation (default)
+        Gray8,         // luma 0..255, each output pixel the mean of the source pixels it covers
+        PaletteIndex8, // BG2 palette index (mode 4; 0, the backdrop entry, elsewhere), nearest sample
+    };
+
+    struct ObservationConfig {
+        ObservationFormat format = ObservationFormat::None;
+        std::uint32_t width = 240U;  // 1..240
+        std::uint32_t height = 160U; // 1..160
+    };
+
+    /**
+     * Picture processing unit, bitmap subset.
+     *
+     * We model:
+     *   - DISPCNT mode 3 (240x160 direct BGR555), mode 4 (240x160 8-bit paletted,
+     *     two pages) and mode 5 (160x128 direct, two pages) on BG2
+     *   - Forced blank (white) and the backdrop colour (palette entry 0) elsewhere
+     * Tiled modes 0-2, sprites, windows and blending are not drawn yet.
+     *
+     * Notes
+     * - The scheduler calls render_line() at HBlank start of each visible line, so
+     *   mid-frame register/VRAM writes show up on the following lines as on hardware.
+     * - With rendering disabled (run-ahead, fast-forward, headless) render_line() is a
+     *   no-op. Nothing the PPU draws feeds back into emulated state, so skipping it
+     *   cannot desync a game.
+     * - The framebuffer holds native BGR555 pixels, row-major, kScreenWidth per row.
+     *
+     * Output stage: each line is composed into a line buffer (colours, plus palette
+     * indices in mode 4) and then written out: the row of the full-colour output
+     * unless set_color_output(false), and the observation if one is configured.
+     * The full-colour output is the BGR555 framebuffer by default; with another
+     * set_output_format() each line is converted straight into output() instead
+     * (YUV420 writes a chroma row after every odd line) and framebuffer() is left
+     * as it was, so consumers get their format without a second pass.
+     * Observations are downscaled while the lines go by: source column x falls into
+     * output column x * width / 240 (rows likewise), Gray8 averages each such box and
+     * PaletteIndex8 takes its top-left pixel. An agent that only needs 84x84 gray
+     * never has a full-colour frame written or read back. The per-line passes run
+     * over fixed-size arrays in plain loops that compilers vectorise.
+     */
+    class PPU {
+      public:
+        using u8 = std::uint8_t;
+        using u16 = std::uint16_t;
+        using u32 = std::uint32_t;
+
+        static constexpr u32 kScreenWidth = 240U;
+        static constexpr u32 kScreenHeight = 160U;
+        static constexpr std::size_t kPixels = std::size_t{kScreenWidth} * kScreenHeight;
+
+        // DISPCNT fields
+        static constexpr u16 kDispcntModeMask = 0x0007U;
+        static constexpr u16 kDispcntFrameSelect = 1U << 4;
+        static constexpr u16 kDispcntForcedBlank = 1U << 7;
+        static constexpr u16 kDispcntBg2 = 1U << 10;
+
+        // Bitmap layout
+        static constexpr u32 kMode3 = 3U;
+        static constexpr u32 kMode4 = 4U;
+        static constexpr u32 kMode5 = 5U;
+        static constexpr u32 kPageBytes = 0xA000U; // second page of modes 4/5
+        static constexpr u32 kMode5Width = 160U;
+        static constexpr u32 kMode5Height = 128U;
+        static constexpr u16 kWhite = 0x7FFFU;
+
+        void reset() noexcept;
+
+        void render_line(u16 line, const Bus &bus) noexcept;
+
+        void set_render_enabled(bool enabled) noexcept { render_enabled_ = enabled; }
+        [[nodiscard]] auto render_enabled() const noexcept -> bool { return render_enabled_; }
+
+        [[nodiscard]] auto framebuffer() const noexcept -> std::span<const u16> { return framebuffer_; }
+
+        // Full-colour framebuffer output (on by default); off leaves framebuffer() as it was
+        void set_color_output(bool enabled) noexcept { color_output_ = enabled; }
+        [[nodiscard]] auto color_output() const noexcept -> bool { return color_output_; }
+
+        // Format of output(); changing it starts the buffer from the current framebuffer, converted
+        void set_output_format(PixelFormat format);
+        [[nodiscard]] auto output_format() const noexcept -> PixelFormat { return output_format_; }
+        // The full-colour picture in output_format(), pixel_format_bytes() long; the framebuffer for BGR555
+        [[nodiscard]] auto output() const noexcept -> std::span<const u8>;
+
+        // false, and the current setting kept, for a size outside 1..240 x 1..160
+        [[nodiscard]] auto set_observation(const ObservationConfig &config) -> bool;
+        [[nodiscard]] auto observation_config() const noexcept -> const ObservationConfig & {
+            return observation_config_;
+        }
+        // width x height bytes, row-major (empty for ObservationFormat::None); complete after line 159
+        [[nodiscard]] auto observation() const noexcept -> std::span<const u8> { return observation_; }
+
+      private:
+        std::array<u16, kPixels> framebuffer_{};
+        std::array<u16, kScreenWidth> line_{};   // composed colours of the current line
+        std::array<u8, kScreenWidth> indices_{}; // palette indices of the current line (mode 4)
+        bool render_enabled_ = true;
+        bool color_output_ = true;
+
+        PixelFormat output_format_ = PixelFormat::BGR555;
+        std::vector<u8> output_;                    // other formats only
+        std::array<u16, kScreenWidth> upper_line_{}; // YUV420: even line waiting for its pair
+
+        ObservationConfig observation_config_;
+        std::vector<u8> observation_;
+        std::vector<u16> column_start_; // width + 1 entries: first source column of each output column
+        std::vector<u32> column_sums_;  // Gray8: sums of the output row being accumulated
+
+        void compose_line(u16 line, const Bus &bus) noexcept;
+        void write_output(u32 line) noexcept;
+        void observe_line(u32 line) noexcept;
+    };
+
+} // namespace gba
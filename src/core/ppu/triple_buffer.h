@@ -0,0 +1,60 @@
+// src/core/ppu/triple_buffer.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gba {
+
+    /**
+     * Single-producer / single-consumer lock-free triple buffer.
+     *
+     * The producer (emulation thread) fills back() and publish()es it; the consumer
+     * (presentation thread) calls acquire() and reads front(). Three slots mean
+     * neither side ever waits: the producer always has a slot the consumer is not
+     * reading, and the consumer always gets the newest complete frame. Frames the
+     * consumer never picked up are simply overwritten (dropped); acquiring with
+     * nothing new keeps the old front (a repeat).
+     *
+     * Notes
+     * - One atomic byte holds the middle slot index plus a "fresh" bit; publish()
+     *   and a successful acquire() are a single exchange each.
+     * - back_ and front_ are private to their threads; they and the middle word live
+     *   on separate cache lines.
+     * - T should be default constructible; slots are never copied, only written in place.
+     */
+    template <typename T> class TripleBuffer {
+      public:
+        static constexpr std::size_t kCacheLine = 64;
+
+        // Producer side
+        [[nodiscard]] auto back() noexcept -> T & { return slots_[back_]; }
+        void publish() noexcept {
+            const std::uint8_t previous = middle_.exchange(static_cast<std::uint8_t>(back_ | kFresh),
+                                                           std::memory_order_acq_rel);
+            back_ = static_cast<std::uint8_t>(previous & kIndexMask);
+        }
+
+        // Consumer side. True if front() changed to a newer frame.
+        [[nodiscard]] auto acquire() noexcept -> bool {
+            if ((middle_.load(std::memory_order_relaxed) & kFresh) == 0U) {
+                return false;
+            }
+            const std::uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = static_cast<std::uint8_t>(previous & kIndexMask);
+            return true;
+        }
+        [[nodiscard]] auto front() const noexcept -> const T & { return slots_[front_]; }
+
+      private:
+        static constexpr std::uint8_t kFresh = 0x4U;
+        static constexpr std::uint8_t kIndexMask = 0x3U;
+
+        std::array<T, 3> slots_{};
+        alignas(kCacheLine) std::atomic<std::uint8_t> middle_{1};
+        alignas(kCacheLine) std::uint8_t back_ = 0;  // producer only
+        alignas(kCacheLine) std::uint8_t front_ = 2; // consumer only
+    };
+
+} // namespace gba
@@ -0,0 +1,164 @@
+// src/core/state/lz.cpp
+#include "core/state/lz.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+namespace gba {
+
+    namespace {
+        using u8 = std::uint8_t;
+        using u32 = std::uint32_t;
+        using u64 = std::uint64_t;
+
+        constexpr std::size_t kMinMatch = 4;
+        constexpr std::size_t kMaxOffset = 0xFFFF;
+        constexpr std::size_t kNibbleMax = 15;
+        constexpr std::size_t kExtraByteMax = 255;
+        constexpr unsigned kLiteralShift = 4U;
+        constexpr unsigned kByteBits = 8U;
+
+        constexpr unsigned kHashBits = 14U;
+        constexpr u32 kHashMultiplier = 2654435761U; // Knuth's multiplicative hash
+
+        auto load32(const u8 *p) noexcept -> u32 {
+            u32 v = 0;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        auto load64(const u8 *p) noexcept -> u64 {
+            u64 v = 0;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        auto hash(u32 sequence) noexcept -> u32 { return (sequence * kHashMultiplier) >> (32U - kHashBits); }
+
+        void put_length(std::vector<u8> &out, std::size_t extra) {
+            while (extra >= kExtraByteMax) {
+                out.push_back(static_cast<u8>(kExtraByteMax));
+                extra -= kExtraByteMax;
+            }
+            out.push_back(static_cast<u8>(extra));
+        }
+
+        // matchLength == 0 marks the final, literals-only sequence.
+        void emit(std::vector<u8> &out, const u8 *literals, std::size_t literalLength, std::size_t offset,
+                  std::size_t matchLength) {
+            const std::size_t matchCode = (matchLength == 0U) ? 0U : matchLength - kMinMatch;
+            const auto token = static_cast<u8>((std::min(literalLength, kNibbleMax) << kLiteralShift) |
+                                               std::min(matchCode, kNibbleMax));
+            out.push_back(token);
+            if (literalLength >= kNibbleMax) {
+                put_length(out, literalLength - kNibbleMax);
+            }
+            out.insert(out.end(), literals, literals + literalLength);
+            if (matchLength == 0U) {
+                return;
+            }
+            out.push_back(static_cast<u8>(offset));
+            out.push_back(static_cast<u8>(offset >> kByteBits));
+            if (matchCode >= kNibbleMax) {
+                put_length(out, matchCode - kNibbleMax);
+            }
+        }
+
+        auto read_length(std::span<const u8> in, std::size_t &pos, std::size_t &length) noexcept -> bool {
+            u8 byte = 0;
+            do {
+                if (pos >= in.size()) {
+                    return false;
+                }
+                byte = in[pos++];
+                length += byte;
+            } while (byte == kExtraByteMax);
+            return true;
+        }
+    } // namespace
+
+    void lz_compress(std::span<const std::uint8_t> input, std::vector<std::uint8_t> &out) {
+        out.clear();
+        const u8 *src = input.data();
+        const std::size_t size = input.size();
+        std::array<u32, std::size_t{1} << kHashBits> table{};
+
+        std::size_t anchor = 0;
+        std::size_t pos = 0;
+        while (size >= kMinMatch && pos <= size - kMinMatch) {
+            const u32 sequence = load32(src + pos);
+            const u32 slot = hash(sequence);
+            const std::size_t candidate = table[slot];
+            table[slot] = static_cast<u32>(pos);
+
+            if (candidate >= pos || pos - candidate > kMaxOffset || load32(src + candidate) != sequence) {
+                ++pos;
+                continue;
+            }
+
+            std::size_t length = kMinMatch;
+            while (pos + length + sizeof(u64) <= size &&
+                   load64(src + candidate + length) == load64(src + pos + length)) {
+                length += sizeof(u64);
+            }
+            while (pos + length < size && src[candidate + length] == src[pos + length]) {
+                ++length;
+            }
+            emit(out, src + anchor, pos - anchor, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        }
+        emit(out, src + anchor, size - anchor, 0U, 0U);
+    }
+
+    auto lz_decompress(std::span<const std::uint8_t> input, std::span<std::uint8_t> out) noexcept -> bool {
+        std::size_t in = 0;
+        std::size_t op = 0;
+        while (in < input.size()) {
+            const u8 token = input[in++];
+
+            std::size_t literals = token >> kLiteralShift;
+            if (literals == kNibbleMax && !read_length(input, in, literals)) {
+                return false;
+            }
+            if (literals > input.size() - in || literals > out.size() - op) {
+                return false;
+            }
+            std::memcpy(out.data() + op, input.data() + in, literals);
+            in += literals;
+            op += literals;
+            if (in == input.size()) {
+                break; // final literals-only sequence
+            }
+
+            if (input.size() - in < 2U) {
+                return false;
+            }
+            const std::size_t offset = input[in] | (static_cast<std::size_t>(input[in + 1U]) << kByteBits);
+            in += 2U;
+            std::size_t length = token & kNibbleMax;
+            if (length == kNibbleMax && !read_length(input, in, length)) {
+                return false;
+            }
+            length += kMinMatch;
+            if (offset == 0U || offset > op || length > out.size() - op) {
+                return false;
+            }
+
+            u8 *dst = out.data() + op;
+            const u8 *from = dst - offset;
+            if (offset >= length) {
+                std::memcpy(dst, from, length);
+            } else if (offset == 1U) {
+                std::memset(dst, *from, length); // run of one byte (zero runs in XOR deltas)
+            } else {
+                for (std::size_t i = 0; i < length; ++i) {
+                    dst[i] = from[i];
+                }
+            }
+            op += length;
+        }
+        return op == out.size();
+    }
+
+} // namespace gba
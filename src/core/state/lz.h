@@ -0,0 +1,29 @@
+// src/core/state/lz.h
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gba {
+
+    /**
+     * Small LZ77 block codec for snapshot deltas (LZ4-style sequences).
+     *
+     * Sequence: token { literal length : 4 | match length - 4 : 4 }, extra literal
+     * length bytes, literals, 16-bit LE offset, extra match length bytes. A nibble
+     * of 15 means "add the following bytes until one is below 255". The block ends
+     * with a literals-only sequence.
+     *
+     * Notes
+     * - Greedy single-probe hash matcher: fast rather than tight. XOR deltas are
+     *   mostly zero runs, which become offset-1 matches of arbitrary length.
+     * - The decoder never trusts the stream: every length and offset is bounds
+     *   checked and the output must be filled exactly.
+     */
+    void lz_compress(std::span<const std::uint8_t> input, std::vector<std::uint8_t> &out);
+
+    // `out` must be sized to the original length; returns false on a malformed block.
+    [[nodiscard]] auto lz_decompress(std::span<const std::uint8_t> input, std::span<std::uint8_t> out) noexcept
+        -> bool;
+
+} // namespace gba
@@ -0,0 +1,181 @@
+// src/core/state/rewind.cpp
+#include "core/state/rewind.h"
+#include "core/state/lz.h"
+
+#include <utility>
+
+namespace gba {
+
+    namespace {
+        void xor_into(std::span<std::uint8_t> dst, std::span<const std::uint8_t> src) noexcept {
+            for (std::size_t i = 0; i < dst.size(); ++i) {
+                dst[i] = static_cast<std::uint8_t>(dst[i] ^ src[i]);
+            }
+        }
+    } // namespace
+
+    // ------------------------------ lifecycle -------------------------------------------
+
+    RewindBuffer::RewindBuffer(RewindConfig config) : config_(config) {
+        worker_ = std::thread([this] { worker_loop(); });
+    }
+
+    RewindBuffer::~RewindBuffer() {
+        {
+            const std::lock_guard lock(queue_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        worker_.join();
+    }
+
+    void RewindBuffer::clear() {
+        flush();
+        const std::lock_guard lock(history_mutex_);
+        while (!deltas_.empty()) {
+            evict_oldest();
+        }
+        has_head_ = false;
+    }
+
+    void RewindBuffer::flush() {
+        std::unique_lock lock(queue_mutex_);
+        idle_.wait(lock, [this] { return pending_.empty() && !busy_; });
+    }
+
+    // ------------------------------ producer side -------------------------------------------
+
+    void RewindBuffer::push(std::span<const std::uint8_t> state) {
+        {
+            std::unique_lock lock(queue_mutex_);
+            idle_.wait(lock, [this] { return pending_.size() < kMaxPending; });
+            Buffer copy;
+            if (!spare_.empty()) {
+                copy = std::move(spare_.back());
+                spare_.pop_back();
+            }
+            copy.assign(state.begin(), state.end());
+            pending_.push_back(std::move(copy));
+        }
+        wake_.notify_one();
+    }
+
+    auto RewindBuffer::step_back(std::vector<std::uint8_t> &out) -> bool {
+        flush();
+        const std::lock_guard lock(history_mutex_);
+        if (deltas_.empty()) {
+            return false;
+        }
+        Buffer delta = std::move(deltas_.back());
+        deltas_.pop_back();
+        compressed_bytes_ -= delta.capacity();
+
+        scratch_.resize(head_.size());
+        const bool ok = lz_decompress(delta, scratch_);
+        recycle(std::move(delta));
+        if (!ok) {
+            // Corrupt history: nothing older is trustworthy any more
+            while (!deltas_.empty()) {
+                evict_oldest();
+            }
+            return false;
+        }
+        xor_into(head_, scratch_);
+        out.assign(head_.begin(), head_.end());
+        return true;
+    }
+
+    // ------------------------------ worker -------------------------------------------
+
+    void RewindBuffer::worker_loop() {
+        for (;;) {
+            Buffer state;
+            {
+                std::unique_lock lock(queue_mutex_);
+                wake_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+                if (pending_.empty()) {
+                    return; // stopping, and everything queued has been absorbed
+                }
+                state = std::move(pending_.front());
+                pending_.pop_front();
+                busy_ = true;
+            }
+            {
+                const std::lock_guard lock(history_mutex_);
+                absorb(state);
+            }
+            {
+                const std::lock_guard lock(queue_mutex_);
+                spare_.push_back(std::move(state)); // the previous head, recycled for push()
+                busy_ = false;
+            }
+            idle_.notify_all();
+        }
+    }
+
+    void RewindBuffer::absorb(Buffer &state) {
+        if (has_head_ && head_.size() == state.size()) {
+            // Backward delta: newer XOR older, so step_back() XORs it into the new head
+            scratch_.assign(state.begin(), state.end());
+            xor_into(scratch_, head_);
+            Buffer delta;
+            if (!free_deltas_.empty()) {
+                delta = std::move(free_deltas_.back());
+                free_deltas_.pop_back();
+            }
+            lz_compress(scratch_, delta);
+            if (delta.capacity() > 2U * delta.size()) {
+                delta.shrink_to_fit(); // a recycled buffer from a much larger delta
+            }
+            compressed_bytes_ += delta.capacity();
+            deltas_.push_back(std::move(delta));
+        } else {
+            while (!deltas_.empty()) {
+                evict_oldest();
+            }
+        }
+        std::swap(head_, state);
+        has_head_ = true;
+
+        while (!deltas_.empty() &&
+               (deltas_.size() + 1U > config_.max_snapshots || compressed_bytes_ > config_.max_bytes)) {
+            evict_oldest();
+        }
+    }
+
+    void RewindBuffer::evict_oldest() {
+        compressed_bytes_ -= deltas_.front().capacity();
+        recycle(std::move(deltas_.front()));
+        deltas_.pop_front();
+    }
+
+    void RewindBuffer::recycle(Buffer &&delta) {
+        if (free_deltas_.size() < kMaxSpareDeltas) {
+            free_deltas_.push_back(std::move(delta));
+        } else {
+            Buffer().swap(delta); // release it now, not when the moved-from slot is reused
+        }
+    }
+
+    // ------------------------------ queries -------------------------------------------
+
+    auto RewindBuffer::size() const -> std::size_t {
+        const std::lock_guard lock(history_mutex_);
+        return has_head_ ? deltas_.size() + 1U : 0U;
+    }
+
+    auto RewindBuffer::compressed_bytes() const -> std::size_t {
+        const std::lock_guard lock(history_mutex_);
+        return compressed_bytes_;
+    }
+
+    auto RewindBuffer::retained_bytes() const -> std::size_t {
+        const std::lock_guard lock(history_mutex_);
+        std::size_t total = compressed_bytes_;
+        for (const auto &spare : free_deltas_) {
+            total += spare.capacity();
+        }
+        return total;
+    }
+
+} // namespace gba
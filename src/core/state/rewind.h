@@ -0,0 +1,98 @@
+// src/core/state/rewind.h
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace gba {
+
+    struct RewindConfig {
+        std::size_t max_snapshots = 600;                // 10 s at one snapshot per frame
+        std::size_t max_bytes = std::size_t{32} << 20U; // heap held by stored deltas, excluding the head
+    };
+
+    /**
+     * Rewind history: a ring of save states stored as compressed backward deltas.
+     *
+     * The newest snapshot (the head) is kept raw. Each older snapshot is stored as
+     * lz(newer XOR older), so stepping back is one decompress + XOR into the head,
+     * and evicting the oldest entry is just dropping it. Frame to frame most of the
+     * ~400 KB state (EWRAM/VRAM) is unchanged, so a delta is mostly zero runs.
+     *
+     * Threading
+     * - push() copies the state into a recycled buffer and returns; delta + compress
+     *   run on the worker thread. At most kMaxPending pushes queue up before push()
+     *   waits for the worker (back-pressure instead of unbounded memory).
+     * - step_back() drains the queue first, so it always sees every pushed state.
+     * - Call push()/step_back()/clear() from one thread (the emulation thread).
+     *
+     * Memory is bounded by max_snapshots and max_bytes; the oldest deltas go first.
+     * Deltas are billed by capacity, not size, and a recycled buffer much larger than
+     * the delta it now holds is shrunk, so one burst of large deltas (a scene change)
+     * does not leave every later slot holding a peak-sized allocation. At most
+     * kMaxSpareDeltas emptied buffers are kept for reuse.
+     * A push whose size differs from the head (format change) restarts the history.
+     */
+    class RewindBuffer {
+      public:
+        static constexpr std::size_t kMaxPending = 4;
+        static constexpr std::size_t kMaxSpareDeltas = 4;
+
+        explicit RewindBuffer(RewindConfig config = {});
+        RewindBuffer(const RewindBuffer &) = delete;
+        auto operator=(const RewindBuffer &) -> RewindBuffer & = delete;
+        RewindBuffer(RewindBuffer &&) = delete;
+        auto operator=(RewindBuffer &&) -> RewindBuffer & = delete;
+        ~RewindBuffer();
+
+        void push(std::span<const std::uint8_t> state);
+
+        // Drops the head and writes the snapshot before it into `out` (capacity reused).
+        // Returns false when there is nothing older to go back to.
+        [[nodiscard]] auto step_back(std::vector<std::uint8_t> &out) -> bool;
+
+        void clear();
+        void flush(); // wait until every pushed state has been absorbed
+
+        [[nodiscard]] auto size() const -> std::size_t;             // reachable snapshots, head included
+        [[nodiscard]] auto compressed_bytes() const -> std::size_t; // capacity of stored deltas
+        [[nodiscard]] auto retained_bytes() const -> std::size_t;   // stored deltas + spare delta buffers
+        [[nodiscard]] auto config() const noexcept -> const RewindConfig & { return config_; }
+
+      private:
+        using Buffer = std::vector<std::uint8_t>;
+
+        RewindConfig config_;
+
+        // Queue between push() and the worker
+        std::mutex queue_mutex_;
+        std::condition_variable wake_;
+        std::condition_variable idle_;
+        std::deque<Buffer> pending_;
+        std::vector<Buffer> spare_;
+        bool busy_ = false;
+        bool stop_ = false;
+
+        // History, owned by whoever holds history_mutex_
+        mutable std::mutex history_mutex_;
+        Buffer head_;
+        bool has_head_ = false;
+        std::deque<Buffer> deltas_; // oldest first; deltas_.back() leads to the snapshot before head_
+        std::vector<Buffer> free_deltas_;
+        std::size_t compressed_bytes_ = 0;
+        Buffer scratch_;
+
+        std::thread worker_;
+
+        void worker_loop();
+        void absorb(Buffer &state); // swaps `state` with the head
+        void evict_oldest();
+        void recycle(Buffer &&delta);
+    };
+
+} // namespace gba
@@ -0,0 +1,134 @@
+// src/core/state/state_io.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace gba {
+
+    /**
+     * Save-state byte streams.
+     *
+     * Layout: header { magic "GBAS", version } followed by sections
+     * { tag (fourcc), size, payload }. Payloads are raw host-endian copies:
+     * memory arrays go in with one memcpy each, scalars as their object bytes.
+     *
+     * Deltas ("GBAD") have the same sections except that PAGE replaces MEM: per
+     * RAM region, a 64-bit mask of the pages written since the last checkpoint
+     * followed by those pages. BKUP (the save chip) carries its contents only if they
+     * were written in the interval. Replaying deltas onto a keyframe rebuilds a full state.
+     *
+     * Notes
+     * - Every supported host is little-endian, matching the guest, so states move
+     *   between machines; they are not meant to survive a format version bump.
+     * - StateWriter appends to a caller-owned vector; clear() keeps its capacity,
+     *   so saving every frame into the same vector does not allocate.
+     * - StateReader copies straight into the destination objects' existing storage.
+     */
+    inline constexpr std::uint32_t kStateMagic = 0x53414247U;      // "GBAS"
+    inline constexpr std::uint32_t kStateDeltaMagic = 0x44414247U; // "GBAD": incremental (dirty pages)
+    inline constexpr std::uint32_t kStateVersion = 2U; // 2: BKUP section
+
+    [[nodiscard]] constexpr auto state_tag(char c0, char c1, char c2, char c3) noexcept -> std::uint32_t {
+        constexpr std::uint32_t kByteBits = 8U;
+        return static_cast<std::uint32_t>(static_cast<std::uint8_t>(c0)) |
+               (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c1)) << kByteBits) |
+               (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c2)) << (2U * kByteBits)) |
+               (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c3)) << (3U * kByteBits));
+    }
+
+    // Section tags, in file order for kStateVersion
+    inline constexpr std::uint32_t kStateTagCPU = state_tag('C', 'P', 'U', ' ');
+    inline constexpr std::uint32_t kStateTagMemory = state_tag('M', 'E', 'M', ' ');
+    inline constexpr std::uint32_t kStateTagIO = state_tag('I', 'O', ' ', ' ');
+    inline constexpr std::uint32_t kStateTagAPU = state_tag('A', 'P', 'U', ' ');
+    inline constexpr std::uint32_t kStateTagBackup = state_tag('B', 'K', 'U', 'P');
+    inline constexpr std::uint32_t kStateTagScheduler = state_tag('S', 'C', 'H', 'D');
+    inline constexpr std::uint32_t kStateTagPages = state_tag('P', 'A', 'G', 'E'); // deltas: replaces MEM
+
+    class StateWriter {
+      public:
+        explicit StateWriter(std::vector<std::uint8_t> &out) noexcept : out_(out) {}
+
+        void write_bytes(std::span<const std::uint8_t> bytes) { append(bytes.data(), bytes.size()); }
+
+        template <typename T> void write(const T &value) {
+            static_assert(std::is_trivially_copyable_v<T>, "state fields must be trivially copyable");
+            append(&value, sizeof(T));
+        }
+
+        // Returns a mark for end_section(), which back-patches the payload size.
+        auto begin_section(std::uint32_t tag) -> std::size_t {
+            write(tag);
+            const std::size_t mark = out_.size();
+            write(std::uint32_t{0});
+            return mark;
+        }
+        void end_section(std::size_t mark) noexcept {
+            const auto size = static_cast<std::uint32_t>(out_.size() - mark - sizeof(std::uint32_t));
+            std::memcpy(&out_[mark], &size, sizeof(size));
+        }
+
+      private:
+        std::vector<std::uint8_t> &out_;
+
+        void append(const void *src, std::size_t size) {
+            const std::size_t at = out_.size();
+            out_.resize(at + size);
+            std::memcpy(out_.data() + at, src, size);
+        }
+    };
+
+    class StateReader {
+      public:
+        explicit StateReader(std::span<const std::uint8_t> bytes) noexcept : bytes_(bytes) {}
+
+        [[nodiscard]] auto read_bytes(std::span<std::uint8_t> out) noexcept -> bool {
+            if (out.size() > remaining()) {
+                return false;
+            }
+            std::memcpy(out.data(), bytes_.data() + pos_, out.size());
+            pos_ += out.size();
+            return true;
+        }
+
+        template <typename T> [[nodiscard]] auto read(T &value) noexcept -> bool {
+            static_assert(std::is_trivially_copyable_v<T>, "state fields must be trivially copyable");
+            if (sizeof(T) > remaining()) {
+                return false;
+            }
+            std::memcpy(&value, bytes_.data() + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return true;
+        }
+
+        // Reads a section header; fails if the tag differs or the payload overruns.
+        [[nodiscard]] auto enter_section(std::uint32_t tag) noexcept -> bool {
+            std::uint32_t found = 0;
+            std::uint32_t size = 0;
+            if (!read(found) || !read(size) || found != tag || size > remaining()) {
+                return false;
+            }
+            section_end_ = pos_ + size;
+            return true;
+        }
+        // The component must have consumed exactly its payload.
+        [[nodiscard]] auto leave_section() const noexcept -> bool { return pos_ == section_end_; }
+        // Framing-only walks (validation before touching any component)
+        void skip_section() noexcept { pos_ = section_end_; }
+        void skip(std::size_t bytes) noexcept { pos_ += std::min(bytes, remaining()); }
+
+        [[nodiscard]] auto remaining() const noexcept -> std::size_t { return bytes_.size() - pos_; }
+        [[nodiscard]] auto position() const noexcept -> std::size_t { return pos_; }
+
+      private:
+        std::span<const std::uint8_t> bytes_;
+        std::size_t pos_ = 0;
+        std::size_t section_end_ = 0;
+    };
+
+} // namespace gba
@@ -0,0 +1,219 @@
+// src/core/system/batch.cpp
+#include "core/system/batch.h"
+#include "core/mmu/mmu.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace gba {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        auto seconds_since(Clock::time_point start) -> double {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        // Whitespace-separated fields of one manifest line, comment stripped
+        auto split_fields(std::string_view line) -> std::vector<std::string_view> {
+            line = line.substr(0, line.find('#'));
+            std::vector<std::string_view> fields;
+            constexpr std::string_view kSpace = " \t\r";
+            std::size_t pos = line.find_first_not_of(kSpace);
+            while (pos != std::string_view::npos) {
+                const std::size_t end = line.find_first_of(kSpace, pos);
+                fields.push_back(line.substr(pos, end - pos));
+                pos = end == std::string_view::npos ? end : line.find_first_not_of(kSpace, end);
+            }
+            return fields;
+        }
+
+        void write_json_string(std::ostream &out, std::string_view text) {
+            out << '"';
+            for (const char c : text) {
+                if (c == '"' || c == '\\') {
+                    out << '\\' << c;
+                } else if (static_cast<unsigned char>(c) < 0x20U) {
+                    constexpr int kEscapeDigits = 4;
+                    out << "\\u" << std::hex << std::setw(kEscapeDigits) << std::setfill('0')
+                        << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+            }
+            out << '"';
+        }
+
+        void write_hash(std::ostream &out, std::uint64_t hash) {
+            constexpr int kHexDigits = 16;
+            std::ostringstream text;
+            text << std::hex << std::setw(kHexDigits) << std::setfill('0') << hash;
+            write_json_string(out, text.str());
+        }
+    } // namespace
+
+    // ------------------------------ manifest --------------------------------------------------
+
+    auto parse_manifest(std::string_view text, const std::filesystem::path &base, std::vector<BatchJob> &jobs)
+        -> bool {
+        constexpr std::size_t kFields = 3;
+        std::vector<BatchJob> parsed;
+        while (!text.empty()) {
+            const std::size_t newline = text.find('\n');
+            const auto fields = split_fields(text.substr(0, newline));
+            text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1U);
+            if (fields.empty()) {
+                continue;
+            }
+            BatchJob job;
+            const std::string_view frames = fields.size() == kFields ? fields[2] : std::string_view{};
+            const auto *end = frames.data() + frames.size(); // NOLINT(*-pointer-arithmetic)
+            const auto [ptr, ec] = std::from_chars(frames.data(), end, job.frames);
+            if (fields.size() != kFields || ec != std::errc{} || ptr != end || job.frames == 0U) {
+                return false;
+            }
+            job.rom = base / std::filesystem::path(fields[0]);
+            if (fields[1] != "-") {
+                job.input = base / std::filesystem::path(fields[1]);
+            }
+            parsed.push_back(std::move(job));
+        }
+        jobs = std::move(parsed);
+        return true;
+    }
+
+    auto load_manifest(const std::filesystem::path &file, std::vector<BatchJob> &jobs) -> bool {
+        std::ifstream ifs(file, std::ios::binary);
+        if (!ifs) {
+            return false;
+        }
+        const std::string text{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+        return parse_manifest(text, file.parent_path(), jobs);
+    }
+
+    // ------------------------------ runner ----------------------------------------------------
+
+    auto BatchSummary::frames() const noexcept -> std::uint64_t {
+        std::uint64_t total = 0;
+        for (const auto &result : results) {
+            total += result.run.frames;
+        }
+        return total;
+    }
+
+    auto BatchSummary::failed() const noexcept -> std::size_t {
+        return static_cast<std::size_t>(std::ranges::count(results, false, &BatchJobResult::ok));
+    }
+
+    BatchRunner::BatchRunner(std::size_t workers, std::filesystem::path bios)
+        : pool_(workers), bios_(std::move(bios)), workers_(pool_.size()) {}
+
+    auto BatchRunner::run(std::span<const BatchJob> jobs) -> BatchSummary {
+        BatchSummary summary;
+        summary.workers = pool_.size();
+        summary.results.resize(jobs.size());
+        const std::uint64_t steals = pool_.steals();
+        const auto start = Clock::now();
+        pool_.run(jobs.size(), [&](std::size_t index, std::size_t worker) {
+            BatchJobResult &result = summary.results[index];
+            result.worker = worker;
+            run_job(jobs[index], workers_[worker], result);
+        });
+        summary.seconds = seconds_since(start);
+        summary.steals = pool_.steals() - steals;
+        return summary;
+    }
+
+    void BatchRunner::run_job(const BatchJob &job, Worker &worker, BatchJobResult &result) {
+        const auto start = Clock::now();
+        if (!worker.system) {
+            worker.system = std::make_unique<System>();
+            worker.system->reset();
+            if (!bios_.empty()) {
+                auto bios = images_.load(bios_, MMU::BIOS_SIZE);
+                if (!bios) {
+                    worker.system.reset();
+                    result.error = "cannot load BIOS " + bios_.string();
+                    return;
+                }
+                worker.system->set_bios(std::move(bios));
+            }
+        }
+        System &system = *worker.system;
+
+        system.soft_reset();
+        result.reused = !worker.rom.empty() && worker.rom == job.rom;
+        if (!result.reused) {
+            worker.rom.clear();
+            auto rom = images_.load(job.rom);
+            if (!rom || rom->empty()) {
+                result.error = "cannot load ROM " + job.rom.string();
+                return;
+            }
+            system.set_gamepak(std::move(rom));
+            worker.rom = job.rom;
+        }
+        if (bios_.empty()) {
+            system.cpu().debug_set_program_counter(MMU::WS0_BASE); // no BIOS: start at the cartridge
+        }
+        InputScript input;
+        if (!job.input.empty() && !input.load_file(job.input)) {
+            result.error = "cannot read input " + job.input.string();
+            return;
+        }
+        result.setup_seconds = seconds_since(start);
+
+        HeadlessConfig config;
+        config.frames = job.frames;
+        config.input = &input;
+        result.run = run_headless(system, config);
+        result.memory = system.memory_footprint();
+        result.ok = true;
+    }
+
+    // ------------------------------ JSON ------------------------------------------------------
+
+    void write_batch_json(std::ostream &out, std::span<const BatchJob> jobs, const BatchSummary &summary) {
+        const auto frames = summary.frames();
+        out << std::fixed << std::setprecision(6) << "{\n"
+            << "  \"workers\": " << summary.workers << ",\n"
+            << "  \"jobs\": " << summary.results.size() << ",\n"
+            << "  \"failed\": " << summary.failed() << ",\n"
+            << "  \"seconds\": " << summary.seconds << ",\n"
+            << "  \"frames\": " << frames << ",\n"
+            << "  \"fps\": " << (summary.seconds > 0.0 ? static_cast<double>(frames) / summary.seconds : 0.0)
+            << ",\n"
+            << "  \"steals\": " << summary.steals << ",\n"
+            << "  \"results\": [";
+        for (std::size_t i = 0; i < summary.results.size(); ++i) {
+            const BatchJobResult &result = summary.results[i];
+            out << (i == 0U ? "\n" : ",\n") << "    {\"rom\": ";
+            write_json_string(out, jobs[i].rom.generic_string());
+            out << ", \"input\": ";
+            write_json_string(out, jobs[i].input.generic_string());
+            out << ", \"ok\": " << (result.ok ? "true" : "false");
+            if (!result.ok) {
+                out << ", \"error\": ";
+                write_json_string(out, result.error);
+                out << '}';
+                continue;
+            }
+            out << ", \"worker\": " << result.worker << ", \"reused\": " << (result.reused ? "true" : "false")
+                << ", \"frames\": " << result.run.frames << ", \"setup_seconds\": " << result.setup_seconds
+                << ", \"seconds\": " << result.run.seconds << ", \"fps\": " << result.run.fps()
+                << ", \"speed\": " << result.run.speed() << ", \"framebuffer_hash\": ";
+            write_hash(out, result.run.framebuffer_hash);
+            out << ", \"ram_hash\": ";
+            write_hash(out, result.run.ram_hash);
+            out << ", \"private_bytes\": " << result.memory.private_bytes
+                << ", \"shared_bytes\": " << result.memory.shared_bytes << '}';
+        }
+        out << (summary.results.empty() ? "]\n" : "\n  ]\n") << "}\n";
+    }
+
+} // namespace gba
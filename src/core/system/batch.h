@@ -0,0 +1,98 @@
+// src/core/system/batch.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/mmu/footprint.h"
+#include "core/mmu/rom_image.h"
+#include "core/system/headless.h"
+#include "core/system/system.h"
+#include "core/system/work_pool.h"
+
+namespace gba {
+
+    struct BatchJob {
+        std::filesystem::path rom;
+        std::filesystem::path input; // InputScript text or Movie file; empty = no input
+        std::uint64_t frames = 0;
+    };
+
+    /**
+     * Job manifest: one job per line, "rom input frames", '#' comments.
+     *
+     *     # rom              input            frames
+     *     roms/intro.gba     inputs/a.txt     3600
+     *     roms/intro.gba     movies/b.gbam    3600
+     *     roms/other.gba     -                600      # '-' = no input
+     *
+     * Relative paths are taken against `base` (load_manifest() uses the manifest's
+     * directory). Paths cannot contain whitespace. false, and `jobs` unchanged, on
+     * any malformed line or a frame count of 0.
+     */
+    [[nodiscard]] auto parse_manifest(std::string_view text, const std::filesystem::path &base,
+                                      std::vector<BatchJob> &jobs) -> bool;
+    [[nodiscard]] auto load_manifest(const std::filesystem::path &file, std::vector<BatchJob> &jobs) -> bool;
+
+    struct BatchJobResult {
+        bool ok = false;
+        std::string error;          // why ok is false
+        std::size_t worker = 0;     // pool worker that ran the job
+        bool reused = false;        // the worker's instance already held this ROM: soft reset only
+        double setup_seconds = 0.0; // reset + content/input loading
+        HeadlessResult run;         // timing and hashes of the emulation itself
+        MemoryFootprint memory;     // the worker's instance after the job
+    };
+
+    struct BatchSummary {
+        std::vector<BatchJobResult> results; // manifest order
+        std::size_t workers = 0;
+        double seconds = 0.0; // wall time of the whole batch
+        std::uint64_t steals = 0;
+
+        [[nodiscard]] auto frames() const noexcept -> std::uint64_t;
+        [[nodiscard]] auto failed() const noexcept -> std::size_t;
+    };
+
+    /**
+     * Runs manifests of headless jobs on a WorkStealingPool sized to the host.
+     *
+     * Each worker owns one System for the runner's lifetime. A job soft-resets it
+     * (power-on state, images kept) and loads its ROM only if the worker's previous
+     * job used a different one, so sorting a manifest by ROM makes most jobs free to
+     * set up. ROM and BIOS images come from one RomCache, so workers running the
+     * same content map a single copy of it. Results are identical to running each
+     * job alone with gba_headless: every job starts from power-on.
+     *
+     * A job that cannot load its ROM or input is reported as failed; the others run.
+     */
+    class BatchRunner {
+      public:
+        explicit BatchRunner(std::size_t workers = 0, std::filesystem::path bios = {});
+
+        [[nodiscard]] auto run(std::span<const BatchJob> jobs) -> BatchSummary;
+        [[nodiscard]] auto workers() const noexcept -> std::size_t { return pool_.size(); }
+
+      private:
+        struct Worker {
+            std::unique_ptr<System> system;
+            std::filesystem::path rom; // content currently loaded; empty = none/unknown
+        };
+
+        WorkStealingPool pool_;
+        RomCache images_;
+        std::filesystem::path bios_;
+        std::vector<Worker> workers_;
+
+        void run_job(const BatchJob &job, Worker &worker, BatchJobResult &result);
+    };
+
+    // Summary as JSON: batch totals, then one object per job in manifest order
+    void write_batch_json(std::ostream &out, std::span<const BatchJob> jobs, const BatchSummary &summary);
+
+} // namespace gba
@@ -0,0 +1,62 @@
+// src/core/system/batch_step.cpp
+#include "core/system/batch_step.h"
+
+#include <algorithm>
+
+namespace gba {
+
+    namespace {
+        auto picture_of(const System &system) noexcept -> std::span<const u8> {
+            const PPU &ppu = system.ppu();
+            if (ppu.observation_config().format != ObservationFormat::None) {
+                return ppu.observation();
+            }
+            return ppu.color_output() ? ppu.output() : std::span<const u8>();
+        }
+
+        auto configured_alike(const System &a, const System &b) noexcept -> bool {
+            const ObservationConfig &lhs = a.ppu().observation_config();
+            const ObservationConfig &rhs = b.ppu().observation_config();
+            if (lhs.format != rhs.format) {
+                return false;
+            }
+            if (lhs.format != ObservationFormat::None) {
+                return lhs.width == rhs.width && lhs.height == rhs.height;
+            }
+            return a.ppu().color_output() == b.ppu().color_output() &&
+                   a.ppu().output_format() == b.ppu().output_format();
+        }
+    } // namespace
+
+    auto BatchStepper::observation_bytes(const System &system) noexcept -> std::size_t {
+        return picture_of(system).size();
+    }
+
+    auto BatchStepper::step(std::span<System *const> instances, std::span<const std::uint16_t> actions,
+                            std::span<std::uint8_t> observations, std::size_t stride) -> bool {
+        const std::size_t count = instances.size();
+        if (actions.size() != count) {
+            return false;
+        }
+        if (!observations.empty() && count > 0U) {
+            const System &first = *instances.front();
+            const std::size_t bytes = observation_bytes(first);
+            if (bytes == 0U || stride < bytes || observations.size() / stride < count) {
+                return false;
+            }
+            if (!std::ranges::all_of(instances, [&](const System *s) { return configured_alike(*s, first); })) {
+                return false; // pictures of different shapes cannot share one stride
+            }
+        }
+        pool_.run(count, [&](std::size_t index, std::size_t /*worker*/) {
+            System &system = *instances[index];
+            system.bus().io().set_keys_pressed(actions[index]);
+            system.run_frame();
+            if (!observations.empty()) {
+                std::ranges::copy(picture_of(system), observations.subspan(index * stride).begin());
+            }
+        });
+        return true;
+    }
+
+} // namespace gba
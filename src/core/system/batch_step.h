@@ -0,0 +1,55 @@
+// src/core/system/batch_step.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "core/ppu/ppu.h"
+#include "core/system/system.h"
+#include "core/system/work_pool.h"
+
+namespace gba {
+
+    /**
+     * Vectorised stepping: one call advances many instances by one frame each on
+     * a WorkStealingPool, and gathers their pictures into one contiguous buffer.
+     *
+     * step() sets instance i's keys to actions[i], runs one frame and copies its
+     * picture to observations[i * stride ...], then returns once every instance
+     * has finished. A caller crossing a language boundary pays one call per batch
+     * instead of one (or three) per instance, and the frames run in parallel.
+     *
+     * The picture is what the instance is configured to draw: its observation when
+     * one is set (e.g. 84x84 Gray8 with colour output off, the usual agent input),
+     * otherwise its full-colour output() in the selected PixelFormat (the BGR555
+     * framebuffer by default). observation_bytes() gives its size.
+     *
+     * Notes
+     * - Instances must be distinct and not used elsewhere during the call.
+     * - One step() at a time (the pool is not re-entrant).
+     * - Empty `observations` skips the copies (agents reading RAM only).
+     * - With copies, every instance must be configured alike (same observation, or
+     *   none and the same output format) and draw something; step() refuses others.
+     */
+    class BatchStepper {
+      public:
+        // 0 = one worker per hardware thread
+        explicit BatchStepper(std::size_t workers = 0) : pool_(workers) {}
+
+        // Bytes step() copies for `system`: observation() if configured, else output() with
+        // colour output on, else 0 (it draws nothing)
+        [[nodiscard]] static auto observation_bytes(const System &system) noexcept -> std::size_t;
+
+        // false, with nothing run, if actions.size() differs from instances.size(), or
+        // observations is not empty and the instances are not configured alike, draw
+        // nothing, or do not fit: stride below observation_bytes() or observations
+        // smaller than instances.size() * stride
+        [[nodiscard]] auto step(std::span<System *const> instances, std::span<const std::uint16_t> actions,
+                                std::span<std::uint8_t> observations, std::size_t stride) -> bool;
+
+        [[nodiscard]] auto workers() const noexcept -> std::size_t { return pool_.size(); }
+
+      private:
+        WorkStealingPool pool_;
+    };
+
+} // namespace gba
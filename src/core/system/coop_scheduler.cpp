@@ -0,0 +1,80 @@
+// src/core/system/coop_scheduler.cpp
+#include "core/system/coop_scheduler.h"
+
+#include <algorithm>
+
+namespace gba {
+
+    CooperativeScheduler::CooperativeScheduler(std::size_t workers, std::uint32_t slice_cycles)
+        : pool_(workers), slice_(slice_cycles != 0U ? slice_cycles : kDefaultSliceCycles) {
+        queues_.reserve(pool_.size());
+        for (std::size_t i = 0; i < pool_.size(); ++i) {
+            queues_.push_back(std::make_unique<RunQueue>());
+        }
+    }
+
+    void CooperativeScheduler::run(std::span<System *const> instances, std::uint64_t cycles) {
+        if (instances.empty() || cycles == 0U) {
+            return;
+        }
+        // Contiguous blocks, as WorkStealingPool deals its items
+        const std::size_t cores = queues_.size();
+        for (std::size_t core = 0; core < cores; ++core) {
+            const std::size_t first = (instances.size() * core) / cores;
+            const std::size_t last = (instances.size() * (core + 1U)) / cores;
+            const std::lock_guard lock(queues_[core]->mutex);
+            for (std::size_t i = first; i < last; ++i) {
+                queues_[core]->entries.push_back(Entry{i, cycles});
+            }
+        }
+        // One item per core: each worker runs one core's scheduling loop
+        pool_.run(cores, [&](std::size_t core, std::size_t /*worker*/) { schedule(core, instances); });
+    }
+
+    auto CooperativeScheduler::stats() const noexcept -> CooperativeStats {
+        return {slices_.load(std::memory_order_relaxed), migrations_.load(std::memory_order_relaxed)};
+    }
+
+    void CooperativeScheduler::schedule(std::size_t core, std::span<System *const> instances) {
+        std::uint64_t slices = 0;
+        Entry entry{};
+        while (next(core, entry)) {
+            const auto budget = static_cast<std::uint32_t>(std::min<std::uint64_t>(entry.remaining, slice_));
+            instances[entry.index]->run(budget);
+            entry.remaining -= budget;
+            ++slices;
+            if (entry.remaining != 0U) {
+                const std::lock_guard lock(queues_[core]->mutex);
+                queues_[core]->entries.push_back(entry);
+            }
+        }
+        slices_.fetch_add(slices, std::memory_order_relaxed);
+    }
+
+    auto CooperativeScheduler::next(std::size_t core, Entry &entry) -> bool {
+        {
+            RunQueue &own = *queues_[core];
+            const std::lock_guard lock(own.mutex);
+            if (!own.entries.empty()) {
+                entry = own.entries.front();
+                own.entries.pop_front();
+                return true;
+            }
+        }
+        // Only a core's own loop refills its queue, so an empty sweep means no work is left to
+        // take: whatever is still running belongs to a core that will finish it itself.
+        const std::size_t cores = queues_.size();
+        for (std::size_t offset = 1; offset < cores; ++offset) {
+            RunQueue &victim = *queues_[(core + offset) % cores];
+            const std::lock_guard lock(victim.mutex);
+            if (!victim.entries.empty()) {
+                entry = victim.entries.back();
+                victim.entries.pop_back();
+                migrations_.fetch_add(1U, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace gba
@@ -0,0 +1,82 @@
+// src/core/system/coop_scheduler.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "core/system/system.h"
+#include "core/system/work_pool.h"
+
+namespace gba {
+
+    struct CooperativeStats {
+        std::uint64_t slices = 0;     // System::run() calls made
+        std::uint64_t migrations = 0; // slices a core took from another core's run queue
+    };
+
+    /**
+     * Cooperative multi-instance scheduling: many Systems interleaved on a few
+     * threads instead of one OS thread each.
+     *
+     * run(instances, cycles) advances every instance by `cycles` emulated cycles.
+     * Each core (one WorkStealingPool worker) owns a run queue. It takes the
+     * instance at the front, gives it one slice of System::run(), and puts it at
+     * the back if it still has budget left. The instances on a core therefore
+     * advance round-robin, a slice at a time, and all finish at about the same
+     * moment. A core whose queue runs dry steals from the back of another core's
+     * queue, so the instance moves between slices. Instances carry no thread
+     * affinity.
+     *
+     * Slicing costs nothing in accuracy: System::run() stops on exact cycle
+     * counts, so a sliced run ends in the same state as one run(cycles) call.
+     * Shorter slices interleave more finely, but they switch instances more often
+     * and so touch more cache per cycle emulated.
+     *
+     * Notes
+     * - Instances must be distinct and not used elsewhere during the call.
+     * - One run() at a time (the pool is not re-entrant).
+     * - Thousands of instances stay cheap when they are forks of one booted
+     *   System: RAM pages and ROM are shared until written.
+     */
+    class CooperativeScheduler {
+      public:
+        static constexpr std::uint32_t kDefaultSliceCycles = System::kCyclesPerLine * 16U; // ~1 ms of guest time
+
+        // 0 workers = one per hardware thread; slice_cycles 0 = kDefaultSliceCycles
+        explicit CooperativeScheduler(std::size_t workers = 0, std::uint32_t slice_cycles = kDefaultSliceCycles);
+
+        void run(std::span<System *const> instances, std::uint64_t cycles);
+
+        [[nodiscard]] auto workers() const noexcept -> std::size_t { return pool_.size(); }
+        [[nodiscard]] auto slice_cycles() const noexcept -> std::uint32_t { return slice_; }
+        // Totals since construction
+        [[nodiscard]] auto stats() const noexcept -> CooperativeStats;
+
+      private:
+        static constexpr std::size_t kCacheLine = 64;
+
+        struct Entry {
+            std::size_t index;      // into the instances passed to run()
+            std::uint64_t remaining; // cycles still owed
+        };
+
+        struct alignas(kCacheLine) RunQueue {
+            std::mutex mutex;
+            std::deque<Entry> entries;
+        };
+
+        WorkStealingPool pool_;
+        std::vector<std::unique_ptr<RunQueue>> queues_; // one per core
+        std::uint32_t slice_;
+        std::atomic<std::uint64_t> slices_{0};
+        std::atomic<std::uint64_t> migrations_{0};
+
+        void schedule(std::size_t core, std::span<System *const> instances);
+        [[nodiscard]] auto next(std::size_t core, Entry &entry) -> bool;
+    };
+
+} // namespace gba
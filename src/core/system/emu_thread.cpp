@@ -0,0 +1,182 @@
+// src/core/system/emu_thread.cpp
+#include "core/system/emu_thread.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gba {
+
+    namespace {
+        // Keep the first `keep` frames of `input`, faded in and out so the seams between
+        // consecutive cut frames do not click
+        void cut_with_fades(std::span<const AudioFrame> input, std::size_t keep, std::vector<AudioFrame> &out) {
+            out.assign(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(std::min(keep, input.size())));
+            const std::size_t fade = std::min(EmuThread::kFadeFrames, out.size() / 2U);
+            const auto steps = static_cast<std::int32_t>(fade);
+            const auto scale = [steps](AudioFrame &frame, std::int32_t level) {
+                frame.left = static_cast<std::int16_t>((frame.left * level) / steps);
+                frame.right = static_cast<std::int16_t>((frame.right * level) / steps);
+            };
+            for (std::size_t i = 0; i < fade; ++i) {
+                scale(out[i], static_cast<std::int32_t>(i));
+                scale(out[out.size() - 1U - i], static_cast<std::int32_t>(i));
+            }
+        }
+    } // namespace
+
+    EmuThread::EmuThread(System &system, AudioRing *audio)
+        : system_(system), audio_(audio), video_(std::make_unique<TripleBuffer<VideoFrame>>()),
+          pacing_(audio != nullptr ? Pacing::Audio : Pacing::Clock) {}
+
+    EmuThread::~EmuThread() { stop(); }
+
+    void EmuThread::start() {
+        if (thread_.joinable()) {
+            return;
+        }
+        stop_.store(false, std::memory_order_relaxed);
+        rate_.reset();
+        thread_ = std::thread([this] { loop(); });
+    }
+
+    void EmuThread::stop() {
+        if (!thread_.joinable()) {
+            return;
+        }
+        stop_.store(true, std::memory_order_relaxed);
+        thread_.join();
+    }
+
+    void EmuThread::loop() {
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / kFrameHz));
+        auto &ppu = system_.ppu();
+        const bool render = ppu.render_enabled();
+        std::uint64_t frames = frames_.load(std::memory_order_relaxed);
+        auto deadline = Clock::now();
+        auto nextDrawn = deadline;
+        auto windowStart = deadline;
+        std::uint64_t windowFrames = frames;
+        std::uint16_t applied = system_.bus().io().keys_pressed();
+
+        while (!stop_.load(std::memory_order_relaxed)) {
+            Pacing pacing = pacing_.load(std::memory_order_relaxed);
+            if (pacing == Pacing::Audio && audio_ == nullptr) {
+                pacing = Pacing::Clock;
+            }
+            const double speed = speed_.load(std::memory_order_relaxed);
+            const bool fastForward = speed != 1.0;
+
+            // Fast-forward draws only what the presenter can show: about one frame per normal period
+            auto now = Clock::now();
+            const bool draw = !fastForward || now >= nextDrawn;
+            if (draw) {
+                nextDrawn = std::max(nextDrawn + period, now); // keep the cadence; never bank a burst
+            }
+            ppu.set_render_enabled(render && draw);
+            if (const std::uint16_t keys = keys_.load(std::memory_order_acquire); keys != applied) {
+                applied = keys;
+                system_.bus().io().set_keys_pressed(keys);
+                start_probe(frames + 1U);
+            }
+            system_.run_frame();
+            push_audio(fastForward ? Pacing::Uncapped : pacing, speed);
+            frames_.store(++frames, std::memory_order_release);
+            track_probe(frames, draw);
+            if (draw) {
+                publish_frame(frames);
+            }
+
+            now = Clock::now();
+            if (now - windowStart >= kSpeedWindow) {
+                const std::chrono::duration<double> window = now - windowStart;
+                achieved_speed_.store(static_cast<double>(frames - windowFrames) / (window.count() * kFrameHz),
+                                      std::memory_order_relaxed);
+                windowStart = now;
+                windowFrames = frames;
+            }
+
+            if (fastForward ? speed == kUncapped : pacing != Pacing::Clock) {
+                if (!fastForward && pacing == Pacing::Audio) {
+                    wait_for_audio();
+                }
+                deadline = Clock::now(); // a switch to Clock starts from here, not from a stale deadline
+                continue;
+            }
+            deadline += fastForward ? std::chrono::duration_cast<Clock::duration>(period / speed) : period;
+            if (now > deadline + (period * kMaxLagFrames)) {
+                deadline = now; // too far behind to catch up smoothly: start over from here
+            }
+            std::this_thread::sleep_until(deadline);
+        }
+        ppu.set_render_enabled(render);
+    }
+
+    void EmuThread::push_audio(Pacing pacing, double speed) {
+        auto &apu = system_.bus().apu();
+        if (audio_ != nullptr) {
+            const auto output = apu.output();
+            if (speed == 1.0) {
+                audio_->push(output); // a full ring drops the tail; pacing keeps it near half full
+            } else {
+                // Fast-forward: 1/N of every frame keeps the ring at real-time rate and normal pitch
+                const double multiple = speed == kUncapped ? achieved_speed_.load(std::memory_order_relaxed) : speed;
+                const double keep = static_cast<double>(output.size()) / std::max(multiple, 1.0);
+                cut_with_fades(output, static_cast<std::size_t>(std::lround(keep)), cut_audio_);
+                audio_->push(cut_audio_);
+            }
+            // Audio pacing already matches the device rate; steering the ratio as well would fight it
+            apu.set_ratio_adjust(pacing == Pacing::Audio ? 1.0 : rate_.update(audio_->fill_ratio()));
+        }
+        apu.consume_output();
+    }
+
+    void EmuThread::wait_for_audio() const noexcept {
+        while (audio_->fill_ratio() >= kAudioTargetFill && !stop_.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_for(kAudioPoll);
+        }
+    }
+
+    void EmuThread::start_probe(std::uint64_t frame) {
+        pending_ = InputProbe{};
+        pending_.id = completed_.id + 1U;
+        pending_.input = key_time_.load(std::memory_order_relaxed);
+        pending_.input_frame = frame;
+        const auto pixels = system_.ppu().framebuffer();
+        reference_.assign(pixels.begin(), pixels.end());
+        static_cast<void>(system_.bus().io().take_keyinput_read()); // only reads from now on count
+    }
+
+    void EmuThread::track_probe(std::uint64_t frame, bool drawn) {
+        if (pending_.id == 0U) {
+            return;
+        }
+        if (pending_.read_frame == 0U && system_.bus().io().take_keyinput_read()) {
+            pending_.read_frame = frame;
+            pending_.read = Clock::now();
+        }
+        if (!drawn) {
+            return; // skip-render frames keep the old picture
+        }
+        const auto pixels = system_.ppu().framebuffer();
+        if (pending_.read_frame == 0U) {
+            std::ranges::copy(pixels, reference_.begin()); // changes before the read are not a response
+        } else if (!std::ranges::equal(pixels, reference_)) {
+            pending_.changed_frame = frame;
+            pending_.changed = Clock::now(); // publish_frame() follows immediately
+            completed_ = pending_;
+            pending_ = InputProbe{};
+        }
+    }
+
+    void EmuThread::publish_frame(std::uint64_t frame) noexcept {
+        VideoFrame &slot = video_->back();
+        const auto pixels = system_.ppu().framebuffer();
+        std::copy(pixels.begin(), pixels.end(), slot.pixels.begin());
+        slot.sequence = ++published_;
+        slot.frame = frame;
+        slot.finished = Clock::now();
+        slot.probe = completed_;
+        video_->publish();
+    }
+
+} // namespace gba
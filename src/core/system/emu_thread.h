@@ -0,0 +1,199 @@
+// src/core/system/emu_thread.h
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/apu/audio_ring.h"
+#include "core/apu/rate_control.h"
+#include "core/ppu/ppu.h"
+#include "core/ppu/triple_buffer.h"
+#include "core/system/latency.h"
+#include "core/system/system.h"
+
+namespace gba {
+
+    // One finished frame as published to the presenter
+    struct VideoFrame {
+        std::array<std::uint16_t, PPU::kPixels> pixels{}; // BGR555, as the PPU draws it
+        std::uint64_t sequence = 0;                      // 1, 2, 3... per published frame; 0 = none yet
+        std::uint64_t frame = 0;                         // emulated frame count when it was drawn
+        std::chrono::steady_clock::time_point finished{}; // when the emulation thread published it
+        InputProbe probe;                                 // newest input change that reached the screen
+    };
+
+    // How EmuThread decides when to start the next frame
+    enum class Pacing : std::uint8_t {
+        Uncapped, // back to back, as fast as the host allows
+        Clock,    // steady-clock deadlines every 1 / 59.73 s
+        Audio,    // keep the audio ring at its target fill: the DAC is the master clock
+    };
+
+    /**
+     * Running frame-time statistics (Welford): mean, variance and extremes of the
+     * intervals passed to add(), in milliseconds. Single-threaded; each thread that
+     * measures keeps its own.
+     */
+    struct FrameTimeStats {
+        std::uint64_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0; // sum of squared deviations from the mean
+        double min = std::numeric_limits<double>::infinity();
+        double max = 0.0;
+
+        void add(double ms) noexcept {
+            ++count;
+            const double delta = ms - mean;
+            mean += delta / static_cast<double>(count);
+            m2 += delta * (ms - mean);
+            min = std::min(min, ms);
+            max = std::max(max, ms);
+        }
+        [[nodiscard]] auto variance() const noexcept -> double {
+            return count > 1U ? m2 / static_cast<double>(count - 1U) : 0.0;
+        }
+        [[nodiscard]] auto stddev() const noexcept -> double { return std::sqrt(variance()); }
+    };
+
+    /**
+     * Presenter-side bookkeeping: call on_present() once per displayed refresh with
+     * the sequence number of the frame shown. A sequence seen again is a repeat; a
+     * gap means frames were published but never shown (dropped).
+     */
+    struct PresentStats {
+        std::uint64_t presented = 0;
+        std::uint64_t repeated = 0;
+        std::uint64_t dropped = 0;
+        std::uint64_t last_sequence = 0;
+
+        void on_present(std::uint64_t sequence) noexcept {
+            ++presented;
+            if (sequence == last_sequence) {
+                ++repeated;
+            } else if (sequence > last_sequence) {
+                dropped += sequence - last_sequence - 1U;
+            }
+            last_sequence = sequence;
+        }
+    };
+
+    /**
+     * Runs a System on its own thread and publishes every finished frame it draws.
+     *
+     * The emulation thread owns the System between start() and stop(): the frontend
+     * only talks to it through set_keys(), the triple buffer (video()) and the audio
+     * ring. Each iteration applies the latest keys, runs one frame, pushes the APU's
+     * host-rate output into the ring (steering the resampler with DynamicRateControl),
+     * copies the framebuffer into the triple buffer's back slot and publishes it,
+     * then waits until the next frame is due.
+     *
+     * Pacing
+     * - Clock: deadlines every 1 / 59.73 s on the steady clock. Falling more than
+     *   kMaxLagFrames behind (debugger, suspended laptop) resynchronises instead of
+     *   running a burst to catch up. Rate control steers the resampler to the ring.
+     * - Audio (default with a ring): run while the ring is below kAudioTargetFill,
+     *   otherwise poll every kAudioPoll until the device has drained it. Emulation
+     *   then follows the DAC crystal exactly, so the ring cannot drift into an
+     *   underrun and the resampling ratio stays nominal; the display clock is
+     *   absorbed by the triple buffer (dropped/repeated frames) instead.
+     *   Without a ring, Audio behaves as Clock.
+     * - Uncapped: no waiting at all.
+     *
+     * Fast-forward (set_speed() other than 1): deadlines every 1 / (59.73 * N) s
+     * whatever the pacing mode, or none at all for kUncapped. Only about one frame
+     * per normal frame period is drawn and published (skip-render for the rest, so
+     * the presenter still gets a fresh picture every refresh), and each frame's
+     * audio is cut to its first 1/N with short fades at the seams: real-time rate,
+     * normal pitch. Uncapped uses the measured speed for N. achieved_speed() is the
+     * emulated rate over the last kSpeedWindow as a multiple of real time.
+     *
+     * Latency: every change of the keys starts an InputProbe (timestamped by
+     * set_keys()). The thread notes the frame in which the guest next reads
+     * KEYINPUT and the first drawn frame after that whose picture differs from the
+     * previous one, then attaches the completed probe to published frames for the
+     * presenter's LatencyStats. A newer key change replaces a probe still in flight.
+     */
+    class EmuThread {
+      public:
+        using Clock = std::chrono::steady_clock;
+        static constexpr double kFrameHz = static_cast<double>(APU::kCpuHz) / System::kCyclesPerFrame; // 59.73
+        static constexpr int kMaxLagFrames = 4;
+        static constexpr double kAudioTargetFill = 0.5;
+        static constexpr std::chrono::microseconds kAudioPoll{1000};
+        static constexpr double kUncapped = 0.0;
+        static constexpr std::chrono::milliseconds kSpeedWindow{500};
+        static constexpr std::size_t kFadeFrames = 32U; // per seam when fast-forward cuts audio
+
+        // `audio` may be null (no sound device); it must outlive the thread
+        explicit EmuThread(System &system, AudioRing *audio = nullptr);
+        EmuThread(const EmuThread &) = delete;
+        auto operator=(const EmuThread &) -> EmuThread & = delete;
+        EmuThread(EmuThread &&) = delete;
+        auto operator=(EmuThread &&) -> EmuThread & = delete;
+        ~EmuThread();
+
+        void start();
+        void stop(); // joins; the System is the caller's again afterwards
+
+        // `when`: the host input event behind a change of keys (latency probes); one caller thread
+        void set_keys(std::uint16_t pressed, Clock::time_point when) noexcept {
+            if (pressed != keys_.load(std::memory_order_relaxed)) {
+                key_time_.store(when, std::memory_order_relaxed);
+                keys_.store(pressed, std::memory_order_release);
+            }
+        }
+        void set_keys(std::uint16_t pressed) noexcept { set_keys(pressed, Clock::now()); }
+        void set_pacing(Pacing pacing) noexcept { pacing_.store(pacing, std::memory_order_relaxed); }
+        [[nodiscard]] auto pacing() const noexcept -> Pacing { return pacing_.load(std::memory_order_relaxed); }
+
+        // 1 = normal speed, N > 1 (or < 1) = N x real time, kUncapped (or <= 0) = as fast as possible
+        void set_speed(double multiplier) noexcept {
+            speed_.store(std::max(multiplier, kUncapped), std::memory_order_relaxed);
+        }
+        [[nodiscard]] auto speed() const noexcept -> double { return speed_.load(std::memory_order_relaxed); }
+        [[nodiscard]] auto achieved_speed() const noexcept -> double {
+            return achieved_speed_.load(std::memory_order_relaxed);
+        }
+
+        // Consumer side of the published frames (one presenter thread)
+        [[nodiscard]] auto video() noexcept -> TripleBuffer<VideoFrame> & { return *video_; }
+
+        // Frames emulated by this thread so far (the last published sequence unless fast-forward skipped some)
+        [[nodiscard]] auto frames() const noexcept -> std::uint64_t { return frames_.load(std::memory_order_acquire); }
+        [[nodiscard]] auto running() const noexcept -> bool { return thread_.joinable(); }
+
+      private:
+        System &system_;
+        AudioRing *audio_;
+        DynamicRateControl rate_;
+        std::unique_ptr<TripleBuffer<VideoFrame>> video_; // ~230 KB: keep it off the stack
+
+        std::atomic<std::uint16_t> keys_{0};
+        std::atomic<Clock::time_point> key_time_{};
+        std::atomic<Pacing> pacing_;
+        std::atomic<double> speed_{1.0};
+        std::atomic<double> achieved_speed_{0.0};
+        std::atomic<bool> stop_{false};
+        std::atomic<std::uint64_t> frames_{0};
+        std::thread thread_;
+        std::uint64_t published_ = 0;       // emulation thread only
+        std::vector<AudioFrame> cut_audio_; // fast-forward scratch, emulation thread only
+        InputProbe pending_;                // latency probe in flight (id 0: none), emulation thread only
+        InputProbe completed_;              // newest finished probe, attached to published frames
+        std::vector<std::uint16_t> reference_; // picture the pending probe compares against
+
+        void loop();
+        void push_audio(Pacing pacing, double speed);
+        void wait_for_audio() const noexcept;
+        void publish_frame(std::uint64_t frame) noexcept;
+        void start_probe(std::uint64_t frame);
+        void track_probe(std::uint64_t frame, bool drawn);
+    };
+
+} // namespace gba
@@ -0,0 +1,238 @@
+// src/core/system/headless.cpp
+#include "core/system/headless.h"
+#include "core/io/io.h"
+#include "core/mmu/paged_memory.h"
+#include "core/ppu/ppu.h"
+#include "core/system/movie.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace gba {
+
+    namespace {
+        constexpr std::uint64_t kFnvPrime = 0x100000001B3ULL;
+
+        struct KeyName {
+            std::string_view name;
+            std::uint16_t key;
+        };
+        constexpr std::array<KeyName, 10> kKeyNames{{
+            {"a", IORegs::kKeyA},
+            {"b", IORegs::kKeyB},
+            {"select", IORegs::kKeySelect},
+            {"start", IORegs::kKeyStart},
+            {"right", IORegs::kKeyRight},
+            {"left", IORegs::kKeyLeft},
+            {"up", IORegs::kKeyUp},
+            {"down", IORegs::kKeyDown},
+            {"r", IORegs::kKeyR},
+            {"l", IORegs::kKeyL},
+        }};
+
+        auto trim(std::string_view text) noexcept -> std::string_view {
+            const auto space = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+            while (!text.empty() && space(text.front())) {
+                text.remove_prefix(1);
+            }
+            while (!text.empty() && space(text.back())) {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+        auto equals_ignore_case(std::string_view a, std::string_view b) noexcept -> bool {
+            return std::ranges::equal(a, b, [](char x, char y) {
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            });
+        }
+
+        template <typename T> auto parse_number(std::string_view text, T &value, int base) noexcept -> bool {
+            const auto *end = text.data() + text.size(); // NOLINT(*-pointer-arithmetic)
+            const auto [ptr, ec] = std::from_chars(text.data(), end, value, base);
+            return ec == std::errc{} && ptr == end;
+        }
+
+        auto parse_keys(std::string_view text, std::uint16_t &keys) noexcept -> bool {
+            if (equals_ignore_case(text, "none")) {
+                keys = 0;
+                return true;
+            }
+            if (text.starts_with("0x") || text.starts_with("0X")) {
+                constexpr int kHex = 16;
+                return parse_number(text.substr(2), keys, kHex) && (keys & ~IORegs::kKeyMask) == 0U;
+            }
+            keys = 0;
+            while (!text.empty()) {
+                const std::size_t plus = text.find('+');
+                const std::string_view name = text.substr(0, plus);
+                const auto *match = std::ranges::find_if(
+                    kKeyNames, [&](const KeyName &key) { return equals_ignore_case(key.name, name); });
+                if (match == kKeyNames.end()) {
+                    return false;
+                }
+                keys = static_cast<std::uint16_t>(keys | match->key);
+                if (plus == std::string_view::npos) {
+                    break;
+                }
+                text.remove_prefix(plus + 1U);
+                if (text.empty()) {
+                    return false; // trailing '+'
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    // ------------------------------ input script ---------------------------------------------
+
+    auto InputScript::parse(std::string_view text) -> bool {
+        constexpr int kDecimal = 10;
+        std::vector<Entry> entries;
+        while (!text.empty()) {
+            const std::size_t newline = text.find('\n');
+            std::string_view line = text.substr(0, newline);
+            text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1U);
+
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty()) {
+                continue;
+            }
+            const std::size_t split = line.find_first_of(" \t");
+            Entry entry;
+            if (split == std::string_view::npos || !parse_number(line.substr(0, split), entry.frame, kDecimal) ||
+                !parse_keys(trim(line.substr(split)), entry.keys) ||
+                (!entries.empty() && entry.frame <= entries.back().frame)) {
+                return false;
+            }
+            entries.push_back(entry);
+        }
+        entries_ = std::move(entries);
+        return true;
+    }
+
+    auto InputScript::load_file(const std::filesystem::path &file) -> bool {
+        std::ifstream ifs(file, std::ios::binary);
+        if (!ifs) {
+            return false;
+        }
+        const std::string text{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+        constexpr std::string_view kMovieMagic = "GBAM"; // Movie::kMagic as stored
+        if (text.starts_with(kMovieMagic)) {
+            Movie movie;
+            if (!movie.load_file(file)) {
+                return false;
+            }
+            assign(movie);
+            return true;
+        }
+        return parse(text);
+    }
+
+    void InputScript::assign(const Movie &movie) {
+        entries_.clear();
+        for (std::uint64_t frame = 0; frame < movie.frame_count(); ++frame) {
+            const std::uint16_t keys = movie.input(frame);
+            if (entries_.empty() ? keys != 0U : keys != entries_.back().keys) {
+                entries_.push_back({frame, keys});
+            }
+        }
+    }
+
+    auto InputScript::keys_at(std::uint64_t frame) const noexcept -> std::uint16_t {
+        // Last entry starting at or before `frame`
+        const auto after = std::ranges::upper_bound(entries_, frame, std::ranges::less{}, &Entry::frame);
+        return after == entries_.begin() ? std::uint16_t{0} : std::prev(after)->keys;
+    }
+
+    // ------------------------------ hashes ---------------------------------------------------
+
+    auto fnv1a64(std::span<const std::uint8_t> bytes, std::uint64_t seed) noexcept -> std::uint64_t {
+        std::uint64_t hash = seed;
+        for (const std::uint8_t byte : bytes) {
+            hash = (hash ^ byte) * kFnvPrime;
+        }
+        return hash;
+    }
+
+    auto framebuffer_hash(const PPU &ppu) noexcept -> std::uint64_t {
+        // Little-endian pixel by pixel so the value does not depend on the host
+        std::uint64_t hash = kFnvOffsetBasis;
+        for (const std::uint16_t pixel : ppu.framebuffer()) {
+            const std::array<std::uint8_t, 2> bytes{static_cast<std::uint8_t>(pixel & 0xFFU),
+                                                    static_cast<std::uint8_t>(pixel >> 8U)};
+            hash = fnv1a64(bytes, hash);
+        }
+        return hash;
+    }
+
+    auto ram_hash(const Bus &bus) noexcept -> std::uint64_t {
+        std::uint64_t hash = kFnvOffsetBasis;
+        for (const PagedMemory *memory : {&bus.ewram(), &bus.iwram()}) {
+            for (std::size_t i = 0; i < memory->page_count(); ++i) {
+                hash = fnv1a64(memory->page(i), hash);
+            }
+        }
+        return hash;
+    }
+
+    // ------------------------------ runner ---------------------------------------------------
+
+    auto run_headless(System &system, const HeadlessConfig &config) -> HeadlessResult {
+        auto &apu = system.bus().apu();
+        auto &ppu = system.ppu();
+        const AudioMode mode = apu.mode();
+        const bool render = ppu.render_enabled();
+        apu.set_mode(config.audio);
+        ppu.set_render_enabled(render && config.render);
+
+        const auto apply_keys = [&] {
+            if (config.input != nullptr) {
+                system.bus().io().set_keys_pressed(config.input->keys_at(system.frame()));
+            }
+        };
+        const std::uint64_t startFrame = system.frame();
+        const std::uint64_t startCycles = system.cycles();
+        const auto start = std::chrono::steady_clock::now();
+        if (config.cycles != 0U) {
+            // Line by line so keys change exactly at frame starts, as in frame mode
+            std::uint64_t remaining = config.cycles;
+            while (remaining > 0U) {
+                if (system.cycles() % System::kCyclesPerFrame == 0U) {
+                    apply_keys();
+                }
+                const auto toLineEnd = System::kCyclesPerLine - static_cast<std::uint32_t>(
+                                                                    system.cycles() % System::kCyclesPerLine);
+                const auto slice = static_cast<std::uint32_t>(std::min<std::uint64_t>(remaining, toLineEnd));
+                system.run(slice);
+                apu.consume_output();
+                remaining -= slice;
+            }
+        } else {
+            for (std::uint64_t i = 0; i < config.frames; ++i) {
+                apply_keys();
+                system.run_frame();
+                apu.consume_output();
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        apu.set_mode(mode);
+        ppu.set_render_enabled(render);
+
+        HeadlessResult result;
+        result.frames = system.frame() - startFrame;
+        result.cycles = system.cycles() - startCycles;
+        result.seconds = elapsed.count();
+        result.framebuffer_hash = framebuffer_hash(ppu);
+        result.ram_hash = ram_hash(system.bus());
+        return result;
+    }
+
+} // namespace gba
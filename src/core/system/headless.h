@@ -0,0 +1,93 @@
+// src/core/system/headless.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "core/apu/apu.h"
+#include "core/system/system.h"
+
+namespace gba {
+
+    class Movie;
+
+    /**
+     * Scripted keypad input for headless runs: a list of "from frame F, hold keys K".
+     *
+     * Text format, one entry per line, frames strictly increasing:
+     *
+     *     # frame  keys
+     *     0        none
+     *     120      A
+     *     126      Start+Right
+     *     300      0x0001          # raw mask, IORegs::kKey* bits
+     *
+     * Key names (case-insensitive) are A B Select Start Right Left Up Down R L,
+     * joined with '+'. Keys hold until the next entry; before the first entry
+     * nothing is pressed. '#' starts a comment.
+     */
+    class InputScript {
+      public:
+        struct Entry {
+            std::uint64_t frame = 0;
+            std::uint16_t keys = 0;
+        };
+
+        // false (and the script unchanged) on any malformed or out-of-order line
+        [[nodiscard]] auto parse(std::string_view text) -> bool;
+        // Script text, or a recorded Movie file (recognised by its magic)
+        [[nodiscard]] auto load_file(const std::filesystem::path &file) -> bool;
+        // A movie's per-frame inputs, one entry per change; the last keys hold after its end
+        void assign(const Movie &movie);
+
+        [[nodiscard]] auto keys_at(std::uint64_t frame) const noexcept -> std::uint16_t;
+        [[nodiscard]] auto entries() const noexcept -> std::span<const Entry> { return entries_; }
+
+      private:
+        std::vector<Entry> entries_;
+    };
+
+    struct HeadlessConfig {
+        std::uint64_t frames = 0; // run this many frames...
+        std::uint64_t cycles = 0; // ...or, if non-zero, this many cycles (keys still change at frame starts)
+        const InputScript *input = nullptr;
+        bool render = true;                       // false: skip-render (the framebuffer hash is then stale)
+        AudioMode audio = AudioMode::TimingOnly; // nobody listens: skip mixing unless asked
+    };
+
+    struct HeadlessResult {
+        std::uint64_t frames = 0; // completed during the run
+        std::uint64_t cycles = 0;
+        double seconds = 0.0; // host wall time of the emulation loop only
+        std::uint64_t framebuffer_hash = 0;
+        std::uint64_t ram_hash = 0; // EWRAM then IWRAM
+
+        [[nodiscard]] auto fps() const noexcept -> double {
+            return seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0;
+        }
+        // Emulated time over host time (1.0 = real time)
+        [[nodiscard]] auto speed() const noexcept -> double {
+            return seconds > 0.0 ? static_cast<double>(cycles) / (seconds * APU::kCpuHz) : 0.0;
+        }
+    };
+
+    // 64-bit FNV-1a; pass a previous result as `seed` to hash several spans as one
+    inline constexpr std::uint64_t kFnvOffsetBasis = 0xCBF29CE484222325ULL;
+    [[nodiscard]] auto fnv1a64(std::span<const std::uint8_t> bytes, std::uint64_t seed = kFnvOffsetBasis) noexcept
+        -> std::uint64_t;
+
+    [[nodiscard]] auto framebuffer_hash(const PPU &ppu) noexcept -> std::uint64_t;
+    [[nodiscard]] auto ram_hash(const Bus &bus) noexcept -> std::uint64_t;
+
+    /**
+     * Run `system` from its current state as configured, with no frontend, and
+     * report timing plus hashes of the final picture and work RAM. The same
+     * content, input and length always give the same hashes, which makes this the
+     * regression check for the core as well as its throughput benchmark.
+     * The APU mode and PPU render flag are restored afterwards.
+     */
+    [[nodiscard]] auto run_headless(System &system, const HeadlessConfig &config) -> HeadlessResult;
+
+} // namespace gba
@@ -0,0 +1,55 @@
+// src/core/system/instance_pool.cpp
+#include "core/system/instance_pool.h"
+
+#include <utility>
+
+namespace gba {
+
+    InstancePool::InstancePool(const System &snapshot, std::size_t warm) : snapshot_(snapshot.fork()) {
+        ready_.reserve(warm);
+        for (std::size_t i = 0; i < warm; ++i) {
+            ready_.push_back(snapshot_->fork());
+        }
+    }
+
+    auto InstancePool::acquire() -> std::unique_ptr<System> {
+        acquired_.fetch_add(1U, std::memory_order_relaxed);
+        {
+            const std::lock_guard lock(mutex_);
+            if (!ready_.empty()) {
+                auto instance = std::move(ready_.back());
+                ready_.pop_back();
+                return instance;
+            }
+        }
+        forked_.fetch_add(1U, std::memory_order_relaxed);
+        return snapshot_->fork();
+    }
+
+    void InstancePool::release(std::unique_ptr<System> instance) {
+        if (instance == nullptr) {
+            return;
+        }
+        static_cast<void>(reset(*instance));
+        const std::lock_guard lock(mutex_);
+        ready_.push_back(std::move(instance));
+    }
+
+    auto InstancePool::reset(System &instance) -> std::size_t {
+        const std::size_t pages = instance.restore(*snapshot_);
+        restores_.fetch_add(1U, std::memory_order_relaxed);
+        pages_restored_.fetch_add(pages, std::memory_order_relaxed);
+        return pages;
+    }
+
+    auto InstancePool::ready() const -> std::size_t {
+        const std::lock_guard lock(mutex_);
+        return ready_.size();
+    }
+
+    auto InstancePool::stats() const noexcept -> InstancePoolStats {
+        return {acquired_.load(std::memory_order_relaxed), forked_.load(std::memory_order_relaxed),
+                restores_.load(std::memory_order_relaxed), pages_restored_.load(std::memory_order_relaxed)};
+    }
+
+} // namespace gba
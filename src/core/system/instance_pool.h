@@ -0,0 +1,66 @@
+// src/core/system/instance_pool.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "core/system/system.h"
+
+namespace gba {
+
+    struct InstancePoolStats {
+        std::uint64_t acquired = 0;       // instances handed out
+        std::uint64_t forked = 0;         // of which none was ready: forked on the spot
+        std::uint64_t restores = 0;       // release() and reset() calls
+        std::uint64_t pages_restored = 0; // 4 KiB pages re-shared by those restores
+    };
+
+    /**
+     * Ready-to-run instances that all start from one snapshot (an episode's start
+     * state, e.g. after the intro).
+     *
+     * The pool keeps its own fork of the snapshot, never runs it, and pre-forks
+     * `warm` instances from it. acquire() hands one out; release() and reset()
+     * bring one back to the snapshot with System::restore(): only the RAM pages the
+     * episode wrote are touched (re-shared, not copied), plus the fixed-size CPU,
+     * I/O and APU state, so a reset costs microseconds rather than a ROM load and a
+     * boot. Every instance shares the untouched pages and the ROM/BIOS images with
+     * the snapshot.
+     *
+     * Notes
+     * - Thread-safe: acquire()/release() lock a short free list; restores run
+     *   outside the lock and read the snapshot concurrently.
+     * - An instance restored here is exactly a fresh fork of the snapshot, host
+     *   settings (skip-render, audio mode) included: set those before creating the pool.
+     * - Instances are not tied to the pool; release() also accepts forks of other
+     *   Systems (they become copies of this snapshot).
+     */
+    class InstancePool {
+      public:
+        InstancePool(const System &snapshot, std::size_t warm);
+
+        // A snapshot-state instance: a ready one, or a new fork when none is left
+        [[nodiscard]] auto acquire() -> std::unique_ptr<System>;
+        // Restore `instance` and keep it ready for the next acquire() (null is ignored)
+        void release(std::unique_ptr<System> instance);
+        // Restore in place, for callers that keep their instance across episodes; returns the pages re-shared
+        auto reset(System &instance) -> std::size_t;
+
+        [[nodiscard]] auto snapshot() const noexcept -> const System & { return *snapshot_; }
+        [[nodiscard]] auto ready() const -> std::size_t;
+        [[nodiscard]] auto stats() const noexcept -> InstancePoolStats;
+
+      private:
+        std::unique_ptr<System> snapshot_; // immutable after construction
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<System>> ready_;
+
+        std::atomic<std::uint64_t> acquired_{0};
+        std::atomic<std::uint64_t> forked_{0};
+        std::atomic<std::uint64_t> restores_{0};
+        std::atomic<std::uint64_t> pages_restored_{0};
+    };
+
+} // namespace gba
@@ -0,0 +1,102 @@
+// src/core/system/latency.h
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace gba {
+
+    /**
+     * One input change followed from the host to the screen (steady clock):
+     *
+     *   input    the frontend saw the key event (SDL's event timestamp)
+     *   read     end of the emulated frame in which the guest first read KEYINPUT
+     *            after the new keys were applied
+     *   changed  publish time of the first drawn frame, from the read onwards,
+     *            whose picture differs from the frame before it
+     *   present  (presenter side) the first present of a frame carrying the probe
+     *
+     * EmuThread fills in everything but the present time and attaches the newest
+     * completed probe to every frame it publishes. Frames are numbered like
+     * VideoFrame::frame; input_frame is the first frame that ran with the new keys.
+     */
+    struct InputProbe {
+        using Clock = std::chrono::steady_clock;
+
+        std::uint64_t id = 0; // 1, 2, 3... per input change; 0 = none
+        Clock::time_point input{};
+        std::uint64_t input_frame = 0;
+        std::uint64_t read_frame = 0; // 0 = guest has not read KEYINPUT yet
+        Clock::time_point read{};
+        std::uint64_t changed_frame = 0;
+        Clock::time_point changed{};
+    };
+
+    /**
+     * Fixed 1 ms buckets from 0 to kBuckets ms; slower samples land in the last one.
+     * Percentiles are bucket upper bounds, so they over-report by less than 1 ms.
+     */
+    class LatencyHistogram {
+      public:
+        static constexpr std::size_t kBuckets = 200U;
+        static constexpr double kBucketMs = 1.0;
+
+        void add(double ms) noexcept {
+            const auto index = static_cast<std::size_t>(std::max(ms, 0.0) / kBucketMs);
+            ++buckets_[std::min(index, kBuckets - 1U)];
+            ++count_;
+            sum_ += ms;
+        }
+
+        [[nodiscard]] auto count() const noexcept -> std::uint64_t { return count_; }
+        [[nodiscard]] auto mean() const noexcept -> double {
+            return count_ != 0U ? sum_ / static_cast<double>(count_) : 0.0;
+        }
+        [[nodiscard]] auto bucket(std::size_t index) const noexcept -> std::uint64_t { return buckets_[index]; }
+
+        // Smallest bucket bound with at least `fraction` (0..1) of the samples at or below it; 0 when empty
+        [[nodiscard]] auto percentile(double fraction) const noexcept -> double {
+            const auto needed = static_cast<std::uint64_t>(std::max(fraction * static_cast<double>(count_), 1.0));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < kBuckets && count_ != 0U; ++i) {
+                seen += buckets_[i];
+                if (seen >= needed) {
+                    return static_cast<double>(i + 1U) * kBucketMs;
+                }
+            }
+            return 0.0;
+        }
+
+      private:
+        std::array<std::uint64_t, kBuckets> buckets_{};
+        std::uint64_t count_ = 0;
+        double sum_ = 0.0;
+    };
+
+    /**
+     * Presenter-side latency bookkeeping: call on_present() after every present with
+     * the probe of the frame shown. Each probe is counted once, at its first present.
+     */
+    struct LatencyStats {
+        LatencyHistogram to_read;    // input -> guest reads KEYINPUT
+        LatencyHistogram to_changed; // input -> first changed frame published
+        LatencyHistogram to_present; // input -> that frame (or a newer one) presented: input-to-photon
+        std::uint64_t last_id = 0;
+
+        void on_present(const InputProbe &probe, InputProbe::Clock::time_point presented) noexcept {
+            if (probe.id == 0U || probe.id == last_id) {
+                return;
+            }
+            last_id = probe.id;
+            const auto ms = [&probe](InputProbe::Clock::time_point to) {
+                return std::chrono::duration<double, std::milli>(to - probe.input).count();
+            };
+            to_read.add(ms(probe.read));
+            to_changed.add(ms(probe.changed));
+            to_present.add(ms(presented));
+        }
+    };
+
+} // namespace gba
@@ -0,0 +1,207 @@
+// src/core/system/movie.cpp
+#include "core/system/movie.h"
+#include "core/apu/apu.h"
+#include "core/state/lz.h"
+#include "core/state/state_io.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace gba {
+
+    namespace {
+        constexpr std::uint32_t kTagHeader = state_tag('M', 'O', 'V', 'I');
+        constexpr std::uint32_t kTagInputs = state_tag('I', 'N', 'P', 'T');
+        constexpr std::uint32_t kTagKeyframes = state_tag('K', 'E', 'Y', 'F');
+
+        auto keyframes_for(std::uint64_t frames, std::uint32_t interval) noexcept -> std::uint64_t {
+            return (frames + interval - 1U) / interval;
+        }
+    } // namespace
+
+    Movie::Movie(MovieConfig config) noexcept : config_(config) {
+        config_.keyframe_interval = std::max(config_.keyframe_interval, 1U);
+    }
+
+    void Movie::clear() noexcept {
+        inputs_.clear();
+        keyframes_.clear();
+        position_ = 0;
+    }
+
+    auto Movie::keyframe_bytes() const noexcept -> std::size_t {
+        std::size_t total = 0;
+        for (const auto &keyframe : keyframes_) {
+            total += keyframe.compressed.size();
+        }
+        return total;
+    }
+
+    // ------------------------------ record / play -------------------------------------------
+
+    void Movie::truncate_to_position() {
+        inputs_.resize(position_);
+        keyframes_.resize(keyframes_for(position_, config_.keyframe_interval));
+    }
+
+    void Movie::record_frame(System &system, std::uint16_t keysPressed) {
+        if (position_ < inputs_.size()) {
+            truncate_to_position(); // re-recording from a seek point
+        }
+        if (position_ % config_.keyframe_interval == 0U) {
+            system.save_state(scratch_);
+            Keyframe keyframe;
+            keyframe.raw_size = static_cast<std::uint32_t>(scratch_.size());
+            lz_compress(scratch_, keyframe.compressed);
+            keyframes_.push_back(std::move(keyframe));
+        }
+        system.bus().io().set_keys_pressed(keysPressed);
+        system.run_frame();
+        inputs_.push_back(keysPressed);
+        ++position_;
+    }
+
+    auto Movie::play_frame(System &system) -> bool {
+        if (position_ >= inputs_.size()) {
+            return false;
+        }
+        system.bus().io().set_keys_pressed(inputs_[position_]);
+        system.run_frame();
+        ++position_;
+        return true;
+    }
+
+    auto Movie::seek(System &system, std::uint64_t frame) -> bool {
+        if (frame > inputs_.size() || keyframes_.empty()) {
+            return false;
+        }
+        const auto index = static_cast<std::size_t>(
+            std::min<std::uint64_t>(frame / config_.keyframe_interval, keyframes_.size() - 1U));
+        const Keyframe &keyframe = keyframes_[index];
+        scratch_.resize(keyframe.raw_size);
+        if (!lz_decompress(keyframe.compressed, scratch_) || !system.load_state(scratch_)) {
+            return false;
+        }
+        position_ = static_cast<std::uint64_t>(index) * config_.keyframe_interval;
+
+        // Catch up quietly; only the last frame is drawn
+        auto &ppu = system.ppu();
+        auto &apu = system.bus().apu();
+        const bool render = ppu.render_enabled();
+        const AudioMode mode = apu.mode();
+        apu.set_mode(AudioMode::TimingOnly);
+        while (position_ < frame) {
+            ppu.set_render_enabled(render && position_ + 1U == frame);
+            system.bus().io().set_keys_pressed(inputs_[position_]);
+            system.run_frame();
+            ++position_;
+        }
+        apu.set_mode(mode);
+        ppu.set_render_enabled(render);
+        return true;
+    }
+
+    // ------------------------------ serialisation -------------------------------------------
+
+    void Movie::save(std::vector<std::uint8_t> &out) const {
+        out.clear();
+        StateWriter writer(out);
+        writer.write(kMagic);
+        writer.write(kVersion);
+
+        const auto header = writer.begin_section(kTagHeader);
+        writer.write(config_.keyframe_interval);
+        writer.write(static_cast<std::uint64_t>(inputs_.size()));
+        writer.write(keyframes_.empty() ? std::uint32_t{0} : keyframes_.front().raw_size);
+        writer.end_section(header);
+
+        const auto inputs = writer.begin_section(kTagInputs);
+        for (const std::uint16_t keys : inputs_) {
+            writer.write(keys);
+        }
+        writer.end_section(inputs);
+
+        const auto keyframes = writer.begin_section(kTagKeyframes);
+        writer.write(static_cast<std::uint32_t>(keyframes_.size()));
+        for (const auto &keyframe : keyframes_) {
+            writer.write(keyframe.raw_size);
+            writer.write(static_cast<std::uint32_t>(keyframe.compressed.size()));
+            writer.write_bytes(keyframe.compressed);
+        }
+        writer.end_section(keyframes);
+    }
+
+    auto Movie::load(std::span<const std::uint8_t> bytes) -> bool {
+        StateReader reader(bytes);
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::uint32_t interval = 0;
+        std::uint64_t frames = 0;
+        std::uint32_t stateSize = 0;
+        if (!reader.read(magic) || !reader.read(version) || magic != kMagic || version != kVersion ||
+            !reader.enter_section(kTagHeader) || !reader.read(interval) || !reader.read(frames) ||
+            !reader.read(stateSize) || !reader.leave_section() || interval == 0U || stateSize > kMaxStateBytes) {
+            return false;
+        }
+
+        if (!reader.enter_section(kTagInputs) || frames > reader.remaining() / sizeof(std::uint16_t)) {
+            return false;
+        }
+        std::vector<std::uint16_t> inputs(static_cast<std::size_t>(frames));
+        for (auto &keys : inputs) {
+            if (!reader.read(keys)) {
+                return false;
+            }
+        }
+        if (!reader.leave_section()) {
+            return false;
+        }
+
+        std::uint32_t count = 0;
+        if (!reader.enter_section(kTagKeyframes) || !reader.read(count) || count != keyframes_for(frames, interval)) {
+            return false;
+        }
+        std::vector<Keyframe> keyframes(count);
+        for (auto &keyframe : keyframes) {
+            std::uint32_t size = 0;
+            if (!reader.read(keyframe.raw_size) || !reader.read(size) || keyframe.raw_size != stateSize ||
+                size > reader.remaining()) {
+                return false;
+            }
+            keyframe.compressed.resize(size);
+            if (!reader.read_bytes(keyframe.compressed)) {
+                return false;
+            }
+        }
+        if (!reader.leave_section() || reader.remaining() != 0U) {
+            return false;
+        }
+
+        config_.keyframe_interval = interval;
+        inputs_ = std::move(inputs);
+        keyframes_ = std::move(keyframes);
+        position_ = 0;
+        return true;
+    }
+
+    auto Movie::save_file(const std::filesystem::path &file) const -> bool {
+        std::vector<std::uint8_t> bytes;
+        save(bytes);
+        std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+        ofs.write(reinterpret_cast<const char *>(bytes.data()), // NOLINT(*-reinterpret-cast)
+                  static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(ofs);
+    }
+
+    auto Movie::load_file(const std::filesystem::path &file) -> bool {
+        std::ifstream ifs(file, std::ios::binary);
+        if (!ifs) {
+            return false;
+        }
+        const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+        return load(bytes);
+    }
+
+} // namespace gba
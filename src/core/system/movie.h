@@ -0,0 +1,91 @@
+// src/core/system/movie.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+#include "core/system/system.h"
+
+namespace gba {
+
+    struct MovieConfig {
+        std::uint32_t keyframe_interval = 300; // frames between embedded save states (~5 s)
+    };
+
+    /**
+     * Input movie: the keypad state of every frame, plus a save-state keyframe every
+     * keyframe_interval frames so any frame can be reached quickly.
+     *
+     * Movie frame i is the i-th frame run since record_frame() was first called on an
+     * empty movie; keyframe k is the state at the start of movie frame k * interval.
+     * seek(n) loads keyframe n / interval and re-emulates the remaining (at most
+     * interval - 1) frames with rendering off and audio in TimingOnly, except for the
+     * last frame, which is drawn so the screen shows frame n - 1's picture.
+     *
+     * Recording and playback share one cursor (position()): play_frame() replays the
+     * next recorded input, record_frame() appends one, and recording from the middle
+     * of a movie (after a seek) truncates everything after the cursor first.
+     *
+     * Notes
+     * - Playback is deterministic because keyframes carry the whole machine state,
+     *   KEYINPUT included, and input is applied at frame boundaries only.
+     * - Keyframes are LZ-compressed full states; the BIOS/GamePak are not stored, so
+     *   load the same content before seeking.
+     * - File layout: header { "GBAM", version } then sections MOVI (interval, frame
+     *   count, state size), INPT (one u16 per frame), KEYF (count, then raw and
+     *   compressed size plus payload per keyframe). load() validates all of it before
+     *   replacing anything; every keyframe must decompress to the recorded state size,
+     *   at most kMaxStateBytes, so a damaged file cannot make seek() allocate at will.
+     * - One movie records one System with one content: its keyframes share a size.
+     */
+    class Movie {
+      public:
+        static constexpr std::uint32_t kMagic = 0x4D414247U; // "GBAM"
+        static constexpr std::uint32_t kVersion = 2U; // 2: MOVI records the state size
+        // Cap on a keyframe's raw size; a full state with 128 KiB Flash is about 0.5 MiB
+        static constexpr std::uint32_t kMaxStateBytes = 1U << 20U;
+
+        explicit Movie(MovieConfig config = {}) noexcept;
+
+        // Recording: set the keys, run one frame, store the input (keyframe first when due)
+        void record_frame(System &system, std::uint16_t keysPressed);
+
+        // Playback: run the next recorded frame; false at the end of the movie
+        [[nodiscard]] auto play_frame(System &system) -> bool;
+
+        // Put `system` at the start of movie frame `frame` (<= frame_count()).
+        // false if out of range or a keyframe fails to load.
+        [[nodiscard]] auto seek(System &system, std::uint64_t frame) -> bool;
+
+        void clear() noexcept;
+
+        [[nodiscard]] auto position() const noexcept -> std::uint64_t { return position_; }
+        [[nodiscard]] auto frame_count() const noexcept -> std::uint64_t { return inputs_.size(); }
+        [[nodiscard]] auto input(std::uint64_t frame) const noexcept -> std::uint16_t { return inputs_[frame]; }
+        [[nodiscard]] auto keyframe_count() const noexcept -> std::size_t { return keyframes_.size(); }
+        [[nodiscard]] auto keyframe_bytes() const noexcept -> std::size_t; // compressed, all keyframes
+        [[nodiscard]] auto config() const noexcept -> const MovieConfig & { return config_; }
+
+        void save(std::vector<std::uint8_t> &out) const;
+        [[nodiscard]] auto load(std::span<const std::uint8_t> bytes) -> bool; // cursor back to 0
+
+        [[nodiscard]] auto save_file(const std::filesystem::path &file) const -> bool;
+        [[nodiscard]] auto load_file(const std::filesystem::path &file) -> bool;
+
+      private:
+        struct Keyframe {
+            std::uint32_t raw_size = 0;
+            std::vector<std::uint8_t> compressed;
+        };
+
+        MovieConfig config_;
+        std::vector<std::uint16_t> inputs_;
+        std::vector<Keyframe> keyframes_;
+        std::uint64_t position_ = 0;
+        std::vector<std::uint8_t> scratch_; // save/decompress buffer, reused
+
+        void truncate_to_position();
+    };
+
+} // namespace gba
@@ -0,0 +1,35 @@
+// src/core/system/run_ahead.cpp
+#include "core/system/run_ahead.h"
+
+namespace gba {
+
+    auto RunAhead::run_frame(std::uint16_t keysPressed) -> bool {
+        system_.bus().io().set_keys_pressed(keysPressed);
+        if (frames_ == 0U) {
+            system_.run_frame();
+            return true;
+        }
+
+        auto &ppu = system_.ppu();
+        auto &apu = system_.bus().apu();
+        const bool render = ppu.render_enabled();
+        const AudioMode mode = apu.mode();
+
+        // The real frame: its audio is the audio, its picture is never shown
+        ppu.set_render_enabled(false);
+        system_.run_frame();
+        system_.save_state(state_);
+
+        // Hidden frames: silent, and only the last one is drawn
+        apu.set_mode(AudioMode::TimingOnly);
+        for (std::uint32_t i = 1; i <= frames_; ++i) {
+            ppu.set_render_enabled(render && i == frames_);
+            system_.run_frame();
+        }
+        apu.set_mode(mode);
+        ppu.set_render_enabled(render);
+
+        return system_.load_state(state_);
+    }
+
+} // namespace gba
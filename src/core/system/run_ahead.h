@@ -0,0 +1,48 @@
+// src/core/system/run_ahead.h
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "core/system/system.h"
+
+namespace gba {
+
+    /**
+     * Run-ahead: hide a game's built-in input lag by showing a frame from the future.
+     *
+     * Each host frame with K > 0:
+     *   1. run the real frame with the current input (audio kept, picture skipped),
+     *   2. save state,
+     *   3. run K more frames with the same input, audio in TimingOnly and the PPU
+     *      drawing only the last one,
+     *   4. restore the state from step 2.
+     * The framebuffer then shows frame N+K while the machine sits at frame N, so a
+     * press reaches the screen K frames sooner. Cost: K extra frames of CPU work
+     * plus one save/load per host frame.
+     *
+     * Notes
+     * - Assumes the game reads input the same way in the hidden frames, which holds
+     *   for games that poll once per frame; lag that is in the game logic is removed,
+     *   lag from polling mid-frame is not.
+     * - The state buffer is reused across frames (save_state() keeps its capacity).
+     */
+    class RunAhead {
+      public:
+        static constexpr std::uint32_t kMaxFrames = 8U;
+
+        explicit RunAhead(System &system) noexcept : system_(system) {}
+
+        void set_frames(std::uint32_t frames) noexcept { frames_ = std::min(frames, kMaxFrames); }
+        [[nodiscard]] auto frames() const noexcept -> std::uint32_t { return frames_; }
+
+        // Advance the real timeline by one frame with `keysPressed` held (IORegs::kKey*).
+        // Returns false only if restoring the snapshot failed.
+        [[nodiscard]] auto run_frame(std::uint16_t keysPressed) -> bool;
+
+      private:
+        System &system_;
+        std::uint32_t frames_ = 0;
+        std::vector<std::uint8_t> state_;
+    };
+
+} // namespace gba
@@ -0,0 +1,265 @@
+// src/core/system/system.cpp
+#include "core/system/system.h"
+#include "core/state/state_io.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace gba {
+
+    namespace {
+        // Section order for this format version (Bus contributes MEM/IO/APU/BKUP or PAGE/IO/APU/BKUP)
+        constexpr std::size_t kSections = 6;
+        constexpr std::size_t kMemorySlot = 1;
+        constexpr std::size_t kBackupSlot = 4;
+        constexpr std::array<std::uint32_t, kSections> kSectionOrder{
+            kStateTagCPU, kStateTagMemory, kStateTagIO, kStateTagAPU, kStateTagBackup, kStateTagScheduler};
+        constexpr std::array<std::uint32_t, kSections> kDeltaSectionOrder{
+            kStateTagCPU, kStateTagPages, kStateTagIO, kStateTagAPU, kStateTagBackup, kStateTagScheduler};
+
+        struct SectionSpan {
+            std::size_t offset = 0;
+            std::size_t size = 0;
+        };
+        using SectionIndex = std::array<SectionSpan, kSections>;
+
+        // SCHD: cycles, frame, position in the line
+        constexpr std::size_t kSchedulerStateBytes = (2U * sizeof(std::uint64_t)) + sizeof(std::uint32_t);
+
+        // Payload size of a fixed-size section. BKUP depends on the save chip (Backup checks it)
+        // and PAGE on the dirty set (MMU::apply_dirty_pages checks it): 0, not checked here.
+        constexpr auto fixed_payload_bytes(std::uint32_t tag) noexcept -> std::size_t {
+            switch (tag) {
+            case kStateTagCPU:
+                return ARM7TDMI::state_bytes();
+            case kStateTagMemory:
+                return MMU::kStateMemoryBytes;
+            case kStateTagIO:
+                return IORegs::state_bytes();
+            case kStateTagAPU:
+                return APU::state_bytes();
+            case kStateTagScheduler:
+                return kSchedulerStateBytes;
+            default:
+                return 0;
+            }
+        }
+
+        auto read_header(StateReader &in, std::uint32_t magic) noexcept -> bool {
+            std::uint32_t found = 0;
+            std::uint32_t version = 0;
+            return in.read(found) && in.read(version) && found == magic && version == kStateVersion;
+        }
+
+        // Walk the framing and check every fixed section size, so a truncated, foreign or
+        // resized blob never half-loads.
+        auto index_sections(std::span<const std::uint8_t> bytes, std::uint32_t magic,
+                            const std::array<std::uint32_t, kSections> &order, SectionIndex &index) noexcept -> bool {
+            StateReader probe(bytes);
+            if (!read_header(probe, magic)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < kSections; ++i) {
+                if (!probe.enter_section(order[i])) {
+                    return false;
+                }
+                index[i].offset = probe.position();
+                probe.skip_section();
+                index[i].size = probe.position() - index[i].offset;
+                const std::size_t expected = fixed_payload_bytes(order[i]);
+                if (expected != 0U && index[i].size != expected) {
+                    return false;
+                }
+            }
+            return probe.remaining() == 0U;
+        }
+
+    } // namespace
+
+    // ------------------------------ lifecycle -------------------------------------------
+
+    System::System(const System &parent, ForkTag /*unused*/)
+        : bus_(parent.bus_), cpu_(parent.cpu_), ppu_(parent.ppu_), cycles_(parent.cycles_), frame_(parent.frame_),
+          line_cycles_(parent.line_cycles_) {
+        cpu_.attach(bus_);
+    }
+
+    auto System::fork() const -> std::unique_ptr<System> {
+        return std::unique_ptr<System>(new System(*this, ForkTag{})); // private constructor: no make_unique
+    }
+
+    auto System::restore(const System &snapshot) -> std::size_t {
+        const std::size_t pages = bus_.restore(snapshot.bus_);
+        cpu_ = snapshot.cpu_;
+        cpu_.attach(bus_);
+        ppu_ = snapshot.ppu_; // the snapshot's picture is the first observation
+        cycles_ = snapshot.cycles_;
+        frame_ = snapshot.frame_;
+        line_cycles_ = snapshot.line_cycles_;
+        return pages;
+    }
+
+    auto System::memory_footprint() const noexcept -> MemoryFootprint {
+        MemoryFootprint footprint;
+        footprint.add(sizeof(System), false); // CPU, PPU framebuffer, IO/APU registers, page tables
+        bus_.add_footprint(footprint);
+        return footprint;
+    }
+
+    void System::reset() noexcept {
+        bus_.reset();
+        reset_machine();
+    }
+
+    void System::soft_reset() noexcept {
+        bus_.soft_reset();
+        reset_machine();
+    }
+
+    void System::reset_machine() noexcept {
+        cpu_.reset();
+        ppu_.reset();
+        cycles_ = 0;
+        frame_ = 0;
+        line_cycles_ = 0;
+    }
+
+    // ------------------------------ scheduler -------------------------------------------
+
+    void System::run(u32 cycles) noexcept {
+        while (cycles > 0U) {
+            // Next event: HBlank start, or end of line
+            const u32 boundary = (line_cycles_ < kHDrawCycles) ? kHDrawCycles : kCyclesPerLine;
+            const u32 slice = std::min(cycles, boundary - line_cycles_);
+            for (u32 i = 0; i < slice; ++i) {
+                cpu_.step();
+            }
+            bus_.apu().advance(slice);
+
+            line_cycles_ += slice;
+            cycles_ += slice;
+            cycles -= slice;
+
+            if (line_cycles_ == kHDrawCycles) {
+                bus_.io().set_hblank(true);
+                ppu_.render_line(bus_.io().vcount(), bus_);
+            } else if (line_cycles_ == kCyclesPerLine) {
+                end_line();
+            }
+        }
+    }
+
+    void System::run_frame() noexcept {
+        const auto line = static_cast<u32>(bus_.io().vcount());
+        const u32 remaining = ((kLinesPerFrame - line - 1U) * kCyclesPerLine) + (kCyclesPerLine - line_cycles_);
+        run(remaining);
+    }
+
+    void System::end_line() noexcept {
+        auto &io = bus_.io();
+        io.set_hblank(false);
+        line_cycles_ = 0;
+
+        auto next = static_cast<u16>(io.vcount() + 1U);
+        if (next == kLinesPerFrame) {
+            next = 0;
+            ++frame_;
+            bus_.apu().end_frame();
+        }
+        io.set_vcount(next);
+    }
+
+    // ------------------------------ save states -------------------------------------------
+
+    void System::save_state(std::vector<u8> &out) const {
+        out.clear();
+        StateWriter writer(out);
+        writer.write(kStateMagic);
+        writer.write(kStateVersion);
+        save_cpu(writer);
+        bus_.save_state(writer);
+        save_scheduler(writer);
+    }
+
+    void System::save_delta(std::vector<u8> &out) {
+        out.clear();
+        StateWriter writer(out);
+        writer.write(kStateDeltaMagic);
+        writer.write(kStateVersion);
+        save_cpu(writer);
+        bus_.save_delta(writer);
+        save_scheduler(writer);
+        bus_.clear_dirty();
+    }
+
+    void System::save_cpu(StateWriter &out) const {
+        const auto cpu = out.begin_section(kStateTagCPU);
+        cpu_.save_state(out);
+        out.end_section(cpu);
+    }
+
+    void System::save_scheduler(StateWriter &out) const {
+        static_assert(sizeof(cycles_) + sizeof(frame_) + sizeof(line_cycles_) == kSchedulerStateBytes);
+        const auto sched = out.begin_section(kStateTagScheduler);
+        out.write(cycles_);
+        out.write(frame_);
+        out.write(line_cycles_);
+        out.end_section(sched);
+    }
+
+    auto System::load_state(std::span<const u8> bytes) noexcept -> bool {
+        SectionIndex index{};
+        if (!index_sections(bytes, kStateMagic, kSectionOrder, index) ||
+            !bus_.backup().accepts_state(bytes.subspan(index[kBackupSlot].offset, index[kBackupSlot].size))) {
+            return false; // foreign framing, a resized section, or a state of another save chip
+        }
+        StateReader reader(bytes);
+        if (!read_header(reader, kStateMagic)) {
+            return false;
+        }
+        if (!reader.enter_section(kStateTagCPU) || !cpu_.load_state(reader) || !reader.leave_section()) {
+            return false;
+        }
+        if (!bus_.load_state(reader)) {
+            return false;
+        }
+        return reader.enter_section(kStateTagScheduler) && reader.read(cycles_) && reader.read(frame_) &&
+               reader.read(line_cycles_) && reader.leave_section();
+    }
+
+    auto System::apply_delta(std::vector<u8> &state, std::span<const u8> delta) noexcept -> bool {
+        SectionIndex target{};
+        SectionIndex patch{};
+        if (!index_sections(state, kStateMagic, kSectionOrder, target) ||
+            !index_sections(delta, kStateDeltaMagic, kDeltaSectionOrder, patch)) {
+            return false;
+        }
+        std::array<std::size_t, kSections> copy{};
+        for (std::size_t i = 0; i < kSections; ++i) {
+            copy[i] = patch[i].size;
+            if (i == kBackupSlot) {
+                copy[i] = Backup::delta_bytes(std::span<const u8>(state).subspan(target[i].offset, target[i].size),
+                                              delta.subspan(patch[i].offset, patch[i].size));
+                if (copy[i] == 0U) {
+                    return false;
+                }
+            } else if (i != kMemorySlot && target[i].size != patch[i].size) {
+                return false;
+            }
+        }
+
+        const auto memory = std::span<u8>(state).subspan(target[kMemorySlot].offset, target[kMemorySlot].size);
+        const auto pages = delta.subspan(patch[kMemorySlot].offset, patch[kMemorySlot].size);
+        if (!MMU::apply_dirty_pages(memory, pages)) {
+            return false;
+        }
+        for (std::size_t i = 0; i < kSections; ++i) {
+            if (i != kMemorySlot) {
+                std::memcpy(state.data() + target[i].offset, delta.data() + patch[i].offset, copy[i]);
+            }
+        }
+        return true;
+    }
+
+} // namespace gba
@@ -0,0 +1,141 @@
+// src/core/system/system.h
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+#include "core/bus/bus.h"
+#include "core/cpu/arm7tdmi.h"
+#include "core/ppu/ppu.h"
+
+namespace gba {
+
+    /**
+     * The assembled machine: Bus (MMU + devices), ARM7TDMI, PPU and the scanline scheduler.
+     *
+     * Timing model (placeholder until the pipeline/wait-state model lands)
+     * - One CPU step counts as one cycle.
+     * - A scanline is 1232 cycles: 960 of HDraw, then 272 of HBlank; 228 lines
+     *   (160 visible + 68 VBlank) make a 280896-cycle frame (~59.73 Hz).
+     * - The scheduler drives VCOUNT/HBlank in IORegs at those boundaries, has the PPU
+     *   draw each visible line at HBlank start and closes the APU's output frame at
+     *   the end of line 227.
+     *
+     * Notes
+     * - The CPU keeps a pointer to bus_, so a System is neither copyable nor movable;
+     *   fork() is the way to duplicate one.
+     * - BIOS and GamePak are immutable RomImages held by reference count; instances
+     *   given the same image (set_bios/set_gamepak, fork()) share one copy.
+     * - Re-entrant: every bit of machine state lives in the instance (the core has no
+     *   mutable globals or statics), so separate instances may run on separate
+     *   threads with no locking. One instance is single-threaded.
+     * - reset() clears everything including the BIOS and GamePak images (MMU semantics);
+     *   load content after it. soft_reset() gives the same power-on state but keeps the
+     *   loaded images, so one instance can run job after job of the same content.
+     */
+    class System {
+      public:
+        using u8 = std::uint8_t;
+        using u16 = std::uint16_t;
+        using u32 = std::uint32_t;
+        using u64 = std::uint64_t;
+
+        static constexpr u32 kHDrawCycles = 960U;
+        static constexpr u32 kHBlankCycles = 272U;
+        static constexpr u32 kCyclesPerLine = kHDrawCycles + kHBlankCycles;
+        static constexpr u16 kLinesPerFrame = 228U;
+        static constexpr u32 kCyclesPerFrame = kCyclesPerLine * kLinesPerFrame; // 280896
+
+        System() { cpu_.attach(bus_); }
+        System(const System &) = delete;
+        auto operator=(const System &) -> System & = delete;
+        System(System &&) = delete;
+        auto operator=(System &&) -> System & = delete;
+        ~System() = default;
+
+        void reset() noexcept;
+        void soft_reset() noexcept;
+
+        [[nodiscard]] auto load_bios(const std::filesystem::path &file) noexcept -> bool {
+            return bus_.load_bios(file);
+        }
+        [[nodiscard]] auto load_gamepak(const std::filesystem::path &file) noexcept -> bool {
+            return bus_.load_gamepak(file);
+        }
+        void load_gamepak(std::span<const u8> bytes) noexcept { bus_.load_gamepak(bytes); }
+
+        // Content shared with other instances: load once (RomImage::load or a RomCache), map anywhere
+        void set_bios(std::shared_ptr<const RomImage> image) noexcept { bus_.set_bios(std::move(image)); }
+        void set_gamepak(std::shared_ptr<const RomImage> image) noexcept { bus_.set_gamepak(std::move(image)); }
+
+        // Host memory of this instance: private (its own RAM pages, device state, buffers) and
+        // shared (images and copy-on-write pages other instances also reference)
+        [[nodiscard]] auto memory_footprint() const noexcept -> MemoryFootprint;
+
+        // Scheduler entry points
+        void run(u32 cycles) noexcept;
+        void run_frame() noexcept; // up to the next end of line 227
+
+        // A child that continues from exactly this point. Guest RAM is shared
+        // copy-on-write per 4 KiB page and the GamePak image is shared outright, so
+        // the cost is the page tables plus the small fixed-size device state.
+        [[nodiscard]] auto fork() const -> std::unique_ptr<System>;
+
+        // Turn this instance back into what fork() of `snapshot` would give (host-side settings
+        // such as skip-render and the audio mode included), reusing it: RAM pages written since
+        // the two last matched are re-shared from the snapshot without copying, the device
+        // state is copied. Returns the pages re-shared. `snapshot` is only read, so many
+        // instances may restore from one snapshot concurrently as long as it is not running.
+        auto restore(const System &snapshot) -> std::size_t;
+
+        // Save states: versioned, sectioned, memory arrays copied raw.
+        // save_state() clears `out` first (its capacity is reused across calls);
+        // load_state() validates framing, section sizes and the save chip before touching
+        // anything, then restores into this instance's existing buffers.
+        void save_state(std::vector<u8> &out) const;
+        [[nodiscard]] auto load_state(std::span<const u8> bytes) noexcept -> bool;
+
+        // Incremental save states. Typical use: save_state(keyframe); checkpoint();
+        // then save_delta() each frame. A delta holds full CPU/IO/APU/scheduler state
+        // plus only the RAM pages and backup contents written since the previous
+        // checkpoint/delta, and starts the next interval. Note load_state() dirties
+        // every page.
+        void checkpoint() noexcept { bus_.clear_dirty(); }
+        void save_delta(std::vector<u8> &out);
+
+        // Rebuild: turn the full state `state` (keyframe, or the result of earlier
+        // calls) into the state the delta was taken at. Both blobs are validated
+        // first; on failure `state` is unchanged.
+        [[nodiscard]] static auto apply_delta(std::vector<u8> &state, std::span<const u8> delta) noexcept -> bool;
+
+        [[nodiscard]] auto cpu() noexcept -> ARM7TDMI & { return cpu_; }
+        [[nodiscard]] auto cpu() const noexcept -> const ARM7TDMI & { return cpu_; }
+        [[nodiscard]] auto bus() noexcept -> Bus & { return bus_; }
+        [[nodiscard]] auto bus() const noexcept -> const Bus & { return bus_; }
+        [[nodiscard]] auto ppu() noexcept -> PPU & { return ppu_; }
+        [[nodiscard]] auto ppu() const noexcept -> const PPU & { return ppu_; }
+
+        [[nodiscard]] auto cycles() const noexcept -> u64 { return cycles_; }
+        [[nodiscard]] auto frame() const noexcept -> u64 { return frame_; }
+
+      private:
+        struct ForkTag {};
+        System(const System &parent, ForkTag /*unused*/);
+
+        Bus bus_{};
+        ARM7TDMI cpu_{};
+        PPU ppu_{}; // output only: not part of save states
+
+        // Scheduler state
+        u64 cycles_ = 0;      // total cycles since reset
+        u64 frame_ = 0;       // completed frames since reset
+        u32 line_cycles_ = 0; // position inside the current scanline
+
+        void reset_machine() noexcept; // CPU, PPU and scheduler (everything but the bus)
+        void end_line() noexcept;
+        void save_cpu(StateWriter &out) const;
+        void save_scheduler(StateWriter &out) const;
+    };
+
+} // namespace gba
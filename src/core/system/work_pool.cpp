@@ -0,0 +1,119 @@
+// src/core/system/work_pool.cpp
+#include "core/system/work_pool.h"
+
+#include <algorithm>
+
+namespace gba {
+
+    WorkStealingPool::WorkStealingPool(std::size_t workers) {
+        if (workers == 0U) {
+            workers = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+        }
+        queues_.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        threads_.reserve(workers - 1U);
+        for (std::size_t i = 1; i < workers; ++i) {
+            threads_.emplace_back([this, i] { thread_loop(i); });
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            const std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto &thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void WorkStealingPool::run(std::size_t count, const Task &task) {
+        if (count == 0U) {
+            return;
+        }
+        // Contiguous blocks keep neighbouring items (often similar jobs) on one worker
+        const std::size_t workers = queues_.size();
+        for (std::size_t w = 0; w < workers; ++w) {
+            const std::size_t first = (count * w) / workers;
+            const std::size_t last = (count * (w + 1U)) / workers;
+            const std::lock_guard lock(queues_[w]->mutex);
+            for (std::size_t i = first; i < last; ++i) {
+                queues_[w]->items.push_back(i);
+            }
+        }
+
+        {
+            const std::lock_guard lock(mutex_);
+            task_ = &task;
+            busy_ = threads_.size();
+            ++generation_;
+        }
+        start_.notify_all();
+
+        work(0U, task);
+
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return busy_ == 0U; });
+        task_ = nullptr;
+    }
+
+    void WorkStealingPool::thread_loop(std::size_t worker) {
+        std::uint64_t seen = 0;
+        while (true) {
+            const Task *task = nullptr;
+            {
+                std::unique_lock lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+                task = task_;
+            }
+            work(worker, *task);
+            {
+                const std::lock_guard lock(mutex_);
+                --busy_;
+            }
+            done_.notify_one();
+        }
+    }
+
+    void WorkStealingPool::work(std::size_t worker, const Task &task) {
+        std::size_t index = 0;
+        while (pop_own(worker, index) || steal(worker, index)) {
+            task(index, worker);
+        }
+    }
+
+    auto WorkStealingPool::pop_own(std::size_t worker, std::size_t &index) -> bool {
+        Queue &queue = *queues_[worker];
+        const std::lock_guard lock(queue.mutex);
+        if (queue.items.empty()) {
+            return false;
+        }
+        index = queue.items.front();
+        queue.items.pop_front();
+        return true;
+    }
+
+    auto WorkStealingPool::steal(std::size_t worker, std::size_t &index) -> bool {
+        // Nobody refills queues during a batch, so one empty sweep means we are done
+        const std::size_t workers = queues_.size();
+        for (std::size_t offset = 1; offset < workers; ++offset) {
+            Queue &victim = *queues_[(worker + offset) % workers];
+            const std::lock_guard lock(victim.mutex);
+            if (!victim.items.empty()) {
+                index = victim.items.back();
+                victim.items.pop_back();
+                steals_.fetch_add(1U, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace gba
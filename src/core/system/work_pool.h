@@ -0,0 +1,81 @@
+// src/core/system/work_pool.h
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gba {
+
+    /**
+     * Fixed-size thread pool running indexed batches with work stealing.
+     *
+     * run(count, task) calls task(index, worker) once for every index in
+     * [0, count) and returns when all calls have finished. Indices are dealt out
+     * as contiguous blocks, one per worker queue; a worker drains its own queue
+     * from the front and, once empty, steals from the back of the others, so
+     * uneven jobs (a 10 s ROM next to a 1 s one) still keep every worker busy.
+     *
+     * `worker` is stable in [0, size()) and no two calls with the same worker run
+     * at once, so callers can keep per-worker state (an emulator instance,
+     * scratch buffers) in a plain vector indexed by it.
+     *
+     * Notes
+     * - The calling thread works as worker 0; size() - 1 threads are spawned once
+     *   and sleep between batches.
+     * - One run() at a time (not re-entrant); tasks must not throw.
+     * - Each queue has its own mutex: batches here are tens to thousands of items,
+     *   so a lock per pop costs nothing next to the work it hands out.
+     */
+    class WorkStealingPool {
+      public:
+        using Task = std::function<void(std::size_t index, std::size_t worker)>;
+
+        // 0 = one worker per hardware thread
+        explicit WorkStealingPool(std::size_t workers = 0);
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        auto operator=(const WorkStealingPool &) -> WorkStealingPool & = delete;
+        WorkStealingPool(WorkStealingPool &&) = delete;
+        auto operator=(WorkStealingPool &&) -> WorkStealingPool & = delete;
+        ~WorkStealingPool();
+
+        void run(std::size_t count, const Task &task);
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return queues_.size(); }
+        // Items taken from another worker's queue, since construction
+        [[nodiscard]] auto steals() const noexcept -> std::uint64_t { return steals_.load(std::memory_order_relaxed); }
+
+      private:
+        static constexpr std::size_t kCacheLine = 64;
+
+        struct alignas(kCacheLine) Queue {
+            std::mutex mutex;
+            std::deque<std::size_t> items;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> threads_;
+        std::atomic<std::uint64_t> steals_{0};
+
+        // Batch hand-off, guarded by mutex_
+        std::mutex mutex_;
+        std::condition_variable start_;
+        std::condition_variable done_;
+        const Task *task_ = nullptr;
+        std::uint64_t generation_ = 0;
+        std::size_t busy_ = 0; // spawned workers still inside the current batch
+        bool stop_ = false;
+
+        void thread_loop(std::size_t worker);
+        void work(std::size_t worker, const Task &task);
+        [[nodiscard]] auto pop_own(std::size_t worker, std::size_t &index) -> bool;
+        [[nodiscard]] auto steal(std::size_t worker, std::size_t &index) -> bool;
+    };
+
+} // namespace gba
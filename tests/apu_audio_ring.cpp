@@ -0,0 +1,188 @@
+// tests/apu_audio_ring.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "core/apu/audio_ring.h"
+#include "core/apu/rate_control.h"
+#include "core/apu/resampler.h"
+
+using gba::AudioFrame;
+using gba::AudioRing;
+using gba::DynamicRateControl;
+using gba::Resampler;
+
+namespace {
+    constexpr std::size_t kRingFrames = 4096;
+    constexpr double kNativeRate = 32768.0;
+    constexpr double kHostRate = 48000.0;
+    constexpr double kFrameRate = 59.7275;    // GBA refresh: 16.78 MHz / 280896 cycles
+    constexpr int kSimulatedFrames = 60 * 60; // one emulated minute
+
+    auto frame_of(std::uint32_t value) -> AudioFrame {
+        return AudioFrame{static_cast<std::int16_t>(value & 0x7FFFU),
+                          static_cast<std::int16_t>((value >> 15U) & 0x7FFFU)};
+    }
+
+    // Emulator produces kNativeRate through the resampler; the "device" drains at
+    // kHostRate * clockSkew. Returns the fill ratio at the end and counts xruns.
+    struct DrcRun {
+        double finalFill = 0.0;
+        int underruns = 0;
+        int overruns = 0;
+    };
+    auto simulate_drc(double clockSkew) -> DrcRun {
+        AudioRing ring(kRingFrames);
+        Resampler rs;
+        rs.configure(kNativeRate, kHostRate);
+        DynamicRateControl drc;
+
+        // Pre-fill half the ring as a frontend does before unpausing the device
+        const std::vector<AudioFrame> silence(ring.capacity() / 2U);
+        ring.push(silence);
+
+        DrcRun run{};
+        const std::vector<AudioFrame> native(static_cast<std::size_t>(kNativeRate / kFrameRate) + 1U);
+        std::vector<AudioFrame> host(native.size() * 2U);
+        std::vector<AudioFrame> device(host.size());
+        double nativeCarry = 0.0;
+        double deviceCarry = 0.0;
+        for (int frame = 0; frame < kSimulatedFrames; ++frame) {
+            nativeCarry += kNativeRate / kFrameRate;
+            const auto mixed = static_cast<std::size_t>(nativeCarry);
+            nativeCarry -= static_cast<double>(mixed);
+
+            rs.set_ratio_adjust(drc.update(ring.fill_ratio()));
+            const auto produced = rs.process(std::span(native).first(mixed), host).produced;
+            if (ring.push(std::span(host).first(produced)) != produced) {
+                ++run.overruns;
+            }
+
+            deviceCarry += (kHostRate * clockSkew) / kFrameRate;
+            const auto want = static_cast<std::size_t>(deviceCarry);
+            deviceCarry -= static_cast<double>(want);
+            if (ring.pop(std::span(device).first(want)) != want) {
+                ++run.underruns;
+            }
+        }
+        run.finalFill = ring.fill_ratio();
+        return run;
+    }
+} // namespace
+
+TEST(AudioRing, CapacityRoundsUpToPowerOfTwo) {
+    constexpr std::size_t kOdd = 3000;
+    const AudioRing ring(kOdd);
+    EXPECT_EQ(ring.capacity(), kRingFrames);
+    EXPECT_EQ(ring.size(), 0U);
+}
+
+TEST(AudioRing, PushStopsWhenFullAndPopStopsWhenEmpty) {
+    constexpr std::size_t kSmall = 8;
+    AudioRing ring(kSmall);
+    std::vector<AudioFrame> input(kSmall + 3U);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = frame_of(static_cast<std::uint32_t>(i));
+    }
+    EXPECT_EQ(ring.push(input), kSmall); // excess is rejected, never overwrites
+    EXPECT_DOUBLE_EQ(ring.fill_ratio(), 1.0);
+
+    std::vector<AudioFrame> output(kSmall + 3U);
+    EXPECT_EQ(ring.pop(output), kSmall);
+    EXPECT_EQ(output[kSmall - 1U].left, input[kSmall - 1U].left);
+    EXPECT_EQ(ring.pop(output), 0U);
+}
+
+TEST(AudioRing, WrapsAroundPreservingOrder) {
+    constexpr std::size_t kSmall = 8;
+    constexpr std::size_t kBatch = 5; // not a divisor of the capacity -> exercises wrap
+    constexpr int kRounds = 20;
+    AudioRing ring(kSmall);
+    std::uint32_t next = 0;
+    std::uint32_t expect = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        std::vector<AudioFrame> batch(kBatch);
+        for (auto &frame : batch) {
+            frame = frame_of(next++);
+        }
+        ASSERT_EQ(ring.push(batch), kBatch);
+        std::vector<AudioFrame> out(kBatch);
+        ASSERT_EQ(ring.pop(out), kBatch);
+        for (const auto &frame : out) {
+            EXPECT_EQ(frame.left, frame_of(expect).left);
+            EXPECT_EQ(frame.right, frame_of(expect).right);
+            ++expect;
+        }
+    }
+}
+
+// Emulation thread vs audio callback thread: every frame arrives once, in order.
+TEST(AudioRing, ProducerConsumerThreadsSeeEveryFrameInOrder) {
+    constexpr std::uint32_t kTotal = 1U << 20U;
+    constexpr std::size_t kChunk = 333;
+    AudioRing ring(kRingFrames);
+
+    std::thread producer([&ring] {
+        std::vector<AudioFrame> chunk(kChunk);
+        std::uint32_t next = 0;
+        while (next < kTotal) {
+            std::size_t count = 0;
+            while (count < kChunk && next + count < kTotal) {
+                chunk[count] = frame_of(next + static_cast<std::uint32_t>(count));
+                ++count;
+            }
+            std::size_t sent = 0;
+            while (sent < count) {
+                sent += ring.push(std::span(chunk).subspan(sent, count - sent));
+            }
+            next += static_cast<std::uint32_t>(count);
+        }
+    });
+
+    std::vector<AudioFrame> out(kChunk);
+    std::uint32_t expect = 0;
+    bool inOrder = true;
+    while (expect < kTotal) {
+        const std::size_t got = ring.pop(out);
+        for (std::size_t i = 0; i < got; ++i) {
+            const auto want = frame_of(expect++);
+            inOrder = inOrder && out[i].left == want.left && out[i].right == want.right;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(ring.size(), 0U);
+}
+
+TEST(DynamicRateControl, AdjustIsBoundedAndSignedByFill) {
+    DynamicRateControl drc;
+    double adjust = 1.0;
+    for (int i = 0; i < 100; ++i) {
+        adjust = drc.update(1.0); // ring full -> consume input faster, emit fewer frames
+    }
+    EXPECT_GT(adjust, 1.0);
+    EXPECT_LE(adjust, 1.0 + DynamicRateControl::kMaxDelta);
+
+    drc.reset();
+    for (int i = 0; i < 100; ++i) {
+        adjust = drc.update(0.0);
+    }
+    EXPECT_LT(adjust, 1.0);
+    EXPECT_GE(adjust, 1.0 - DynamicRateControl::kMaxDelta);
+}
+
+// The device clock runs 0.25% fast/slow relative to the emulator: without control
+// the ring drains/fills within seconds; with it the fill settles and never xruns.
+TEST(DynamicRateControl, KeepsRingAwayFromXrunsUnderClockSkew) {
+    constexpr double kFastDevice = 1.0025;
+    constexpr double kSlowDevice = 0.9975;
+    constexpr double kMinFill = 0.1;
+    constexpr double kMaxFill = 0.9;
+    for (const double skew : {1.0, kFastDevice, kSlowDevice}) {
+        const auto run = simulate_drc(skew);
+        EXPECT_EQ(run.underruns, 0) << "skew " << skew;
+        EXPECT_EQ(run.overruns, 0) << "skew " << skew;
+        EXPECT_GT(run.finalFill, kMinFill) << "skew " << skew;
+        EXPECT_LT(run.finalFill, kMaxFill) << "skew " << skew;
+    }
+}
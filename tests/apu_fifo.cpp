@@ -0,0 +1,163 @@
+// tests/apu_fifo.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "core/apu/apu.h"
+#include "core/mmu/mmu.h"
+
+using gba::APU;
+using gba::AudioMode;
+using gba::MMU;
+
+namespace {
+    constexpr std::uint32_t kFifoA = MMU::IO_BASE + APU::kOffFIFO_A;
+    constexpr std::uint32_t kFifoB = MMU::IO_BASE + APU::kOffFIFO_B;
+    constexpr std::uint32_t kSoundCntH = MMU::IO_BASE + APU::kOffSOUNDCNT_H;
+    constexpr std::uint32_t kSoundCntX = MMU::IO_BASE + APU::kOffSOUNDCNT_X;
+    constexpr std::uint32_t kSoundBias = MMU::IO_BASE + APU::kOffSOUNDBIAS;
+
+    constexpr std::uint32_t kSamples0123 = 0x03020100U; // bytes pop in address order: 0, 1, 2, 3
+    constexpr std::uint32_t kFifoWords = APU::kFifoBytes / 4U;
+    constexpr std::uint32_t kTimer0 = 0U;
+    constexpr std::uint32_t kTimer1 = 1U;
+
+    // FIFO A on timer 0 (both sides, 100%), FIFO B on timer 1 (both sides, 100%)
+    constexpr std::uint16_t kCntHBothFifos =
+        APU::kCntHVolumeA | APU::kCntHVolumeB | APU::kCntHRightA | APU::kCntHLeftA | APU::kCntHRightB |
+        APU::kCntHLeftB | APU::kCntHTimerB;
+
+    constexpr std::uint32_t kCyclesPerFrame = 280896U;
+
+    void enable_direct_sound(MMU &mmu) {
+        mmu.write16(kSoundCntX, APU::kCntXMasterEnable);
+        mmu.write16(kSoundCntH, kCntHBothFifos);
+    }
+
+    void fill_fifo(MMU &mmu, std::uint32_t fifoAddr) {
+        for (std::uint32_t i = 0; i < kFifoWords; ++i) {
+            mmu.write32(fifoAddr, kSamples0123 + (i * 0x04040404U));
+        }
+    }
+} // namespace
+
+TEST(APUFifo, WordWritesQueueFourSamplesEach) {
+    MMU mmu;
+    mmu.reset();
+    mmu.write32(kFifoA, kSamples0123);
+    EXPECT_EQ(mmu.apu().fifo_size(0), 4U);
+    mmu.write32(kFifoB, kSamples0123);
+    mmu.write32(kFifoB, kSamples0123);
+    EXPECT_EQ(mmu.apu().fifo_size(1), 8U);
+}
+
+TEST(APUFifo, TimerOverflowPopsInOrderIntoLatch) {
+    MMU mmu;
+    mmu.reset();
+    enable_direct_sound(mmu);
+    mmu.write32(kFifoA, kSamples0123);
+
+    for (std::int8_t expected = 0; expected < 4; ++expected) {
+        mmu.apu().on_timer_overflow(kTimer0);
+        EXPECT_EQ(mmu.apu().fifo_latched(0), expected);
+    }
+    // Underflow keeps the last sample on the DAC
+    mmu.apu().on_timer_overflow(kTimer0);
+    EXPECT_EQ(mmu.apu().fifo_latched(0), 3);
+}
+
+// GBATEK: SOUNDCNT_H bit 10/14 bind FIFO A/B to timer 0 or 1
+TEST(APUFifo, TimerSelectRoutesOverflowsPerFifo) {
+    MMU mmu;
+    mmu.reset();
+    enable_direct_sound(mmu);
+    fill_fifo(mmu, kFifoA);
+    fill_fifo(mmu, kFifoB);
+
+    mmu.apu().on_timer_overflow(kTimer1);
+    EXPECT_EQ(mmu.apu().fifo_size(0), APU::kFifoBytes);
+    EXPECT_EQ(mmu.apu().fifo_size(1), APU::kFifoBytes - 1U);
+}
+
+TEST(APUFifo, DmaRequestRaisedAtHalfFull) {
+    MMU mmu;
+    mmu.reset();
+    enable_direct_sound(mmu);
+    fill_fifo(mmu, kFifoA);
+
+    const auto popsUntilThreshold = APU::kFifoBytes - APU::kFifoDmaThreshold;
+    for (std::size_t i = 0; i + 1U < popsUntilThreshold; ++i) {
+        mmu.apu().on_timer_overflow(kTimer0);
+        EXPECT_EQ(mmu.apu().take_dma_requests(), 0U);
+    }
+    mmu.apu().on_timer_overflow(kTimer0); // 16 bytes left
+    EXPECT_EQ(mmu.apu().take_dma_requests(), APU::kDmaRequestA);
+    EXPECT_EQ(mmu.apu().take_dma_requests(), 0U); // taking clears
+}
+
+TEST(APUFifo, ResetStrobeEmptiesFifoAndReadsBackZero) {
+    MMU mmu;
+    mmu.reset();
+    enable_direct_sound(mmu);
+    fill_fifo(mmu, kFifoA);
+
+    mmu.write16(kSoundCntH, static_cast<std::uint16_t>(kCntHBothFifos | APU::kCntHResetA));
+    EXPECT_EQ(mmu.apu().fifo_size(0), 0U);
+    EXPECT_EQ(mmu.read16(kSoundCntH), kCntHBothFifos);
+}
+
+TEST(APUFifo, SoundBiasSelectsSampleRate) {
+    constexpr std::uint16_t kBias256K = APU::kBiasResetValue | (3U << APU::kBiasResolutionShift);
+    constexpr std::uint32_t kRate256K = 262144U;
+    MMU mmu;
+    mmu.reset();
+    EXPECT_EQ(mmu.apu().sample_rate(), APU::kBaseSampleHz);
+    mmu.write16(kSoundBias, kBias256K);
+    EXPECT_EQ(mmu.apu().sample_rate(), kRate256K);
+}
+
+TEST(APUMixer, FullModeProducesHostRateFrames) {
+    constexpr double kFrameRate = static_cast<double>(APU::kCpuHz) / kCyclesPerFrame;
+    constexpr double kHostRate = 48000.0;
+    MMU mmu;
+    mmu.reset();
+    enable_direct_sound(mmu);
+
+    mmu.apu().advance(kCyclesPerFrame);
+    mmu.apu().end_frame();
+    // One frame of audio at 48 kHz, minus the few frames still in the filter's window
+    EXPECT_NEAR(static_cast<double>(mmu.apu().output().size()), kHostRate / kFrameRate, 4.0);
+}
+
+// Headless farms: identical FIFO levels, latches and DMA requests, but no output.
+TEST(APUMixer, TimingOnlyModeMatchesFullModeStateWithoutOutput) {
+    constexpr int kOverflows = 200;
+    constexpr std::uint32_t kCyclesPerOverflow = 512U;
+    MMU full;
+    MMU timing;
+    full.reset();
+    timing.reset();
+    timing.apu().set_mode(AudioMode::TimingOnly);
+
+    for (MMU *mmu : {&full, &timing}) {
+        enable_direct_sound(*mmu);
+        fill_fifo(*mmu, kFifoA);
+    }
+
+    for (int i = 0; i < kOverflows; ++i) {
+        for (MMU *mmu : {&full, &timing}) {
+            mmu->apu().on_timer_overflow(kTimer0);
+            mmu->apu().advance(kCyclesPerOverflow);
+            if (mmu->apu().take_dma_requests() != 0U) {
+                mmu->write32(kFifoA, kSamples0123); // what the sound DMA would do
+                mmu->write32(kFifoA, kSamples0123);
+                mmu->write32(kFifoA, kSamples0123);
+                mmu->write32(kFifoA, kSamples0123);
+            }
+        }
+        ASSERT_EQ(full.apu().fifo_size(0), timing.apu().fifo_size(0));
+        ASSERT_EQ(full.apu().fifo_latched(0), timing.apu().fifo_latched(0));
+    }
+    full.apu().end_frame();
+    timing.apu().end_frame();
+    EXPECT_GT(full.apu().output().size(), 0U);
+    EXPECT_EQ(timing.apu().output().size(), 0U);
+}
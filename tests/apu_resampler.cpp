@@ -0,0 +1,206 @@
+// tests/apu_resampler.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+#include "core/apu/resampler.h"
+
+using gba::AudioFrame;
+using gba::Resampler;
+
+namespace {
+    // SOUNDBIAS sample rates (bits 14-15 select 32/64/128/256 KiHz)
+    constexpr double kRate32K = 32768.0;
+    constexpr double kRate256K = 262144.0;
+    constexpr double kHost48K = 48000.0;
+    constexpr double kHost44K = 44100.0;
+
+    constexpr double kAmplitude = 16000.0; // ~ -6 dBFS, leaves headroom for ripple
+    constexpr double kSecondsPerTone = 0.25;
+    constexpr std::size_t kWarmupOutputs = 512; // skip the filter's start-up transient
+    constexpr double kMinPassbandSnrDb = 60.0;
+    constexpr double kMinStopbandRejectDb = 50.0;
+    constexpr double kPassbandEdge = 0.4; // fraction of the lower sample rate
+    constexpr int kSweepSteps = 24;       // stepped sine sweep resolution
+
+    auto make_tone(double freqHz, double rateHz, double seconds) -> std::vector<AudioFrame> {
+        const auto count = static_cast<std::size_t>(rateHz * seconds);
+        std::vector<AudioFrame> frames(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const double phase = 2.0 * std::numbers::pi * freqHz * static_cast<double>(i) / rateHz;
+            const auto sample = static_cast<std::int16_t>(std::lrint(kAmplitude * std::sin(phase)));
+            frames[i] = AudioFrame{sample, sample};
+        }
+        return frames;
+    }
+
+    auto resample_all(Resampler &rs, const std::vector<AudioFrame> &input) -> std::vector<AudioFrame> {
+        std::vector<AudioFrame> output(input.size() * 8U + 16U);
+        const auto result = rs.process(input, output);
+        EXPECT_EQ(result.consumed, input.size());
+        output.resize(result.produced);
+        return output;
+    }
+
+    // Least-squares fit of a*sin + b*cos + c at the known frequency; returns the power of the
+    // fitted sinusoid against everything else (noise, aliasing, distortion) in dB.
+    auto tone_snr_db(const std::vector<AudioFrame> &out, double freqHz, double rateHz) -> double {
+        // Normal equations M * [a b c]^T = v, accumulated over the steady-state outputs
+        std::array<std::array<double, 3>, 3> normal{};
+        std::array<double, 3> rhs{};
+        for (std::size_t i = kWarmupOutputs; i < out.size(); ++i) {
+            const double angle = 2.0 * std::numbers::pi * freqHz * static_cast<double>(i) / rateHz;
+            const std::array<double, 3> basis{std::sin(angle), std::cos(angle), 1.0};
+            for (std::size_t row = 0; row < 3; ++row) {
+                for (std::size_t col = 0; col < 3; ++col) {
+                    normal[row][col] += basis[row] * basis[col];
+                }
+                rhs[row] += basis[row] * out[i].left;
+            }
+        }
+
+        // Cramer's rule: swap one column of M for v at a time
+        const auto det3 = [](const std::array<std::array<double, 3>, 3> &mat) {
+            return (mat[0][0] * ((mat[1][1] * mat[2][2]) - (mat[1][2] * mat[2][1]))) -
+                   (mat[0][1] * ((mat[1][0] * mat[2][2]) - (mat[1][2] * mat[2][0]))) +
+                   (mat[0][2] * ((mat[1][0] * mat[2][1]) - (mat[1][1] * mat[2][0])));
+        };
+        const double det = det3(normal);
+        std::array<double, 3> coeffs{};
+        for (std::size_t col = 0; col < 3; ++col) {
+            auto swapped = normal;
+            for (std::size_t row = 0; row < 3; ++row) {
+                swapped[row][col] = rhs[row];
+            }
+            coeffs[col] = det3(swapped) / det;
+        }
+
+        double signal = 0.0;
+        double residual = 0.0;
+        for (std::size_t i = kWarmupOutputs; i < out.size(); ++i) {
+            const double angle = 2.0 * std::numbers::pi * freqHz * static_cast<double>(i) / rateHz;
+            const double fit = (coeffs[0] * std::sin(angle)) + (coeffs[1] * std::cos(angle)) + coeffs[2];
+            const double error = out[i].left - fit;
+            signal += fit * fit;
+            residual += error * error;
+        }
+        return 10.0 * std::log10(signal / residual);
+    }
+
+    auto rms(const std::vector<AudioFrame> &out) -> double {
+        double acc = 0.0;
+        for (std::size_t i = kWarmupOutputs; i < out.size(); ++i) {
+            acc += static_cast<double>(out[i].left) * out[i].left;
+        }
+        return std::sqrt(acc / static_cast<double>(out.size() - kWarmupOutputs));
+    }
+
+    void expect_clean_sweep(double inputHz, double outputHz) {
+        const double edge = kPassbandEdge * std::min(inputHz, outputHz);
+        for (int step = 1; step <= kSweepSteps; ++step) {
+            const double freq = edge * static_cast<double>(step) / kSweepSteps;
+            Resampler rs;
+            rs.configure(inputHz, outputHz);
+            const auto out = resample_all(rs, make_tone(freq, inputHz, kSecondsPerTone));
+            EXPECT_GT(tone_snr_db(out, freq, outputHz), kMinPassbandSnrDb)
+                << inputHz << " Hz -> " << outputHz << " Hz at " << freq << " Hz";
+        }
+    }
+} // namespace
+
+TEST(Resampler, DcPassesAtUnityGain) {
+    constexpr std::int16_t kDc = 12345;
+    Resampler rs;
+    rs.configure(kRate32K, kHost48K);
+    const std::vector<AudioFrame> input(4096, AudioFrame{kDc, static_cast<std::int16_t>(-kDc)});
+    const auto out = resample_all(rs, input);
+    ASSERT_GT(out.size(), kWarmupOutputs);
+    EXPECT_NEAR(out.back().left, kDc, 1);
+    EXPECT_NEAR(out.back().right, -kDc, 1);
+}
+
+// Stepped sine sweep across the passband: every tone must come out clean.
+TEST(Resampler, SineSweepUpsampling32KTo48K) { expect_clean_sweep(kRate32K, kHost48K); }
+TEST(Resampler, SineSweepDownsampling256KTo48K) { expect_clean_sweep(kRate256K, kHost48K); }
+TEST(Resampler, SineSweepDownsampling256KTo44K) { expect_clean_sweep(kRate256K, kHost44K); }
+
+// A tone above the host Nyquist must be filtered, not folded back as an alias.
+TEST(Resampler, RejectsToneAboveOutputNyquist) {
+    constexpr double kAliasingTone = 40000.0;
+    Resampler rs;
+    rs.configure(kRate256K, kHost48K);
+    const auto out = resample_all(rs, make_tone(kAliasingTone, kRate256K, kSecondsPerTone));
+    const double rejectDb = 20.0 * std::log10((kAmplitude / std::numbers::sqrt2) / std::max(rms(out), 1e-9));
+    EXPECT_GT(rejectDb, kMinStopbandRejectDb);
+}
+
+TEST(Resampler, TapCountGrowsWithDownsamplingRatio) {
+    Resampler rs;
+    rs.configure(kRate32K, kHost48K);
+    EXPECT_EQ(rs.taps(), Resampler::kBaseTaps);
+    rs.configure(kRate256K, kHost48K);
+    EXPECT_GT(rs.taps(), Resampler::kBaseTaps);
+    EXPECT_LE(rs.taps(), Resampler::kMaxTaps);
+    EXPECT_EQ(rs.taps() % Resampler::kTapAlign, 0U);
+}
+
+// Copies (forks) share the bank; reconfiguring one gives it a bank of its own.
+TEST(Resampler, ReconfiguredCopyLeavesTheOriginalsBankAlone) {
+    Resampler original;
+    original.configure(kRate32K, kHost48K);
+    Resampler copy = original;
+    copy.configure(kRate256K, kHost48K);
+    EXPECT_GT(copy.taps(), original.taps());
+
+    Resampler fresh;
+    fresh.configure(kRate32K, kHost48K);
+    const auto tone = make_tone(kHost48K / 8.0, kRate32K, kSecondsPerTone);
+    const auto expected = resample_all(fresh, tone);
+    const auto out = resample_all(original, tone);
+    ASSERT_EQ(out.size(), expected.size());
+    EXPECT_TRUE(std::ranges::equal(out, expected, [](const AudioFrame &a, const AudioFrame &b) {
+        return a.left == b.left && a.right == b.right;
+    }));
+}
+
+// Dynamic rate control: the output count follows the adjusted ratio.
+TEST(Resampler, RatioAdjustScalesOutputCount) {
+    constexpr double kAdjust = 1.005; // consume 0.5% faster -> 0.5% fewer outputs
+    constexpr std::size_t kInputFrames = 32768;
+    const std::vector<AudioFrame> input(kInputFrames);
+
+    Resampler nominal;
+    nominal.configure(kRate32K, kHost48K);
+    const auto base = resample_all(nominal, input).size();
+
+    Resampler adjusted;
+    adjusted.configure(kRate32K, kHost48K);
+    adjusted.set_ratio_adjust(kAdjust);
+    const auto nudged = resample_all(adjusted, input).size();
+
+    EXPECT_NEAR(static_cast<double>(nudged), static_cast<double>(base) / kAdjust, 2.0);
+}
+
+// A full output span stops consumption; the remainder resumes without loss.
+TEST(Resampler, ResumesWhenOutputSpanIsFull) {
+    constexpr std::size_t kInputFrames = 1000;
+    constexpr std::size_t kSmallChunk = 7;
+    const std::vector<AudioFrame> input(kInputFrames, AudioFrame{1000, 1000});
+
+    Resampler whole;
+    const auto expected = resample_all(whole, input).size();
+
+    Resampler chunked;
+    std::vector<AudioFrame> chunk(kSmallChunk);
+    std::size_t consumed = 0;
+    std::size_t produced = 0;
+    while (consumed < input.size()) {
+        const auto result = chunked.process(std::span(input).subspan(consumed), chunk);
+        consumed += result.consumed;
+        produced += result.produced;
+    }
+    EXPECT_EQ(produced + chunked.process({}, chunk).produced, expected);
+}
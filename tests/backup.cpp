@@ -0,0 +1,315 @@
+// tests/backup.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "core/backup/backup.h"
+#include "core/bus/bus.h"
+#include "core/mmu/mmu.h"
+#include "core/system/system.h"
+
+using gba::Backup;
+using gba::BackupType;
+using gba::Bus;
+using gba::MMU;
+using gba::System;
+
+namespace {
+    constexpr std::uint32_t kFlashCmd1 = MMU::SRAM_BASE + Backup::kFlashCmd1;
+    constexpr std::uint32_t kFlashCmd2 = MMU::SRAM_BASE + Backup::kFlashCmd2;
+    constexpr std::chrono::milliseconds kFastIdle{5};
+    constexpr std::chrono::seconds kFlushTimeout{5};
+
+    auto rom_with(std::string_view id) -> std::vector<std::uint8_t> {
+        std::vector<std::uint8_t> rom(0x400U, 0x00U);
+        std::copy(id.begin(), id.end(), rom.begin() + 0x200);
+        return rom;
+    }
+
+    void flash_command(Bus &bus, std::uint8_t command) {
+        bus.write8(kFlashCmd1, 0xAAU);
+        bus.write8(kFlashCmd2, 0x55U);
+        bus.write8(kFlashCmd1, command);
+    }
+
+    // One EEPROM request, bit by bit, as DMA3 would send it
+    void eeprom_send(Bus &bus, std::uint64_t bits, std::size_t count) {
+        for (std::size_t i = count; i > 0U; --i) {
+            bus.write16(MMU::EEPROM_BASE, static_cast<std::uint16_t>((bits >> (i - 1U)) & 1U));
+        }
+    }
+    auto eeprom_read_block(Bus &bus, std::uint64_t block, std::size_t addressBits) -> std::uint64_t {
+        eeprom_send(bus, (0b11ULL << (addressBits + 1U)) | (block << 1U), 2U + addressBits + 1U);
+        std::uint64_t value = 0;
+        for (std::uint32_t i = 0; i < Backup::kEepromReadBits; ++i) {
+            const std::uint16_t bit = bus.read16(MMU::EEPROM_BASE);
+            if (i < 4U) {
+                EXPECT_EQ(bit, 0U);
+            } else {
+                value = (value << 1U) | bit;
+            }
+        }
+        return value;
+    }
+    void eeprom_write_block(Bus &bus, std::uint64_t block, std::size_t addressBits, std::uint64_t data) {
+        eeprom_send(bus, 0b10U, 2U);
+        eeprom_send(bus, block, addressBits);
+        eeprom_send(bus, data, Backup::kEepromBlockBits);
+        eeprom_send(bus, 0U, 1U);
+    }
+
+    // A scratch save file removed on both ends of a test
+    class SaveFile {
+      public:
+        explicit SaveFile(const std::string &name)
+            : path_(std::filesystem::temp_directory_path() / ("gba_backup_test_" + name + ".sav")) {
+            std::filesystem::remove(path_);
+        }
+        SaveFile(const SaveFile &) = delete;
+        auto operator=(const SaveFile &) -> SaveFile & = delete;
+        SaveFile(SaveFile &&) = delete;
+        auto operator=(SaveFile &&) -> SaveFile & = delete;
+        ~SaveFile() { std::filesystem::remove(path_); }
+
+        [[nodiscard]] auto path() const -> const std::filesystem::path & { return path_; }
+        [[nodiscard]] auto bytes() const -> std::vector<std::uint8_t> {
+            std::ifstream in(path_, std::ios::binary);
+            return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        }
+
+      private:
+        std::filesystem::path path_;
+    };
+} // namespace
+
+TEST(Backup, DetectsTypeFromLibraryString) {
+    EXPECT_EQ(gba::detect_backup_type(rom_with("SRAM_V113")), BackupType::SRAM);
+    EXPECT_EQ(gba::detect_backup_type(rom_with("FLASH_V126")), BackupType::Flash64K);
+    EXPECT_EQ(gba::detect_backup_type(rom_with("FLASH512_V131")), BackupType::Flash64K);
+    EXPECT_EQ(gba::detect_backup_type(rom_with("FLASH1M_V103")), BackupType::Flash128K);
+    EXPECT_EQ(gba::detect_backup_type(rom_with("EEPROM_V124")), BackupType::EEPROM);
+    EXPECT_EQ(gba::detect_backup_type(rom_with("NOTHING")), BackupType::None);
+}
+
+TEST(Backup, SramIsAnEightBitMirroredWindow) {
+    Bus bus;
+    bus.reset();
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE), MMU::kOpenBus); // no backup without a GamePak
+    bus.load_gamepak(rom_with("SRAM_V113"));
+
+    bus.write8(MMU::SRAM_BASE + 0x10U, 0x5AU);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x10U), 0x5AU);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x8010U), 0x5AU); // 32 KiB mirror
+    EXPECT_EQ(bus.read16(MMU::SRAM_BASE + 0x10U), 0x5A5AU);
+    EXPECT_EQ(bus.read32(MMU::SRAM_BASE + 0x10U), 0x5A5A5A5AU);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x11U), Backup::kErased);
+
+    bus.write16(MMU::SRAM_BASE + 0x21U, 0x1234U); // odd address takes the high byte lane
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x21U), 0x12U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x22U), Backup::kErased);
+}
+
+TEST(Backup, FlashIdProgramAndErase) {
+    Bus bus;
+    bus.reset();
+    bus.load_gamepak(rom_with("FLASH1M_V103"));
+
+    flash_command(bus, 0x90U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE), Backup::kFlash128KId[0]);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 1U), Backup::kFlash128KId[1]);
+    flash_command(bus, 0xF0U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE), Backup::kErased);
+
+    // A plain write does nothing; a programmed byte sticks
+    bus.write8(MMU::SRAM_BASE + 0x1234U, 0x00U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x1234U), Backup::kErased);
+    flash_command(bus, 0xA0U);
+    bus.write8(MMU::SRAM_BASE + 0x1234U, 0x42U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x1234U), 0x42U);
+
+    // Bank 1 is a separate 64 KiB
+    flash_command(bus, 0xB0U);
+    bus.write8(MMU::SRAM_BASE, 1U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x1234U), Backup::kErased);
+    flash_command(bus, 0xA0U);
+    bus.write8(MMU::SRAM_BASE + 0x1234U, 0x43U);
+    EXPECT_EQ(bus.backup().contents()[Backup::kFlashBankBytes + 0x1234U], 0x43U);
+
+    // Sector erase clears one 4 KiB sector of the current bank
+    flash_command(bus, 0xB0U);
+    bus.write8(MMU::SRAM_BASE, 0U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x1234U), 0x42U);
+    flash_command(bus, 0x80U);
+    bus.write8(kFlashCmd1, 0xAAU);
+    bus.write8(kFlashCmd2, 0x55U);
+    bus.write8(MMU::SRAM_BASE + 0x1000U, 0x30U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 0x1234U), Backup::kErased);
+    EXPECT_EQ(bus.backup().contents()[Backup::kFlashBankBytes + 0x1234U], 0x43U);
+
+    // Chip erase clears both banks
+    flash_command(bus, 0xA0U);
+    bus.write8(MMU::SRAM_BASE, 0x99U);
+    flash_command(bus, 0x80U);
+    flash_command(bus, 0x10U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE), Backup::kErased);
+    EXPECT_EQ(bus.backup().contents()[Backup::kFlashBankBytes + 0x1234U], Backup::kErased);
+}
+
+TEST(Backup, EepromSerialReadAndWrite) {
+    constexpr std::size_t kAddressBits = 14U;
+    constexpr std::uint64_t kData = 0x0123456789ABCDEFULL;
+    Bus bus;
+    bus.reset();
+    bus.load_gamepak(rom_with("EEPROM_V124"));
+
+    EXPECT_EQ(eeprom_read_block(bus, 3U, kAddressBits), ~0ULL);
+    eeprom_write_block(bus, 3U, kAddressBits, kData);
+    EXPECT_EQ(bus.read16(MMU::EEPROM_BASE), 1U); // ready
+    EXPECT_EQ(eeprom_read_block(bus, 3U, kAddressBits), kData);
+    EXPECT_EQ(eeprom_read_block(bus, 4U, kAddressBits), ~0ULL);
+    EXPECT_EQ(bus.backup().contents()[3U * 8U], 0x01U); // stored MSB first
+
+    // Plain ROM reads elsewhere in WS2 are unaffected
+    EXPECT_EQ(bus.read8(MMU::WS2_BASE), 0x00U);
+}
+
+TEST(Backup, FileIsMappedAndFlushedInTheBackground) {
+    const SaveFile save("flush");
+    {
+        Bus bus;
+        bus.reset();
+        bus.load_gamepak(rom_with("SRAM_V113"));
+        ASSERT_TRUE(bus.backup().attach_file(save.path(), kFastIdle));
+        EXPECT_EQ(save.bytes().size(), gba::backup_size(BackupType::SRAM));
+        EXPECT_EQ(save.bytes()[0], Backup::kErased); // new file starts erased
+
+        bus.write8(MMU::SRAM_BASE + 7U, 0x77U);
+        EXPECT_EQ(save.bytes()[7], 0x77U); // write went straight to the page cache
+
+        // The flusher syncs once the game goes idle, without being asked
+        const auto deadline = std::chrono::steady_clock::now() + kFlushTimeout;
+        while (bus.backup().file()->flush_count() == 0U && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(kFastIdle);
+        }
+        EXPECT_GE(bus.backup().file()->flush_count(), 1U);
+        bus.write8(MMU::SRAM_BASE + 8U, 0x88U);
+    } // unload syncs the rest
+
+    Bus bus;
+    bus.reset();
+    bus.load_gamepak(rom_with("SRAM_V113"));
+    ASSERT_TRUE(bus.backup().attach_file(save.path()));
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 7U), 0x77U);
+    EXPECT_EQ(bus.read8(MMU::SRAM_BASE + 8U), 0x88U);
+}
+
+TEST(Backup, EepromSizeIsSettledByTheFirstRequest) {
+    constexpr std::size_t kSmallAddressBits = 6U;
+    constexpr std::size_t kLargeAddressBits = 14U;
+    constexpr std::uint64_t kData = 0x0011223344556677ULL;
+
+    // First boot of a 4 Kbit game, no save file: a 9-bit read request makes it EEPROM512
+    Bus small;
+    small.reset();
+    small.load_gamepak(rom_with("EEPROM_V124"));
+    EXPECT_EQ(small.backup().type(), BackupType::EEPROM);
+    EXPECT_EQ(eeprom_read_block(small, 1U, kSmallAddressBits), ~0ULL);
+    EXPECT_EQ(small.backup().type(), BackupType::EEPROM512);
+    eeprom_write_block(small, 63U, kSmallAddressBits, kData);
+    EXPECT_EQ(small.read16(MMU::EEPROM_BASE), 1U);
+    EXPECT_EQ(eeprom_read_block(small, 63U, kSmallAddressBits), kData);
+    EXPECT_EQ(small.backup().contents()[63U * 8U], 0x00U); // block 63 is the last 8 bytes of 512
+    EXPECT_EQ(small.backup().contents()[(63U * 8U) + 7U], 0x77U);
+
+    // A 73-bit write settles the small chip too, once the game polls for ready
+    Bus writer;
+    writer.reset();
+    writer.load_gamepak(rom_with("EEPROM_V124"));
+    eeprom_write_block(writer, 2U, kSmallAddressBits, kData);
+    EXPECT_EQ(writer.read16(MMU::EEPROM_BASE), 1U);
+    EXPECT_EQ(writer.backup().type(), BackupType::EEPROM512);
+    EXPECT_EQ(writer.backup().contents()[(2U * 8U) + 7U], 0x77U);
+
+    // An 81-bit write can only be the large chip: settled as soon as it is complete
+    Bus large;
+    large.reset();
+    large.load_gamepak(rom_with("EEPROM_V124"));
+    eeprom_write_block(large, 1000U, kLargeAddressBits, kData);
+    EXPECT_EQ(large.backup().type(), BackupType::EEPROM8K);
+    EXPECT_EQ(eeprom_read_block(large, 1000U, kLargeAddressBits), kData);
+}
+
+TEST(Backup, EepromSaveFileKeepsSmallChipData) {
+    const SaveFile save("eeprom512");
+    {
+        std::ofstream out(save.path(), std::ios::binary);
+        std::vector<char> image(gba::backup_size(BackupType::EEPROM512), '\x00');
+        image[8] = '\x5A'; // block 1, first byte
+        out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    }
+    Bus bus;
+    bus.reset();
+    bus.load_gamepak(rom_with("EEPROM_V124"));
+    ASSERT_TRUE(bus.backup().attach_file(save.path()));
+    EXPECT_EQ(eeprom_read_block(bus, 1U, 6U), 0x5A00000000000000ULL);
+    EXPECT_EQ(bus.backup().type(), BackupType::EEPROM512);
+}
+
+TEST(Backup, ResetAndRestoreReleaseTheFileWithoutWaiting) {
+    const SaveFile save("release");
+    System sys;
+    sys.reset();
+    sys.load_gamepak(rom_with("SRAM_V113"));
+    ASSERT_TRUE(sys.bus().backup().attach_file(save.path()));
+    sys.bus().write8(MMU::SRAM_BASE + 3U, 0x33U);
+
+    sys.soft_reset(); // the final sync is left to the flusher thread
+    EXPECT_EQ(sys.bus().backup().file(), nullptr);
+    EXPECT_EQ(sys.bus().read8(MMU::SRAM_BASE + 3U), Backup::kErased);
+    EXPECT_EQ(save.bytes()[3], 0x33U);
+
+    ASSERT_TRUE(sys.bus().backup().attach_file(save.path()));
+    EXPECT_EQ(sys.bus().read8(MMU::SRAM_BASE + 3U), 0x33U);
+    const auto snapshot = sys.fork();
+    sys.restore(*snapshot);
+    EXPECT_EQ(sys.bus().backup().file(), nullptr);
+    EXPECT_EQ(sys.bus().read8(MMU::SRAM_BASE + 3U), 0x33U);
+}
+
+TEST(Backup, AsyncCloseKeepsEveryWrite) {
+    const SaveFile save("close_async");
+    for (std::uint8_t round = 0; round < 32U; ++round) {
+        auto file = gba::MappedFile::open(save.path(), gba::backup_size(BackupType::SRAM), Backup::kErased, kFastIdle);
+        ASSERT_NE(file, nullptr);
+        if (round > 0U) {
+            ASSERT_EQ(file->bytes()[round - 1U], round - 1U);
+        }
+        file->bytes()[round] = round;
+        file->note_write();
+        gba::MappedFile::close_async(std::move(file));
+    }
+}
+
+TEST(Backup, ForkedChildDoesNotWriteTheFile) {
+    const SaveFile save("fork");
+    System parent;
+    parent.reset();
+    parent.load_gamepak(rom_with("SRAM_V113"));
+    ASSERT_TRUE(parent.bus().backup().attach_file(save.path()));
+    parent.bus().write8(MMU::SRAM_BASE, 0x11U);
+
+    const auto child = parent.fork();
+    EXPECT_EQ(child->bus().backup().file(), nullptr);
+    EXPECT_EQ(child->bus().read8(MMU::SRAM_BASE), 0x11U);
+    child->bus().write8(MMU::SRAM_BASE, 0x22U);
+    EXPECT_EQ(parent.bus().read8(MMU::SRAM_BASE), 0x11U);
+    EXPECT_EQ(save.bytes()[0], 0x11U);
+}
@@ -0,0 +1,200 @@
+// tests/batch.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/backup/backup.h"
+#include "core/mmu/mmu.h"
+#include "core/system/batch.h"
+#include "core/system/headless.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::BatchJob;
+using gba::BatchRunner;
+using gba::BatchSummary;
+using gba::HeadlessConfig;
+using gba::HeadlessResult;
+using gba::InputScript;
+using gba::MMU;
+using gba::System;
+using gba::test::counting_key_echo_program;
+
+namespace {
+    // Position independent, so it runs straight from the GamePak
+    constexpr auto kKeyEchoProgram = counting_key_echo_program();
+    constexpr std::size_t kRomBytes = 256U;
+    constexpr std::uint64_t kFrames = 6U;
+    constexpr std::size_t kWorkers = 2U;
+
+    auto key_echo_rom(std::string_view libraryString = {}) -> std::vector<std::uint8_t> {
+        std::vector<std::uint8_t> rom(kRomBytes, 0U);
+        for (std::size_t i = 0; i < kKeyEchoProgram.size(); ++i) {
+            rom[i * 2U] = static_cast<std::uint8_t>(kKeyEchoProgram[i] & 0xFFU);
+            rom[(i * 2U) + 1U] = static_cast<std::uint8_t>(kKeyEchoProgram[i] >> 8U);
+        }
+        std::ranges::copy(libraryString, rom.begin() + static_cast<std::ptrdiff_t>(kRomBytes / 2U));
+        return rom;
+    }
+
+    // Per-test name, so tests running in parallel (ctest -j) never share a scratch directory
+    auto scratch_name() -> std::string {
+        const auto *test = ::testing::UnitTest::GetInstance()->current_test_info();
+        return std::string("gba_batch_test_") + test->test_suite_name() + "_" + test->name();
+    }
+
+    // Scratch directory with ROMs and input scripts, removed on both ends
+    class JobDir {
+      public:
+        JobDir() : path_(std::filesystem::temp_directory_path() / scratch_name()) {
+            std::filesystem::remove_all(path_);
+            std::filesystem::create_directories(path_);
+            write("a.gba", key_echo_rom());
+            write("b.gba", key_echo_rom("SRAM_V113")); // different bytes, same program
+            write_text("press.txt", "0 none\n2 A+Start\n4 0x0010\n");
+            write_text("idle.txt", "0 none\n");
+        }
+        JobDir(const JobDir &) = delete;
+        auto operator=(const JobDir &) -> JobDir & = delete;
+        JobDir(JobDir &&) = delete;
+        auto operator=(JobDir &&) -> JobDir & = delete;
+        ~JobDir() { std::filesystem::remove_all(path_); }
+
+        [[nodiscard]] auto path() const -> const std::filesystem::path & { return path_; }
+
+      private:
+        std::filesystem::path path_;
+
+        void write(const std::string &name, const std::vector<std::uint8_t> &bytes) const {
+            std::ofstream out(path_ / name, std::ios::binary);
+            out.write(reinterpret_cast<const char *>(bytes.data()), // NOLINT(*-reinterpret-cast)
+                      static_cast<std::streamsize>(bytes.size()));
+        }
+        void write_text(const std::string &name, std::string_view text) const {
+            std::ofstream(path_ / name) << text;
+        }
+    };
+
+    // The same job on a fresh instance, the way gba_headless runs it
+    auto solo(const BatchJob &job) -> HeadlessResult {
+        System sys;
+        sys.reset();
+        EXPECT_TRUE(sys.load_gamepak(job.rom));
+        sys.cpu().debug_set_program_counter(MMU::WS0_BASE);
+        InputScript input;
+        EXPECT_TRUE(job.input.empty() || input.load_file(job.input));
+        HeadlessConfig config;
+        config.frames = job.frames;
+        config.input = &input;
+        return gba::run_headless(sys, config);
+    }
+} // namespace
+
+TEST(BatchManifest, ParsesJobsRelativeToTheBase) {
+    std::vector<BatchJob> jobs;
+    ASSERT_TRUE(gba::parse_manifest("# rom input frames\n"
+                                    "a.gba  press.txt  60\n"
+                                    "\n"
+                                    "  /abs/b.gba\t-\t600   # no input\n",
+                                    "base", jobs));
+    ASSERT_EQ(jobs.size(), 2U);
+    EXPECT_EQ(jobs[0].rom, std::filesystem::path("base") / "a.gba");
+    EXPECT_EQ(jobs[0].input, std::filesystem::path("base") / "press.txt");
+    EXPECT_EQ(jobs[0].frames, 60U);
+    EXPECT_EQ(jobs[1].rom, std::filesystem::path("/abs/b.gba"));
+    EXPECT_TRUE(jobs[1].input.empty());
+
+    for (const std::string_view bad : {"a.gba - 0\n", "a.gba -\n", "a.gba - 10 extra\n", "a.gba - ten\n"}) {
+        EXPECT_FALSE(gba::parse_manifest(bad, "base", jobs)) << bad;
+    }
+    EXPECT_EQ(jobs.size(), 2U);
+}
+
+TEST(BatchRunner, SoftResetKeepsTheImagesAndRestoresPowerOnState) {
+    const auto rom = key_echo_rom("SRAM_V113");
+    System sys;
+    sys.reset();
+    sys.load_gamepak(rom);
+    sys.cpu().debug_set_program_counter(MMU::WS0_BASE);
+    HeadlessConfig config;
+    config.frames = kFrames;
+    const HeadlessResult first = gba::run_headless(sys, config);
+    sys.bus().write8(MMU::SRAM_BASE, 0x5AU);
+
+    sys.soft_reset();
+    EXPECT_EQ(sys.cycles(), 0U);
+    EXPECT_EQ(sys.bus().read8(MMU::WS0_BASE), rom[0]);                // GamePak still mapped
+    EXPECT_EQ(sys.bus().backup().type(), gba::BackupType::SRAM);      // same backup type...
+    EXPECT_EQ(sys.bus().read8(MMU::SRAM_BASE), gba::Backup::kErased); // ...freshly erased
+    sys.cpu().debug_set_program_counter(MMU::WS0_BASE);
+    const HeadlessResult second = gba::run_headless(sys, config);
+    EXPECT_EQ(second.framebuffer_hash, first.framebuffer_hash);
+    EXPECT_EQ(second.ram_hash, first.ram_hash);
+}
+
+TEST(BatchRunner, ParallelJobsMatchSoloRunsAndReuseInstances) {
+    const JobDir dir;
+    std::vector<BatchJob> jobs;
+    ASSERT_TRUE(gba::parse_manifest("a.gba press.txt 6\n"
+                                    "a.gba idle.txt  6\n"
+                                    "a.gba press.txt 4\n"
+                                    "b.gba -         6\n"
+                                    "b.gba press.txt 5\n"
+                                    "b.gba idle.txt  6\n",
+                                    dir.path(), jobs));
+    BatchRunner runner(kWorkers);
+    const BatchSummary summary = runner.run(jobs);
+    ASSERT_EQ(summary.results.size(), jobs.size());
+    EXPECT_EQ(summary.workers, kWorkers);
+    EXPECT_EQ(summary.failed(), 0U);
+
+    std::size_t reused = 0;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        const auto &result = summary.results[i];
+        const HeadlessResult expected = solo(jobs[i]);
+        EXPECT_EQ(result.run.frames, jobs[i].frames);
+        EXPECT_EQ(result.run.framebuffer_hash, expected.framebuffer_hash) << "job " << i;
+        EXPECT_EQ(result.run.ram_hash, expected.ram_hash) << "job " << i;
+        reused += result.reused ? 1U : 0U;
+    }
+    EXPECT_GT(reused, 0U);
+    EXPECT_EQ(summary.frames(), 33U);
+
+    // Running the same manifest again on the warm runner gives the same answers
+    const BatchSummary again = runner.run(jobs);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        EXPECT_EQ(again.results[i].run.ram_hash, summary.results[i].run.ram_hash);
+    }
+}
+
+TEST(BatchRunner, BrokenJobsFailAloneAndTheJsonSummaryListsEveryJob) {
+    const JobDir dir;
+    std::vector<BatchJob> jobs;
+    ASSERT_TRUE(gba::parse_manifest("a.gba press.txt 3\n"
+                                    "missing.gba - 3\n"
+                                    "a.gba nope.txt 3\n",
+                                    dir.path(), jobs));
+    BatchRunner runner(kWorkers);
+    const BatchSummary summary = runner.run(jobs);
+    ASSERT_EQ(summary.results.size(), 3U);
+    EXPECT_TRUE(summary.results[0].ok);
+    EXPECT_FALSE(summary.results[1].ok);
+    EXPECT_NE(summary.results[1].error.find("ROM"), std::string::npos);
+    EXPECT_FALSE(summary.results[2].ok);
+    EXPECT_NE(summary.results[2].error.find("input"), std::string::npos);
+    EXPECT_EQ(summary.failed(), 2U);
+
+    std::ostringstream json;
+    gba::write_batch_json(json, jobs, summary);
+    const std::string text = json.str();
+    EXPECT_NE(text.find("\"jobs\": 3"), std::string::npos);
+    EXPECT_NE(text.find("\"failed\": 2"), std::string::npos);
+    EXPECT_NE(text.find("\"ram_hash\": \""), std::string::npos);
+    EXPECT_NE(text.find("\"error\": \"cannot load ROM"), std::string::npos);
+    EXPECT_EQ(text.front(), '{');
+    EXPECT_EQ(text.substr(text.size() - 2U), "}\n");
+}
@@ -0,0 +1,156 @@
+// tests/batch_step.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/batch_step.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::BatchStepper;
+using gba::MMU;
+using gba::PPU;
+using gba::System;
+using gba::test::key_echo_program;
+using gba::test::kToTopByte;
+using gba::test::make_instance;
+using gba::test::state_of;
+
+namespace {
+    constexpr std::uint16_t kMode3Bg2 = 0x0403U; // DISPCNT: mode 3, BG2 on
+    constexpr std::uint32_t kDispcnt = MMU::IO_BASE;
+    constexpr std::size_t kInstances = 6U;
+    constexpr std::size_t kFrames = 3U;
+    constexpr std::size_t kFrameBytes = PPU::kPixels * sizeof(std::uint16_t);
+
+    // r1 = KEYINPUT; r3 = VRAM; loop { [r3] = [r1] (low byte) }: the keys show up as pixel 0
+    constexpr auto kProgram = key_echo_program(MMU::VRAM_BASE >> kToTopByte);
+
+    auto make_drawing_instance(std::uint8_t seed) -> std::unique_ptr<System> {
+        auto sys = make_instance(kProgram, seed);
+        sys->bus().write16(kDispcnt, kMode3Bg2);
+        return sys;
+    }
+
+    auto action_for(std::size_t instance, std::size_t frame) -> std::uint16_t {
+        return static_cast<std::uint16_t>(((instance * 3U) + frame) & 0xFFU);
+    }
+} // namespace
+
+TEST(BatchStepper, MatchesSteppingEachInstanceAlone) {
+    std::vector<std::unique_ptr<System>> batch;
+    std::vector<std::unique_ptr<System>> alone;
+    std::vector<System *> handles;
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        batch.push_back(make_drawing_instance(static_cast<std::uint8_t>(i)));
+        alone.push_back(make_drawing_instance(static_cast<std::uint8_t>(i)));
+        handles.push_back(batch.back().get());
+    }
+    ASSERT_EQ(BatchStepper::observation_bytes(*batch[0]), kFrameBytes); // default: the BGR555 framebuffer
+
+    BatchStepper stepper(3U);
+    std::vector<std::uint8_t> observations(kInstances * kFrameBytes);
+    for (std::size_t f = 0; f < kFrames; ++f) {
+        std::vector<std::uint16_t> actions;
+        for (std::size_t i = 0; i < kInstances; ++i) {
+            actions.push_back(action_for(i, f));
+            alone[i]->bus().io().set_keys_pressed(action_for(i, f));
+            alone[i]->run_frame();
+        }
+        ASSERT_TRUE(stepper.step(handles, actions, observations, kFrameBytes));
+    }
+
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        EXPECT_EQ(state_of(*batch[i]), state_of(*alone[i])) << "instance " << i;
+        const auto picture = std::span(observations).subspan(i * kFrameBytes, kFrameBytes);
+        EXPECT_TRUE(std::ranges::equal(picture, alone[i]->ppu().output())) << "instance " << i;
+        const auto keyinput = static_cast<std::uint8_t>(~action_for(i, kFrames - 1U));
+        EXPECT_EQ(picture[0], keyinput) << "instance " << i; // slot i holds instance i
+    }
+}
+
+// The usual agent setup: a small grey observation with the full-colour output switched off
+TEST(BatchStepper, GathersConfiguredObservationsAtTheCallersStride) {
+    constexpr std::uint32_t kSide = 84U;
+    constexpr std::size_t kBytes = std::size_t{kSide} * kSide;
+    constexpr std::size_t kStride = kBytes + 16U; // room for a per-row header, say
+    constexpr std::uint8_t kUntouched = 0xEEU;
+    std::vector<std::unique_ptr<System>> batch;
+    std::vector<System *> handles;
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        batch.push_back(make_drawing_instance(static_cast<std::uint8_t>(i)));
+        batch.back()->bus().write16(MMU::VRAM_BASE + 2U, static_cast<std::uint16_t>(0x1111U * (i + 1U)));
+        batch.back()->ppu().set_color_output(false);
+        ASSERT_TRUE(batch.back()->ppu().set_observation({gba::ObservationFormat::Gray8, kSide, kSide}));
+        handles.push_back(batch.back().get());
+    }
+    ASSERT_EQ(BatchStepper::observation_bytes(*batch[0]), kBytes);
+
+    BatchStepper stepper(3U);
+    std::vector<std::uint8_t> observations(kInstances * kStride, kUntouched);
+    const std::vector<std::uint16_t> actions(kInstances, 0U);
+    EXPECT_FALSE(stepper.step(handles, actions, observations, kBytes - 1U));
+    ASSERT_TRUE(stepper.step(handles, actions, observations, kStride));
+
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        const auto slot = std::span(observations).subspan(i * kStride, kStride);
+        EXPECT_TRUE(std::ranges::equal(slot.first(kBytes), batch[i]->ppu().observation())) << "instance " << i;
+        EXPECT_TRUE(std::ranges::all_of(slot.subspan(kBytes), [](std::uint8_t b) { return b == kUntouched; }));
+    }
+    EXPECT_FALSE(std::ranges::equal(std::span(observations).first(kBytes),
+                                    std::span(observations).subspan(kStride, kBytes))); // distinct pictures
+}
+
+TEST(BatchStepper, RejectsMismatchedBuffersAndSkipsCopiesWhenAsked) {
+    auto sys = make_drawing_instance(0U);
+    std::array<System *, 1> handles{sys.get()};
+    const std::array<std::uint16_t, 1> actions{0U};
+    const std::array<std::uint16_t, 2> tooMany{0U, 0U};
+    std::vector<std::uint8_t> tooSmall(kFrameBytes - 1U);
+
+    BatchStepper stepper(2U);
+    EXPECT_FALSE(stepper.step(handles, tooMany, {}, 0U));
+    EXPECT_FALSE(stepper.step(handles, actions, tooSmall, kFrameBytes));
+    EXPECT_FALSE(stepper.step(handles, actions, tooSmall, tooSmall.size())); // stride below the picture
+    EXPECT_EQ(sys->frame(), 0U); // nothing ran
+
+    EXPECT_TRUE(stepper.step(handles, actions, {}, 0U));
+    EXPECT_EQ(sys->frame(), 1U);
+    EXPECT_TRUE(stepper.step({}, {}, {}, 0U));
+}
+
+// One stride for the whole batch: pictures of different shapes, or none at all, are refused.
+TEST(BatchStepper, RefusesInstancesConfiguredDifferentlyOrDrawingNothing) {
+    auto plain = make_drawing_instance(0U);
+    auto converted = make_drawing_instance(1U);
+    converted->ppu().set_output_format(gba::PixelFormat::XRGB8888);
+    auto dark = make_drawing_instance(2U);
+    dark->ppu().set_color_output(false);
+    auto small = make_drawing_instance(3U);
+    ASSERT_TRUE(small->ppu().set_observation({gba::ObservationFormat::Gray8, 84U, 84U}));
+    auto smaller = make_drawing_instance(4U);
+    ASSERT_TRUE(smaller->ppu().set_observation({gba::ObservationFormat::Gray8, 42U, 42U}));
+    EXPECT_EQ(BatchStepper::observation_bytes(*dark), 0U);
+    const std::array<std::uint16_t, 2> actions{0U, 0U};
+    std::vector<std::uint8_t> observations(2U * PPU::kPixels * 4U);
+    const std::size_t stride = observations.size() / 2U;
+
+    BatchStepper stepper(2U);
+    const std::array<System *, 2> withConverted{plain.get(), converted.get()};
+    const std::array<System *, 1> onlyDark{dark.get()};
+    const std::array<System *, 2> withSizes{small.get(), smaller.get()};
+    EXPECT_FALSE(stepper.step(withConverted, actions, observations, stride));
+    EXPECT_FALSE(stepper.step(onlyDark, std::span(actions).first(1U), observations, stride));
+    EXPECT_FALSE(stepper.step(withSizes, actions, observations, stride));
+    EXPECT_EQ(plain->frame(), 0U); // nothing ran
+    EXPECT_EQ(dark->frame(), 0U);
+    EXPECT_EQ(small->frame(), 0U);
+
+    EXPECT_TRUE(stepper.step(withConverted, actions, {}, 0U)); // no copies: fine
+    EXPECT_EQ(converted->frame(), 1U);
+}
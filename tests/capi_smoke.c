@@ -0,0 +1,182 @@
+/* tests/capi_smoke.c
+ * Plain C use of gba_capi: builds the header as C and drives one instance
+ * through the whole API with a Thumb program that echoes KEYINPUT into EWRAM.
+ * Registered with CTest directly (no gtest); exits non-zero on the first failure.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gba_capi.h"
+
+#define CHECK(cond)                                                                                                    \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);                                   \
+            return 1;                                                                                                  \
+        }                                                                                                              \
+    } while (0)
+
+/* r1 = KEYINPUT; r3 = EWRAM; loop { [r3] = [r1] (low byte) } */
+static const uint16_t kProgram[] = {0x2104U, 0x0609U, 0x2026U, 0x00C0U, 0x1809U, 0x2302U,
+                                    0x061BU, 0x780AU, 0x701AU, 0xE7FDU};
+#define kProgramWords (sizeof(kProgram) / sizeof(kProgram[0]))
+#define kRomBytes 1024U
+
+static void build_rom(uint8_t *rom) {
+    memset(rom, 0, kRomBytes);
+    for (size_t i = 0; i < kProgramWords; ++i) {
+        rom[i * 2U] = (uint8_t)(kProgram[i] & 0xFFU);
+        rom[(i * 2U) + 1U] = (uint8_t)(kProgram[i] >> 8U);
+    }
+}
+
+static int echoes(const gba_instance *gba, uint16_t pressed) {
+    uint8_t copied = 0;
+    size_t bytes = 0;
+    const uint8_t *page = gba_ram_page(gba, GBA_RAM_EWRAM, 0U, &bytes);
+    const uint8_t expected = (uint8_t)(~pressed & 0xFFU);
+    return page != NULL && bytes == GBA_RAM_PAGE_BYTES && page[0] == expected &&
+           gba_read_ram(gba, GBA_RAM_EWRAM, 0U, &copied, 1U) && copied == expected;
+}
+
+int main(void) {
+    uint8_t rom[kRomBytes];
+    build_rom(rom);
+    CHECK(gba_api_version() == GBA_CAPI_VERSION);
+
+    gba_instance *gba = gba_create();
+    CHECK(gba != NULL);
+    CHECK(!gba_load_rom_memory(gba, NULL, 0U));
+    CHECK(!gba_load_rom_file(gba, "no/such/rom.gba"));
+
+    /* The same ROM from a file */
+    char path[] = "gba_capi_smoke.gba";
+    FILE *file = fopen(path, "wb");
+    CHECK(file != NULL);
+    CHECK(fwrite(rom, 1U, sizeof rom, file) == sizeof rom);
+    fclose(file);
+    CHECK(gba_load_rom_file(gba, path));
+    remove(path);
+
+    /* Input reaches the guest; RAM is visible in place and by copy */
+    gba_set_keys(gba, GBA_KEY_A | GBA_KEY_START);
+    gba_run_frame(gba);
+    CHECK(gba_frame_count(gba) == 1U);
+    CHECK(echoes(gba, GBA_KEY_A | GBA_KEY_START));
+    CHECK(gba_framebuffer(gba) != NULL);
+    CHECK(gba_ram_size(GBA_RAM_EWRAM) == 256U * 1024U);
+    CHECK(gba_ram_page(gba, GBA_RAM_EWRAM, 64U, NULL) == NULL);
+    CHECK(!gba_read_ram(gba, GBA_RAM_IWRAM, gba_ram_size(GBA_RAM_IWRAM) - 1U, rom, 2U));
+
+    /* Observations are sized as configured; bad sizes are refused */
+    size_t observed = 1U;
+    CHECK(gba_observation(gba, &observed) == NULL && observed == 0U);
+    CHECK(!gba_set_observation(gba, GBA_OBSERVATION_GRAY8, 0U, 84U));
+    CHECK(gba_set_observation(gba, GBA_OBSERVATION_GRAY8, 84U, 84U));
+    gba_set_color_output(gba, false);
+    gba_run_frame(gba);
+    CHECK(gba_observation(gba, &observed) != NULL && observed == 84U * 84U);
+    gba_set_color_output(gba, true);
+    CHECK(gba_set_observation(gba, GBA_OBSERVATION_NONE, 240U, 160U));
+
+    /* Native pixel formats size the output; BGR555 is the framebuffer itself */
+    CHECK(gba_set_pixel_format(gba, GBA_PIXEL_RGB24));
+    CHECK(gba_output(gba, &observed) != NULL && observed == GBA_SCREEN_WIDTH * GBA_SCREEN_HEIGHT * 3U);
+    CHECK(!gba_set_pixel_format(gba, (gba_pixel_format)7));
+    CHECK(gba_set_pixel_format(gba, GBA_PIXEL_BGR555));
+    CHECK(gba_output(gba, &observed) == (const uint8_t *)gba_framebuffer(gba));
+
+    /* Save states round trip; junk is rejected */
+    const size_t size = gba_save_state(gba, NULL, 0U);
+    CHECK(size > 0U);
+    uint8_t *state = malloc(size);
+    CHECK(state != NULL);
+    CHECK(gba_save_state(gba, state, size) == size);
+    gba_set_keys(gba, 0U);
+    gba_run_frame(gba);
+    CHECK(echoes(gba, 0U));
+    CHECK(gba_load_state(gba, state, size));
+    CHECK(gba_frame_count(gba) == 2U);
+    CHECK(echoes(gba, GBA_KEY_A | GBA_KEY_START));
+    CHECK(!gba_load_state(gba, state, size / 2U));
+
+    /* A well-framed state whose CPU section is 4 bytes longer leaves the instance as it was */
+    gba_set_keys(gba, GBA_KEY_L);
+    gba_run_frame(gba);
+    uint8_t *current = malloc(size);
+    uint8_t *after = malloc(size);
+    uint8_t *tampered = malloc(size + 4U);
+    CHECK(current != NULL && after != NULL && tampered != NULL);
+    CHECK(gba_save_state(gba, current, size) == size);
+    const size_t cpuSizeAt = 12U; /* header (magic, version), then the CPU section's tag and size */
+    uint32_t cpuBytes = 0;
+    memcpy(&cpuBytes, state + cpuSizeAt, sizeof cpuBytes);
+    const size_t cpuEnd = cpuSizeAt + sizeof cpuBytes + cpuBytes;
+    memcpy(tampered, state, cpuEnd);
+    memset(tampered + cpuEnd, 0x5A, 4U);
+    memcpy(tampered + cpuEnd + 4U, state + cpuEnd, size - cpuEnd);
+    cpuBytes += 4U;
+    memcpy(tampered + cpuSizeAt, &cpuBytes, sizeof cpuBytes);
+    CHECK(!gba_load_state(gba, tampered, size + 4U));
+    CHECK(gba_save_state(gba, after, size) == size);
+    CHECK(memcmp(after, current, size) == 0);
+    free(tampered);
+    free(after);
+    free(current);
+    free(state);
+
+    /* A second instance from memory; reset goes back to power-on */
+    gba_instance *other = gba_create();
+    CHECK(other != NULL);
+    CHECK(gba_load_rom_memory(other, rom, sizeof rom));
+    gba_set_keys(other, GBA_KEY_B);
+    gba_run_cycles(other, 1000U);
+    CHECK(echoes(other, GBA_KEY_B));
+    gba_reset(other);
+    CHECK(gba_frame_count(other) == 0U);
+
+    /* Both instances in one vectorised call: pictures land side by side */
+    gba_stepper *stepper = gba_stepper_create(2U);
+    CHECK(stepper != NULL);
+    gba_instance *const handles[] = {gba, other};
+    const uint16_t actions[] = {GBA_KEY_UP, GBA_KEY_DOWN};
+    const size_t frameBytes = (size_t)GBA_SCREEN_WIDTH * GBA_SCREEN_HEIGHT * sizeof(uint16_t);
+    CHECK(gba_step_many_bytes(other) == frameBytes);
+    uint8_t *observations = malloc(2U * frameBytes);
+    CHECK(observations != NULL);
+    const uint64_t before = gba_frame_count(gba);
+    CHECK(gba_step_many(stepper, handles, actions, 2U, observations, frameBytes));
+    CHECK(gba_frame_count(gba) == before + 1U && gba_frame_count(other) == 1U);
+    CHECK(echoes(gba, GBA_KEY_UP) && echoes(other, GBA_KEY_DOWN));
+    CHECK(memcmp(observations + frameBytes, gba_framebuffer(other), frameBytes) == 0);
+    CHECK(gba_step_many(stepper, handles, actions, 2U, NULL, 0U));
+    CHECK(!gba_step_many(stepper, NULL, actions, 2U, NULL, 0U));
+    CHECK(!gba_step_many(stepper, handles, actions, 2U, observations, 0U));
+
+    /* The agent setup: 84x84 grey observations with colour output off, packed back to back */
+    const uint32_t side = 84U;
+    const size_t grayBytes = (size_t)side * side;
+    gba_set_color_output(other, false);
+    CHECK(gba_set_observation(other, GBA_OBSERVATION_GRAY8, side, side));
+    CHECK(!gba_step_many(stepper, handles, actions, 2U, observations, frameBytes)); /* configured differently */
+    CHECK(gba_frame_count(other) == 2U);
+    gba_set_color_output(gba, false);
+    CHECK(gba_set_observation(gba, GBA_OBSERVATION_GRAY8, side, side));
+    CHECK(gba_step_many_bytes(gba) == grayBytes);
+    CHECK(gba_step_many(stepper, handles, actions, 2U, observations, grayBytes));
+    size_t grayObserved = 0;
+    const uint8_t *gray = gba_observation(other, &grayObserved);
+    CHECK(gray != NULL && grayObserved == grayBytes && memcmp(observations + grayBytes, gray, grayBytes) == 0);
+    CHECK(gba_set_observation(gba, GBA_OBSERVATION_NONE, side, side));
+    CHECK(gba_set_observation(other, GBA_OBSERVATION_NONE, side, side));
+    gba_set_color_output(gba, true);
+    gba_set_color_output(other, true);
+    free(observations);
+    gba_stepper_destroy(stepper);
+
+    gba_destroy(other);
+    gba_destroy(gba);
+    gba_destroy(NULL);
+    puts("gba_capi smoke test passed");
+    return 0;
+}
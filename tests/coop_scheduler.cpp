@@ -0,0 +1,98 @@
+// tests/coop_scheduler.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/system/coop_scheduler.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::CooperativeScheduler;
+using gba::MMU;
+using gba::System;
+using gba::test::key_echo_program;
+using gba::test::kToTopByte;
+using gba::test::make_instance;
+using gba::test::state_of;
+
+namespace {
+    constexpr std::size_t kInstances = 7U;
+    constexpr std::size_t kWorkers = 3U;
+    constexpr std::uint32_t kSlice = 1000U;
+    // One and a half frames and a bit: not a multiple of the slice, and crosses a frame boundary
+    constexpr std::uint64_t kBudget = (System::kCyclesPerFrame * 3U / 2U) + 123U;
+    constexpr std::uint64_t kSlicesEach = (kBudget + kSlice - 1U) / kSlice;
+
+    // r1 = KEYINPUT; r3 = EWRAM; loop { [r3] = [r1] (low byte) }
+    constexpr auto kProgram = key_echo_program(MMU::EWRAM_BASE >> kToTopByte);
+
+    auto with_keys(std::unique_ptr<System> sys, std::uint16_t keys) -> std::unique_ptr<System> {
+        sys->bus().io().set_keys_pressed(keys);
+        return sys;
+    }
+} // namespace
+
+TEST(CooperativeScheduler, SlicedRunsMatchOneRunPerInstance) {
+    std::vector<std::unique_ptr<System>> sliced;
+    std::vector<std::unique_ptr<System>> alone;
+    std::vector<System *> handles;
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        sliced.push_back(with_keys(make_instance(kProgram), static_cast<std::uint16_t>(1U << i)));
+        alone.push_back(with_keys(make_instance(kProgram), static_cast<std::uint16_t>(1U << i)));
+        handles.push_back(sliced.back().get());
+        alone.back()->run(static_cast<std::uint32_t>(kBudget));
+    }
+
+    CooperativeScheduler scheduler(kWorkers, kSlice);
+    EXPECT_EQ(scheduler.workers(), kWorkers);
+    scheduler.run(handles, kBudget);
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        EXPECT_EQ(sliced[i]->cycles(), kBudget) << i;
+        EXPECT_EQ(sliced[i]->frame(), 1U) << i;
+        EXPECT_EQ(state_of(*sliced[i]), state_of(*alone[i])) << "instance " << i;
+    }
+    const auto stats = scheduler.stats();
+    EXPECT_EQ(stats.slices, kInstances * kSlicesEach);
+    EXPECT_LE(stats.migrations, stats.slices);
+}
+
+TEST(CooperativeScheduler, RunsAccumulateAndEmptyCallsAreNoOps) {
+    std::vector<std::unique_ptr<System>> instances;
+    std::vector<System *> handles;
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        instances.push_back(make_instance(kProgram));
+        handles.push_back(instances.back().get());
+    }
+
+    CooperativeScheduler scheduler(kWorkers, 0U);
+    EXPECT_EQ(scheduler.slice_cycles(), CooperativeScheduler::kDefaultSliceCycles);
+    scheduler.run({}, kBudget);
+    scheduler.run(handles, 0U);
+    EXPECT_EQ(scheduler.stats().slices, 0U);
+
+    scheduler.run(handles, System::kCyclesPerFrame);
+    scheduler.run(std::span(handles).first(2U), System::kCyclesPerFrame);
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        EXPECT_EQ(instances[i]->frame(), i < 2U ? 2U : 1U) << i;
+    }
+}
+
+TEST(CooperativeScheduler, OneWorkerRunsManyInstancesToTheirBudget) {
+    constexpr std::size_t kMany = 64U;
+    std::vector<std::unique_ptr<System>> instances;
+    std::vector<System *> handles;
+    for (std::size_t i = 0; i < kMany; ++i) {
+        instances.push_back(with_keys(make_instance(kProgram), static_cast<std::uint16_t>(i)));
+        handles.push_back(instances.back().get());
+    }
+
+    CooperativeScheduler scheduler(1U, kSlice);
+    scheduler.run(handles, kBudget);
+    for (std::size_t i = 0; i < kMany; ++i) {
+        EXPECT_EQ(instances[i]->cycles(), kBudget) << i;
+        EXPECT_EQ(instances[i]->bus().read8(MMU::EWRAM_BASE), static_cast<std::uint8_t>(~i & 0xFFU)) << i;
+    }
+    EXPECT_EQ(scheduler.stats().slices, kMany * kSlicesEach);
+    EXPECT_EQ(scheduler.stats().migrations, 0U);
+}
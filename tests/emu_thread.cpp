@@ -0,0 +1,186 @@
+// tests/emu_thread.cpp
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "core/apu/audio_ring.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/emu_thread.h"
+#include "core/system/system.h"
+
+using gba::AudioRing;
+using gba::EmuThread;
+using gba::IORegs;
+using gba::AudioFrame;
+using gba::FrameTimeStats;
+using gba::MMU;
+using gba::Pacing;
+using gba::PPU;
+using gba::PresentStats;
+using gba::System;
+
+namespace {
+    constexpr std::uint16_t kRed = 0x001FU;
+    constexpr auto kTimeout = std::chrono::seconds(10);
+
+    constexpr std::size_t kRingFrames = 8192U;
+    constexpr double kHostFramesPerFrame = 48000.0 / EmuThread::kFrameHz; // ~803.6 at the default host rate
+    constexpr double kFastForward = 4.0;
+
+    void wait_for_frames(const EmuThread &emu, std::uint64_t frames) {
+        const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+        while (emu.frames() < frames && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+} // namespace
+
+TEST(PresentStats, CountsRepeatsAndDrops) {
+    PresentStats stats;
+    stats.on_present(0U); // nothing published yet: a repeat of "no frame"
+    stats.on_present(1U);
+    stats.on_present(1U);
+    stats.on_present(4U); // 2 and 3 never shown
+    EXPECT_EQ(stats.presented, 4U);
+    EXPECT_EQ(stats.repeated, 2U);
+    EXPECT_EQ(stats.dropped, 2U);
+}
+
+TEST(FrameTimeStats, MeanVarianceAndExtremes) {
+    FrameTimeStats stats;
+    EXPECT_EQ(stats.variance(), 0.0);
+    for (const double ms : {16.0, 17.0, 18.0, 17.0}) {
+        stats.add(ms);
+    }
+    EXPECT_EQ(stats.count, 4U);
+    EXPECT_DOUBLE_EQ(stats.mean, 17.0);
+    EXPECT_DOUBLE_EQ(stats.variance(), 2.0 / 3.0); // sample variance
+    EXPECT_DOUBLE_EQ(stats.min, 16.0);
+    EXPECT_DOUBLE_EQ(stats.max, 18.0);
+}
+
+TEST(EmuThread, PublishesFramesAndAppliesKeys) {
+    System sys;
+    sys.reset();
+    sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, PPU::kMode3 | PPU::kDispcntBg2);
+    sys.bus().write16(MMU::VRAM_BASE, kRed);
+
+    EmuThread emu(sys);
+    emu.set_pacing(Pacing::Uncapped);
+    emu.set_keys(IORegs::kKeyA | IORegs::kKeyUp);
+    emu.start();
+    wait_for_frames(emu, 3U);
+    emu.stop();
+
+    ASSERT_GE(emu.frames(), 3U);
+    EXPECT_EQ(sys.frame(), emu.frames());
+    EXPECT_EQ(sys.bus().io().keys_pressed(), IORegs::kKeyA | IORegs::kKeyUp);
+    ASSERT_TRUE(emu.video().acquire());
+    EXPECT_EQ(emu.video().front().sequence, emu.frames()); // newest frame
+    EXPECT_EQ(emu.video().front().pixels[0], kRed);
+    EXPECT_NE(emu.video().front().finished.time_since_epoch().count(), 0);
+}
+
+TEST(EmuThread, PacedRunDoesNotOutrunRealTime) {
+    System sys;
+    sys.reset();
+    EmuThread emu(sys);
+    EXPECT_EQ(emu.pacing(), Pacing::Clock); // no ring: the steady clock paces
+    const auto start = std::chrono::steady_clock::now();
+    emu.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    emu.stop();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LE(static_cast<double>(emu.frames()), (elapsed.count() * EmuThread::kFrameHz) + 2.0);
+    EXPECT_GE(emu.frames(), 1U);
+}
+
+TEST(EmuThread, FeedsTheAudioRingAndRestarts) {
+    System sys;
+    sys.reset();
+    AudioRing ring(kRingFrames);
+    EmuThread emu(sys, &ring);
+    emu.set_pacing(Pacing::Uncapped);
+    emu.start();
+    wait_for_frames(emu, 2U);
+    emu.stop();
+    EXPECT_GT(ring.size(), 0U);
+
+    const auto before = emu.frames();
+    emu.start(); // sequence numbers carry on across restarts
+    wait_for_frames(emu, before + 1U);
+    emu.stop();
+    EXPECT_GT(emu.frames(), before);
+}
+
+TEST(EmuThread, AudioPacingStopsAtTheTargetFillUntilTheDeviceDrains) {
+    System sys;
+    sys.reset();
+    AudioRing ring(kRingFrames);
+    EmuThread emu(sys, &ring);
+    ASSERT_EQ(emu.pacing(), Pacing::Audio); // default with a ring
+    emu.start();
+
+    const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    while (ring.fill_ratio() < EmuThread::kAudioTargetFill && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_GE(ring.fill_ratio(), EmuThread::kAudioTargetFill);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // let the frame in flight finish
+    const auto stalled = emu.frames();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(emu.frames(), stalled); // nobody consumed: no new frames
+    EXPECT_LT(ring.size(), ring.capacity());
+
+    std::vector<AudioFrame> sink(ring.capacity());
+    (void)ring.pop(sink); // the device drains the ring
+    wait_for_frames(emu, stalled + 1U);
+    emu.stop();
+    EXPECT_GT(emu.frames(), stalled);
+}
+
+TEST(EmuThread, UncappedFastForwardSkipsRenderingOfUnshownFrames) {
+    System sys;
+    sys.reset();
+    sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, PPU::kMode3 | PPU::kDispcntBg2);
+    sys.bus().write16(MMU::VRAM_BASE, kRed);
+
+    EmuThread emu(sys);
+    emu.set_speed(EmuThread::kUncapped);
+    emu.start();
+    const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    while (emu.achieved_speed() == 0.0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    emu.stop();
+
+    // How many frames were skipped depends on the host's speed; what reached the presenter does not
+    ASSERT_GE(emu.frames(), 1U);
+    ASSERT_TRUE(emu.video().acquire());
+    const auto &frame = emu.video().front();
+    EXPECT_GE(frame.sequence, 1U);
+    EXPECT_LE(frame.sequence, emu.frames()); // at most one publication per emulated frame
+    EXPECT_LE(frame.frame, emu.frames());
+    EXPECT_EQ(frame.pixels[0], kRed);       // skipped frames never reach the presenter half-drawn
+    EXPECT_TRUE(sys.ppu().render_enabled()); // skip-render is undone on stop
+}
+
+TEST(EmuThread, FastForwardCutsAudioToRealTimeRate) {
+    System sys;
+    sys.reset();
+    AudioRing ring(kRingFrames);
+    EmuThread emu(sys, &ring);
+    emu.set_pacing(Pacing::Clock);
+    emu.set_speed(kFastForward);
+    EXPECT_EQ(emu.speed(), kFastForward);
+    emu.start();
+    wait_for_frames(emu, 8U);
+    emu.stop();
+
+    // A quarter of each frame's host audio (the ring is far from full)
+    const double perFrame = static_cast<double>(ring.size()) / static_cast<double>(emu.frames());
+    EXPECT_NEAR(perFrame, kHostFramesPerFrame / kFastForward, kHostFramesPerFrame * 0.02);
+}
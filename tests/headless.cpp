@@ -0,0 +1,142 @@
+// tests/headless.cpp
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include "core/apu/apu.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/headless.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::AudioMode;
+using gba::HeadlessConfig;
+using gba::HeadlessResult;
+using gba::InputScript;
+using gba::IORegs;
+using gba::MMU;
+using gba::PPU;
+using gba::System;
+using gba::test::counting_key_echo_program;
+using gba::test::load_program;
+
+namespace {
+    constexpr std::uint16_t kMode3Bg2 = PPU::kMode3 | PPU::kDispcntBg2;
+
+    // Mode 3; loop { r5 += 1; pixel(0,0) low byte = r5; EWRAM[0] = KEYINPUT low byte }
+    void boot_key_echo(System &sys) {
+        sys.reset();
+        sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, kMode3Bg2);
+        load_program(sys, counting_key_echo_program());
+    }
+
+    constexpr std::uint64_t kFrames = 12U;
+    constexpr std::string_view kScript = "# frame keys\n"
+                                         "2   A\n"
+                                         "5   start+RIGHT   # mixed case\n"
+                                         "9   0x0041\n";
+    constexpr std::uint8_t kKeyInputLowMask = 0xFFU;
+
+    auto run(const InputScript &script, HeadlessConfig config) -> HeadlessResult {
+        System sys;
+        boot_key_echo(sys);
+        config.input = &script;
+        return gba::run_headless(sys, config);
+    }
+} // namespace
+
+TEST(InputScript, ParsesNamesMasksAndComments) {
+    InputScript script;
+    ASSERT_TRUE(script.parse(kScript));
+    ASSERT_EQ(script.entries().size(), 3U);
+    EXPECT_EQ(script.keys_at(0U), 0U); // before the first entry
+    EXPECT_EQ(script.keys_at(2U), IORegs::kKeyA);
+    EXPECT_EQ(script.keys_at(4U), IORegs::kKeyA); // held until the next entry
+    EXPECT_EQ(script.keys_at(5U), IORegs::kKeyStart | IORegs::kKeyRight);
+    EXPECT_EQ(script.keys_at(1000U), IORegs::kKeyA | IORegs::kKeyUp);
+    ASSERT_TRUE(script.parse("0 none\n"));
+    EXPECT_EQ(script.keys_at(0U), 0U);
+}
+
+TEST(InputScript, RejectsMalformedLinesWithoutChangingTheScript) {
+    InputScript script;
+    ASSERT_TRUE(script.parse(kScript));
+    for (const std::string_view bad : {"5 A\n5 B\n", "9 A\n3 B\n", "x A\n", "1 Turbo\n", "1 A+\n", "1\n",
+                                       "1 0x0400\n", "-1 A\n"}) {
+        EXPECT_FALSE(script.parse(bad)) << bad;
+    }
+    EXPECT_EQ(script.entries().size(), 3U);
+}
+
+TEST(Headless, Fnv1aMatchesReferenceVectorsAndChains) {
+    constexpr std::uint64_t kEmpty = 0xCBF29CE484222325ULL;
+    constexpr std::uint64_t kLetterA = 0xAF63DC4C8601EC8CULL;
+    constexpr std::array<std::uint8_t, 1> kA{'a'};
+    constexpr std::array<std::uint8_t, 4> kWhole{1U, 2U, 3U, 4U};
+    EXPECT_EQ(gba::fnv1a64({}), kEmpty);
+    EXPECT_EQ(gba::fnv1a64(kA), kLetterA);
+    const std::span<const std::uint8_t> whole(kWhole);
+    EXPECT_EQ(gba::fnv1a64(whole.subspan(2U), gba::fnv1a64(whole.first(2U))), gba::fnv1a64(whole));
+}
+
+TEST(Headless, ScriptedRunsAreDeterministicAndInputReachesRam) {
+    InputScript script;
+    ASSERT_TRUE(script.parse(kScript));
+    HeadlessConfig config;
+    config.frames = kFrames;
+
+    System sys;
+    boot_key_echo(sys);
+    config.input = &script;
+    const HeadlessResult first = gba::run_headless(sys, config);
+    EXPECT_EQ(first.frames, kFrames);
+    EXPECT_EQ(first.cycles, kFrames * System::kCyclesPerFrame);
+    EXPECT_GT(first.seconds, 0.0);
+    EXPECT_GT(first.fps(), 0.0);
+    const auto pressedLow = static_cast<std::uint8_t>(script.keys_at(kFrames - 1U) & kKeyInputLowMask);
+    EXPECT_EQ(sys.bus().read8(MMU::EWRAM_BASE), static_cast<std::uint8_t>(~pressedLow)); // active low
+
+    const HeadlessResult second = run(script, config);
+    EXPECT_EQ(second.framebuffer_hash, first.framebuffer_hash);
+    EXPECT_EQ(second.ram_hash, first.ram_hash);
+
+    InputScript idle;
+    const HeadlessResult other = run(idle, config);
+    EXPECT_EQ(other.framebuffer_hash, first.framebuffer_hash); // the picture does not read the keys
+    EXPECT_NE(other.ram_hash, first.ram_hash);
+}
+
+TEST(Headless, CycleBudgetMatchesTheSameNumberOfFrames) {
+    InputScript script;
+    ASSERT_TRUE(script.parse(kScript));
+    HeadlessConfig frames;
+    frames.frames = kFrames;
+    HeadlessConfig cycles;
+    cycles.cycles = kFrames * System::kCyclesPerFrame;
+
+    const HeadlessResult byFrames = run(script, frames);
+    const HeadlessResult byCycles = run(script, cycles);
+    EXPECT_EQ(byCycles.frames, kFrames);
+    EXPECT_EQ(byCycles.cycles, byFrames.cycles);
+    EXPECT_EQ(byCycles.framebuffer_hash, byFrames.framebuffer_hash);
+    EXPECT_EQ(byCycles.ram_hash, byFrames.ram_hash);
+
+    cycles.cycles = System::kCyclesPerLine + 1U; // budgets need not end on a boundary
+    EXPECT_EQ(run(script, cycles).cycles, System::kCyclesPerLine + 1U);
+}
+
+TEST(Headless, SkipRenderAndAudioModeAreRestored) {
+    System sys;
+    boot_key_echo(sys);
+    const std::uint64_t blank = gba::framebuffer_hash(sys.ppu());
+    HeadlessConfig config;
+    config.frames = 2U;
+    config.render = false;
+    const HeadlessResult result = gba::run_headless(sys, config);
+    EXPECT_EQ(result.framebuffer_hash, blank); // nothing drawn
+    EXPECT_TRUE(sys.ppu().render_enabled());
+    EXPECT_EQ(sys.bus().apu().mode(), AudioMode::Full);
+    EXPECT_TRUE(sys.bus().apu().output().empty());
+}
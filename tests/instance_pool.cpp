@@ -0,0 +1,155 @@
+// tests/instance_pool.cpp
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/mmu/paged_memory.h"
+#include "core/system/instance_pool.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::InstancePool;
+using gba::InstancePoolStats;
+using gba::MMU;
+using gba::PagedMemory;
+using gba::System;
+using gba::test::kToTopByte;
+using gba::test::load_program;
+using gba::test::state_of;
+using gba::test::Thumb_ADD_imm;
+using gba::test::Thumb_ADD_reg;
+using gba::test::Thumb_B_off11;
+using gba::test::Thumb_LSL_imm;
+using gba::test::Thumb_LSR_imm;
+using gba::test::Thumb_MOV_imm;
+using gba::test::Thumb_STRB_imm;
+
+namespace {
+    constexpr std::int16_t kBackToLoop = -12; // B at +16 targets +6: relative to the next instruction
+    constexpr std::uint16_t kEwramHighByte = 0x02U;
+    constexpr std::uint16_t kKeep18Bits = 14U; // 32 - 18: offsets wrap inside EWRAM's 256 KiB
+    constexpr int kIntroFrames = 2;
+    constexpr int kEpisodeFrames = 1;
+
+    // r3 = EWRAM_BASE; loop { r4 += 1; [r3 + (r4 & 0x3FFFF)] = r4 (byte) }: ~11 new pages per frame
+    void boot_walker(System &sys) {
+        sys.reset();
+        const std::array<std::uint16_t, 9> program{
+            Thumb_MOV_imm(3U, kEwramHighByte),  Thumb_LSL_imm(3U, 3U, kToTopByte),
+            Thumb_MOV_imm(4U, 0U),              Thumb_ADD_imm(4U, 1U),
+            Thumb_LSL_imm(5U, 4U, kKeep18Bits), Thumb_LSR_imm(5U, 5U, kKeep18Bits),
+            Thumb_ADD_reg(6U, 3U, 5U),          Thumb_STRB_imm(4U, 6U, 0U),
+            Thumb_B_off11(kBackToLoop)};
+        load_program(sys, program);
+        for (int f = 0; f < kIntroFrames; ++f) {
+            sys.run_frame();
+        }
+    }
+
+    void run_episode(System &sys) {
+        for (int f = 0; f < kEpisodeFrames; ++f) {
+            sys.run_frame();
+        }
+    }
+
+
+    auto pages_apart(const PagedMemory &a, const PagedMemory &b) -> std::size_t {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < a.page_count(); ++i) {
+            count += a.shares_page_with(b, i) ? 0U : 1U;
+        }
+        return count;
+    }
+} // namespace
+
+TEST(InstancePool, ResetReSharesOnlyWrittenPagesAndMatchesAFreshFork) {
+    System intro;
+    boot_walker(intro);
+    InstancePool pool(intro, 1U);
+    const auto start = state_of(pool.snapshot());
+
+    auto sys = pool.acquire();
+    EXPECT_EQ(state_of(*sys), start);
+    run_episode(*sys);
+    const std::size_t written = pages_apart(sys->bus().ewram(), pool.snapshot().bus().ewram());
+    EXPECT_GT(written, 4U);
+    EXPECT_LT(written, PagedMemory::kMaxPages / 2U); // far from all of EWRAM
+    EXPECT_NE(state_of(*sys), start);
+
+    EXPECT_EQ(pool.reset(*sys), written);
+    EXPECT_EQ(pages_apart(sys->bus().ewram(), pool.snapshot().bus().ewram()), 0U);
+    EXPECT_EQ(state_of(*sys), start);
+    EXPECT_EQ(sys->frame(), pool.snapshot().frame());
+    const auto picture = pool.snapshot().ppu().framebuffer();
+    EXPECT_TRUE(std::ranges::equal(sys->ppu().framebuffer(), picture));
+    EXPECT_EQ(pool.reset(*sys), 0U); // nothing written since
+
+    // A restored instance runs on exactly like a new fork
+    const auto fresh = pool.snapshot().fork();
+    run_episode(*sys);
+    run_episode(*fresh);
+    EXPECT_EQ(state_of(*sys), state_of(*fresh));
+    EXPECT_EQ(state_of(pool.snapshot()), start); // the snapshot itself never moves
+}
+
+TEST(InstancePool, HandsOutWarmInstancesThenForks) {
+    System intro;
+    boot_walker(intro);
+    InstancePool pool(intro, 2U);
+    EXPECT_EQ(pool.ready(), 2U);
+
+    std::vector<std::unique_ptr<System>> out;
+    for (int i = 0; i < 3; ++i) {
+        out.push_back(pool.acquire());
+        run_episode(*out.back());
+    }
+    EXPECT_EQ(pool.ready(), 0U);
+    for (auto &sys : out) {
+        pool.release(std::move(sys));
+    }
+    pool.release(nullptr);
+    EXPECT_EQ(pool.ready(), 3U);
+
+    const InstancePoolStats stats = pool.stats();
+    EXPECT_EQ(stats.acquired, 3U);
+    EXPECT_EQ(stats.forked, 1U);
+    EXPECT_EQ(stats.restores, 3U);
+    EXPECT_GT(stats.pages_restored, 3U * 4U);
+
+    const auto again = pool.acquire();
+    EXPECT_EQ(state_of(*again), state_of(pool.snapshot()));
+}
+
+TEST(InstancePool, EpisodesOnSeveralThreadsRestoreConcurrently) {
+    constexpr int kThreads = 4;
+    constexpr int kEpisodes = 5;
+    System intro;
+    boot_walker(intro);
+    InstancePool pool(intro, 2U);
+    const auto reference = pool.snapshot().fork();
+    run_episode(*reference);
+    const auto expected = state_of(*reference);
+
+    std::array<int, kThreads> matches{};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&pool, &expected, &matches, t] {
+            for (int e = 0; e < kEpisodes; ++e) {
+                auto sys = pool.acquire();
+                run_episode(*sys);
+                matches[static_cast<std::size_t>(t)] += state_of(*sys) == expected ? 1 : 0;
+                pool.release(std::move(sys));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (const int count : matches) {
+        EXPECT_EQ(count, kEpisodes);
+    }
+    EXPECT_EQ(pool.stats().restores, static_cast<std::uint64_t>(kThreads * kEpisodes));
+}
@@ -0,0 +1,167 @@
+// tests/latency.cpp
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/emu_thread.h"
+#include "core/system/latency.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::EmuThread;
+using gba::InputProbe;
+using gba::IORegs;
+using gba::LatencyHistogram;
+using gba::LatencyStats;
+using gba::MMU;
+using gba::Pacing;
+using gba::PPU;
+using gba::System;
+using gba::test::kKeyInputDiv8;
+using gba::test::kTimes8;
+using gba::test::kToTopByte;
+using gba::test::load_program;
+using gba::test::Thumb_ADD_imm;
+using gba::test::Thumb_ADD_reg;
+using gba::test::Thumb_B_off11;
+using gba::test::Thumb_LDRB_imm;
+using gba::test::Thumb_LSL_imm;
+using gba::test::Thumb_MOV_imm;
+using gba::test::Thumb_STRB_imm;
+
+namespace {
+    constexpr std::int16_t kBackToLoop = -6; // B two instructions after the loop label (offset from the next one)
+    constexpr std::uint16_t kMode3Bg2 = PPU::kMode3 | PPU::kDispcntBg2;
+    constexpr std::uint8_t kKeyInputLowMask = 0xFFU;
+    constexpr auto kTimeout = std::chrono::seconds(10);
+
+    void boot(System &sys, std::span<const std::uint16_t> program) {
+        sys.reset();
+        sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, kMode3Bg2);
+        load_program(sys, program);
+    }
+
+    // Mode 3; loop { pixel(0,0) low byte = KEYINPUT low byte }
+    constexpr std::array<std::uint16_t, 10> kKeyToPixel{
+        Thumb_MOV_imm(1U, MMU::IO_BASE >> kToTopByte), Thumb_LSL_imm(1U, 1U, kToTopByte),
+        Thumb_MOV_imm(0U, kKeyInputDiv8),              Thumb_LSL_imm(0U, 0U, kTimes8),
+        Thumb_ADD_reg(1U, 1U, 0U),                     Thumb_MOV_imm(4U, MMU::VRAM_BASE >> kToTopByte),
+        Thumb_LSL_imm(4U, 4U, kToTopByte),
+        // loop:
+        Thumb_LDRB_imm(2U, 1U, 0U), Thumb_STRB_imm(2U, 4U, 0U), Thumb_B_off11(kBackToLoop)};
+
+    // Mode 3; loop { pixel(0,0) low byte += 1 }: animates but never looks at the keys
+    constexpr std::array<std::uint16_t, 5> kIgnoresKeys{
+        Thumb_MOV_imm(4U, MMU::VRAM_BASE >> kToTopByte), Thumb_LSL_imm(4U, 4U, kToTopByte),
+        // loop:
+        Thumb_ADD_imm(5U, 1U), Thumb_STRB_imm(5U, 4U, 0U), Thumb_B_off11(kBackToLoop)};
+
+    template <typename Done> void wait_until(Done &&done) {
+        const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+} // namespace
+
+TEST(LatencyHistogram, BucketsPercentilesAndOverflow) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0.0);
+    for (const double ms : {10.2, 10.7, 12.0, 30.5}) {
+        histogram.add(ms);
+    }
+    histogram.add(1000.0); // past the last bucket
+    EXPECT_EQ(histogram.count(), 5U);
+    EXPECT_DOUBLE_EQ(histogram.mean(), (10.2 + 10.7 + 12.0 + 30.5 + 1000.0) / 5.0);
+    EXPECT_EQ(histogram.bucket(10U), 2U);
+    EXPECT_EQ(histogram.bucket(LatencyHistogram::kBuckets - 1U), 1U);
+    EXPECT_DOUBLE_EQ(histogram.percentile(0.4), 11.0); // upper bound of the 10-11 ms bucket
+    EXPECT_DOUBLE_EQ(histogram.percentile(0.6), 13.0);
+    EXPECT_DOUBLE_EQ(histogram.percentile(0.8), 31.0);
+    EXPECT_DOUBLE_EQ(histogram.percentile(1.0), static_cast<double>(LatencyHistogram::kBuckets));
+}
+
+TEST(LatencyStats, CountsEachProbeOnceAtItsFirstPresent) {
+    using namespace std::chrono_literals;
+    const auto t0 = InputProbe::Clock::now();
+    InputProbe probe;
+    probe.id = 1U;
+    probe.input = t0;
+    probe.read = t0 + 5ms;
+    probe.changed = t0 + 20ms;
+
+    LatencyStats stats;
+    stats.on_present(InputProbe{}, t0 + 1ms); // no probe yet
+    stats.on_present(probe, t0 + 33ms);
+    stats.on_present(probe, t0 + 50ms); // same probe on a repeated/newer frame
+    ASSERT_EQ(stats.to_present.count(), 1U);
+    EXPECT_NEAR(stats.to_read.mean(), 5.0, 1e-6);
+    EXPECT_NEAR(stats.to_changed.mean(), 20.0, 1e-6);
+    EXPECT_NEAR(stats.to_present.mean(), 33.0, 1e-6);
+}
+
+TEST(IORegs, FlagsKeyInputReadsForLatencyProbes) {
+    IORegs io;
+    io.reset();
+    EXPECT_FALSE(io.take_keyinput_read());
+    static_cast<void>(io.read16(IORegs::kOffVCOUNT));
+    EXPECT_FALSE(io.take_keyinput_read());
+    static_cast<void>(io.read8(IORegs::kOffKEYINPUT + 1U));
+    EXPECT_TRUE(io.take_keyinput_read());
+    EXPECT_FALSE(io.take_keyinput_read()); // taking clears it
+    static_cast<void>(io.read16(IORegs::kOffKEYINPUT));
+    io.reset();
+    EXPECT_FALSE(io.take_keyinput_read());
+}
+
+TEST(EmuThread, ProbesFollowAKeyPressToTheFirstChangedFrame) {
+    System sys;
+    boot(sys, kKeyToPixel);
+    EmuThread emu(sys);
+    emu.set_pacing(Pacing::Uncapped);
+    emu.start();
+    wait_until([&] { return emu.frames() >= 2U; });
+
+    const auto pressed = EmuThread::Clock::now();
+    emu.set_keys(IORegs::kKeyA, pressed);
+    wait_until([&] { return emu.video().acquire() && emu.video().front().probe.id != 0U; });
+    emu.stop();
+
+    const InputProbe &probe = emu.video().front().probe;
+    ASSERT_EQ(probe.id, 1U);
+    EXPECT_EQ(probe.input, pressed);
+    EXPECT_GE(probe.input_frame, 3U);
+    // The guest polls continuously, so the read and the new picture land in the first frame with the keys
+    EXPECT_EQ(probe.read_frame, probe.input_frame);
+    EXPECT_EQ(probe.changed_frame, probe.input_frame);
+    EXPECT_LE(probe.input, probe.read);
+    EXPECT_LE(probe.read, probe.changed);
+    EXPECT_EQ(emu.video().front().pixels[0] & kKeyInputLowMask,
+              static_cast<std::uint16_t>(~IORegs::kKeyA & kKeyInputLowMask));
+
+    // Presented later: input-to-photon covers the whole chain
+    LatencyStats stats;
+    stats.on_present(probe, EmuThread::Clock::now());
+    EXPECT_GE(stats.to_present.mean(), stats.to_changed.mean());
+}
+
+TEST(EmuThread, ProbesIgnorePictureChangesTheGuestDidNotReadKeysFor) {
+    constexpr std::uint64_t kFramesAfterPress = 5U;
+    System sys;
+    boot(sys, kIgnoresKeys);
+    EmuThread emu(sys);
+    emu.set_pacing(Pacing::Uncapped);
+    emu.start();
+    wait_until([&] { return emu.frames() >= 1U; });
+    emu.set_keys(IORegs::kKeyB);
+    const std::uint64_t target = emu.frames() + kFramesAfterPress;
+    wait_until([&] { return emu.frames() >= target; });
+    emu.stop();
+
+    ASSERT_TRUE(emu.video().acquire());
+    EXPECT_EQ(emu.video().front().probe.id, 0U); // every frame changed, but none in response to the keys
+}
@@ -0,0 +1,167 @@
+// tests/movie.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/system/movie.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::IORegs;
+using gba::MMU;
+using gba::Movie;
+using gba::MovieConfig;
+using gba::System;
+using gba::test::counter_program;
+using gba::test::load_program;
+using gba::test::state_of;
+
+namespace {
+    constexpr std::uint16_t kEwramHighByte = 0x02U;
+
+    // r1 = EWRAM_BASE; loop { r0 += 1; [r1] = r0 (byte) }
+    void load_counter_program(System &sys) {
+        load_program(sys, counter_program(kEwramHighByte));
+    }
+
+    constexpr std::uint32_t kInterval = 10U;
+    constexpr std::uint64_t kFrames = 35U;
+
+    auto keys_for(std::uint64_t frame) -> std::uint16_t {
+        return static_cast<std::uint16_t>((frame * 37U) & IORegs::kKeyMask);
+    }
+
+    // Records kFrames frames and the full state at the start of every frame (and the end)
+    auto record(System &sys, Movie &movie) -> std::vector<std::vector<std::uint8_t>> {
+        sys.reset();
+        load_counter_program(sys);
+        std::vector<std::vector<std::uint8_t>> states(kFrames + 1U);
+        for (std::uint64_t f = 0; f < kFrames; ++f) {
+            sys.save_state(states[f]);
+            movie.record_frame(sys, keys_for(f));
+        }
+        sys.save_state(states[kFrames]);
+        return states;
+    }
+} // namespace
+
+TEST(Movie, RecordsInputsAndPeriodicKeyframes) {
+    System sys;
+    Movie movie(MovieConfig{kInterval});
+    record(sys, movie);
+    EXPECT_EQ(movie.frame_count(), kFrames);
+    EXPECT_EQ(movie.position(), kFrames);
+    EXPECT_EQ(movie.keyframe_count(), 4U); // frames 0, 10, 20, 30
+    EXPECT_EQ(movie.input(7U), keys_for(7U));
+    EXPECT_LT(movie.keyframe_bytes(), movie.keyframe_count() * state_of(sys).size() / 4U); // compressed
+}
+
+TEST(Movie, SeekLandsOnTheRecordedState) {
+    System sys;
+    Movie movie(MovieConfig{kInterval});
+    const auto states = record(sys, movie);
+
+    System replay;
+    replay.reset();
+    for (const std::uint64_t target : {0U, 9U, 10U, 23U, 34U, 35U, 3U}) {
+        ASSERT_TRUE(movie.seek(replay, target)) << target;
+        EXPECT_EQ(movie.position(), target);
+        EXPECT_EQ(state_of(replay), states[target]) << "frame " << target;
+    }
+    EXPECT_FALSE(movie.seek(replay, kFrames + 1U));
+}
+
+TEST(Movie, PlaybackFollowsTheRecording) {
+    System sys;
+    Movie movie(MovieConfig{kInterval});
+    const auto states = record(sys, movie);
+
+    System replay;
+    ASSERT_TRUE(movie.seek(replay, 0U));
+    std::uint64_t played = 0;
+    while (movie.play_frame(replay)) {
+        ++played;
+        EXPECT_EQ(replay.bus().io().keys_pressed(), keys_for(played - 1U));
+    }
+    EXPECT_EQ(played, kFrames);
+    EXPECT_EQ(state_of(replay), states[kFrames]);
+}
+
+TEST(Movie, RecordingAfterSeekTruncatesTheFuture) {
+    System sys;
+    Movie movie(MovieConfig{kInterval});
+    record(sys, movie);
+
+    ASSERT_TRUE(movie.seek(sys, 12U));
+    movie.record_frame(sys, IORegs::kKeyStart);
+    EXPECT_EQ(movie.frame_count(), 13U);
+    EXPECT_EQ(movie.keyframe_count(), 2U);
+    EXPECT_EQ(movie.input(12U), IORegs::kKeyStart);
+
+    // A keyframe dropped by truncation is taken again when its frame comes round
+    ASSERT_TRUE(movie.seek(sys, 10U));
+    movie.record_frame(sys, 0U);
+    EXPECT_EQ(movie.keyframe_count(), 2U);
+    ASSERT_TRUE(movie.seek(sys, 11U));
+}
+
+TEST(Movie, SavedMovieReloadsAndRejectsDamage) {
+    System sys;
+    Movie movie(MovieConfig{kInterval});
+    const auto states = record(sys, movie);
+    std::vector<std::uint8_t> bytes;
+    movie.save(bytes);
+
+    Movie loaded;
+    ASSERT_TRUE(loaded.load(bytes));
+    EXPECT_EQ(loaded.config().keyframe_interval, kInterval);
+    EXPECT_EQ(loaded.frame_count(), kFrames);
+    System replay;
+    ASSERT_TRUE(loaded.seek(replay, 27U));
+    EXPECT_EQ(state_of(replay), states[27U]);
+
+    auto truncated = bytes;
+    truncated.pop_back();
+    EXPECT_FALSE(loaded.load(truncated));
+    auto badMagic = bytes;
+    badMagic[0] ^= 0xFFU;
+    EXPECT_FALSE(loaded.load(badMagic));
+    EXPECT_EQ(loaded.frame_count(), kFrames); // failed loads leave the movie alone
+}
+
+// A keyframe's raw size decides how much seek() allocates: it must match the recorded state size.
+TEST(Movie, RejectsKeyframeSizesOtherThanTheRecordedState) {
+    System sys;
+    Movie movie(MovieConfig{kInterval});
+    (void)record(sys, movie);
+    std::vector<std::uint8_t> bytes;
+    movie.save(bytes);
+
+    // MOVI payload: interval (u32), frame count (u64), state size (u32)
+    constexpr std::size_t kStateSizeAt = 8U + 8U + 4U + 8U;
+    std::uint32_t stateSize = 0;
+    std::memcpy(&stateSize, &bytes[kStateSizeAt], sizeof(stateSize));
+    std::vector<std::uint8_t> state;
+    sys.save_state(state);
+    ASSERT_EQ(stateSize, state.size());
+
+    // First keyframe's raw size sits after the KEYF header and keyframe count
+    const std::size_t keyframesAt = kStateSizeAt + 4U + 8U + (kFrames * sizeof(std::uint16_t)) + 8U + 4U;
+    std::uint32_t rawSize = 0;
+    std::memcpy(&rawSize, &bytes[keyframesAt], sizeof(rawSize));
+    ASSERT_EQ(rawSize, stateSize);
+
+    Movie loaded;
+    auto huge = bytes;
+    const std::uint32_t kHuge = 0xFFFFFFF0U;
+    std::memcpy(&huge[keyframesAt], &kHuge, sizeof(kHuge));
+    EXPECT_FALSE(loaded.load(huge));
+
+    auto hugeState = huge; // state size and keyframe agree, but past the cap
+    std::memcpy(&hugeState[kStateSizeAt], &kHuge, sizeof(kHuge));
+    EXPECT_FALSE(loaded.load(hugeState));
+
+    ASSERT_TRUE(loaded.load(bytes));
+}
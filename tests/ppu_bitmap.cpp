@@ -0,0 +1,89 @@
+// tests/ppu_bitmap.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "core/bus/bus.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+
+using gba::Bus;
+using gba::IORegs;
+using gba::MMU;
+using gba::PPU;
+
+namespace {
+    constexpr std::uint16_t kRed = 0x001FU;
+    constexpr std::uint16_t kBlue = 0x7C00U;
+    constexpr std::uint16_t kGreen = 0x03E0U;
+    constexpr std::uint16_t kLine = 10U;
+
+    void set_dispcnt(Bus &bus, std::uint16_t value) { bus.write16(MMU::IO_BASE + IORegs::kOffDISPCNT, value); }
+
+    auto pixel(const PPU &ppu, std::uint32_t x, std::uint32_t y) -> std::uint16_t {
+        return ppu.framebuffer()[(y * PPU::kScreenWidth) + x];
+    }
+} // namespace
+
+TEST(PPUBitmap, Mode3CopiesDirectColour) {
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    set_dispcnt(bus, PPU::kMode3 | PPU::kDispcntBg2);
+    bus.write16(MMU::VRAM_BASE + (((kLine * PPU::kScreenWidth) + 5U) * 2U), kRed);
+    bus.write16(MMU::VRAM_BASE + (((kLine * PPU::kScreenWidth) + 6U) * 2U), kRed | 0x8000U); // bit 15 ignored
+
+    ppu.render_line(kLine, bus);
+    EXPECT_EQ(pixel(ppu, 5U, kLine), kRed);
+    EXPECT_EQ(pixel(ppu, 6U, kLine), kRed);
+    EXPECT_EQ(pixel(ppu, 0U, kLine), 0U);
+}
+
+TEST(PPUBitmap, Mode4UsesPaletteAndFrameSelect) {
+    constexpr std::uint8_t kIndexFront = 1U;
+    constexpr std::uint8_t kIndexBack = 2U;
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    bus.write16(MMU::PAL_BASE + (kIndexFront * 2U), kGreen);
+    bus.write16(MMU::PAL_BASE + (kIndexBack * 2U), kBlue);
+    bus.write8(MMU::VRAM_BASE + (kLine * PPU::kScreenWidth), kIndexFront);
+    bus.write8(MMU::VRAM_BASE + PPU::kPageBytes + (kLine * PPU::kScreenWidth), kIndexBack);
+
+    set_dispcnt(bus, PPU::kMode4 | PPU::kDispcntBg2);
+    ppu.render_line(kLine, bus);
+    EXPECT_EQ(pixel(ppu, 0U, kLine), kGreen);
+
+    set_dispcnt(bus, PPU::kMode4 | PPU::kDispcntBg2 | PPU::kDispcntFrameSelect);
+    ppu.render_line(kLine, bus);
+    EXPECT_EQ(pixel(ppu, 0U, kLine), kBlue);
+}
+
+TEST(PPUBitmap, Mode5FillsOutsideWithBackdrop) {
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    bus.write16(MMU::PAL_BASE, kBlue);
+    bus.write16(MMU::VRAM_BASE, kRed);
+    set_dispcnt(bus, PPU::kMode5 | PPU::kDispcntBg2);
+
+    ppu.render_line(0U, bus);
+    ppu.render_line(PPU::kMode5Height, bus);
+    EXPECT_EQ(pixel(ppu, 0U, 0U), kRed);
+    EXPECT_EQ(pixel(ppu, PPU::kMode5Width, 0U), kBlue);
+    EXPECT_EQ(pixel(ppu, 0U, PPU::kMode5Height), kBlue);
+}
+
+TEST(PPUBitmap, ForcedBlankAndDisabledRendering) {
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    set_dispcnt(bus, PPU::kMode3 | PPU::kDispcntBg2 | PPU::kDispcntForcedBlank);
+    ppu.render_line(kLine, bus);
+    EXPECT_EQ(pixel(ppu, 0U, kLine), PPU::kWhite);
+
+    // Skip-render leaves the framebuffer alone
+    ppu.set_render_enabled(false);
+    set_dispcnt(bus, PPU::kMode3 | PPU::kDispcntBg2);
+    ppu.render_line(kLine, bus);
+    EXPECT_EQ(pixel(ppu, 0U, kLine), PPU::kWhite);
+}
@@ -0,0 +1,110 @@
+// tests/ppu_convert.cpp
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "core/ppu/pixel_convert.h"
+#include "core/ppu/ppu.h"
+
+using gba::PPU;
+
+namespace {
+    constexpr std::uint16_t kRed = 0x001FU;
+    constexpr std::uint16_t kGreen = 0x03E0U;
+    constexpr std::uint16_t kBlue = 0x7C00U;
+    constexpr std::uint16_t kWhite = 0x7FFFU;
+    constexpr std::uint32_t kPadding = 0xDEADBEEFU;
+    constexpr std::size_t kBytesPerPixel = sizeof(std::uint32_t);
+} // namespace
+
+TEST(PixelConvert, ExpandsEachChannelToEightBits) {
+    EXPECT_EQ(gba::bgr555_to_xrgb8888(0U), 0x00000000U);
+    EXPECT_EQ(gba::bgr555_to_xrgb8888(kRed), 0x00FF0000U);
+    EXPECT_EQ(gba::bgr555_to_xrgb8888(kGreen), 0x0000FF00U);
+    EXPECT_EQ(gba::bgr555_to_xrgb8888(kBlue), 0x000000FFU);
+    EXPECT_EQ(gba::bgr555_to_xrgb8888(kWhite | 0x8000U), 0x00FFFFFFU); // bit 15 ignored
+    EXPECT_EQ(gba::bgr555_to_xrgb8888(0x0010U), 0x00840000U);         // 0b10000 -> 0b10000100
+    EXPECT_EQ(gba::bgr555_to_xrgb8888(0x0001U), 0x00080000U);         // 0b00001 -> 0b00001000
+}
+
+TEST(PixelConvert, ConvertsAFrameIntoAPitchedDestination) {
+    constexpr std::size_t kPadPixels = 16U; // texture rows are often padded to an alignment
+    constexpr std::size_t kPitch = (PPU::kScreenWidth + kPadPixels) * kBytesPerPixel;
+    std::vector<std::uint16_t> frame(PPU::kPixels);
+    for (std::size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<std::uint16_t>(i * 7U);
+    }
+    std::vector<std::uint32_t> texture((kPitch / kBytesPerPixel) * PPU::kScreenHeight, kPadding);
+
+    gba::convert_xrgb8888(frame, PPU::kScreenWidth, PPU::kScreenHeight, texture.data(), kPitch);
+    for (std::size_t y = 0; y < PPU::kScreenHeight; ++y) {
+        const std::size_t row = y * (kPitch / kBytesPerPixel);
+        for (std::size_t x = 0; x < PPU::kScreenWidth; ++x) {
+            ASSERT_EQ(texture[row + x], gba::bgr555_to_xrgb8888(frame[(y * PPU::kScreenWidth) + x]))
+                << x << ',' << y;
+        }
+        for (std::size_t x = PPU::kScreenWidth; x < PPU::kScreenWidth + kPadPixels; ++x) {
+            ASSERT_EQ(texture[row + x], kPadding) << "padding written at " << x << ',' << y;
+        }
+    }
+}
+
+TEST(PixelConvert, TightPitchMatchesPerPixelConversion) {
+    std::vector<std::uint16_t> frame(PPU::kPixels, kGreen);
+    frame.back() = kRed;
+    std::vector<std::uint32_t> texture(PPU::kPixels);
+    gba::convert_xrgb8888(frame, PPU::kScreenWidth, PPU::kScreenHeight, texture.data(),
+                          PPU::kScreenWidth * kBytesPerPixel);
+    EXPECT_EQ(texture.front(), 0x0000FF00U);
+    EXPECT_EQ(texture.back(), 0x00FF0000U);
+}
+
+TEST(PixelConvert, FormatSizes) {
+    EXPECT_EQ(gba::pixel_format_bytes(gba::PixelFormat::BGR555, PPU::kScreenWidth, PPU::kScreenHeight),
+              PPU::kPixels * 2U);
+    EXPECT_EQ(gba::pixel_format_bytes(gba::PixelFormat::XRGB8888, PPU::kScreenWidth, PPU::kScreenHeight),
+              PPU::kPixels * 4U);
+    EXPECT_EQ(gba::pixel_format_bytes(gba::PixelFormat::RGB24, PPU::kScreenWidth, PPU::kScreenHeight),
+              PPU::kPixels * 3U);
+    EXPECT_EQ(gba::pixel_format_bytes(gba::PixelFormat::YUV420, PPU::kScreenWidth, PPU::kScreenHeight),
+              PPU::kPixels * 3U / 2U);
+    EXPECT_EQ(gba::pixel_format_bytes(gba::PixelFormat::YUV420, 3U, 2U), 0U); // odd width
+}
+
+TEST(PixelConvert, PackedLinesKeepChannelOrder) {
+    const std::vector<std::uint16_t> line{kRed, kGreen, kBlue | 0x8000U};
+    std::vector<std::uint8_t> rgb(line.size() * 3U);
+    gba::convert_line(gba::PixelFormat::RGB24, line, rgb.data());
+    EXPECT_EQ(rgb, (std::vector<std::uint8_t>{0xFFU, 0U, 0U, 0U, 0xFFU, 0U, 0U, 0U, 0xFFU}));
+
+    std::vector<std::uint8_t> raw(line.size() * 2U);
+    gba::convert_line(gba::PixelFormat::BGR555, line, raw.data());
+    EXPECT_EQ(raw, (std::vector<std::uint8_t>{0x1FU, 0x00U, 0xE0U, 0x03U, 0x00U, 0xFCU})); // little-endian, as stored
+}
+
+TEST(PixelConvert, Yuv420IsLimitedRangeWithSubsampledChroma) {
+    constexpr std::size_t kWidth = 4U;
+    constexpr std::size_t kHeight = 2U;
+    constexpr std::uint8_t kBlackY = 16U;
+    constexpr std::uint8_t kWhiteY = 235U;
+    constexpr std::uint8_t kNeutral = 128U;
+    EXPECT_EQ(gba::bgr555_to_y(0U), kBlackY);
+    EXPECT_EQ(gba::bgr555_to_y(kWhite), kWhiteY);
+
+    // Left 2x2 block grey (black/white mix), right block pure red
+    const std::vector<std::uint16_t> frame{0U, kWhite, kRed, kRed, kWhite, 0U, kRed, kRed};
+    std::vector<std::uint8_t> yuv(gba::pixel_format_bytes(gba::PixelFormat::YUV420, kWidth, kHeight), 0xAAU);
+    ASSERT_TRUE(gba::convert_frame(gba::PixelFormat::YUV420, frame, kWidth, kHeight, yuv));
+    EXPECT_EQ(yuv[0], kBlackY);
+    EXPECT_EQ(yuv[1], kWhiteY);
+    EXPECT_EQ(yuv[4], kWhiteY);
+    const std::uint8_t *u = &yuv[kWidth * kHeight];
+    const std::uint8_t *v = u + 2;
+    EXPECT_EQ(u[0], kNeutral);
+    EXPECT_EQ(v[0], kNeutral);
+    EXPECT_EQ(u[1], 90U);  // red: blue-difference below neutral
+    EXPECT_EQ(v[1], 240U); // red: full-scale red-difference
+    EXPECT_FALSE(gba::convert_frame(gba::PixelFormat::YUV420, frame, kWidth, kHeight,
+                                    std::span(yuv).first(yuv.size() - 1U)));
+}
@@ -0,0 +1,148 @@
+// tests/ppu_observation.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include "core/bus/bus.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+
+using gba::Bus;
+using gba::IORegs;
+using gba::MMU;
+using gba::ObservationConfig;
+using gba::ObservationFormat;
+using gba::PPU;
+
+namespace {
+    constexpr std::uint16_t kRed = 0x001FU;
+    constexpr std::uint16_t kGreen = 0x03E0U;
+    constexpr std::uint16_t kBlue = 0x7C00U;
+    constexpr std::uint16_t kWhite = 0x7FFFU;
+    constexpr std::uint8_t kLumaRed = 77U; // BT.601 weights of full-scale channels
+    constexpr std::uint8_t kLumaGreen = 149U;
+    constexpr std::uint8_t kLumaBlue = 29U;
+    constexpr std::uint32_t kAgentSize = 84U;
+
+    void set_dispcnt(Bus &bus, std::uint16_t value) { bus.write16(MMU::IO_BASE + IORegs::kOffDISPCNT, value); }
+
+    void put_pixel(Bus &bus, std::uint32_t x, std::uint32_t y, std::uint16_t color) {
+        bus.write16(MMU::VRAM_BASE + (((y * PPU::kScreenWidth) + x) * 2U), color);
+    }
+
+    void render_frame(PPU &ppu, const Bus &bus) {
+        for (std::uint16_t line = 0; line < PPU::kScreenHeight; ++line) {
+            ppu.render_line(line, bus);
+        }
+    }
+
+    auto observe(PPU &ppu, ObservationFormat format, std::uint32_t width, std::uint32_t height) -> bool {
+        return ppu.set_observation(ObservationConfig{format, width, height});
+    }
+} // namespace
+
+TEST(PPUObservation, Gray8AtFullSizeIsTheLumaOfEachPixel) {
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    ASSERT_TRUE(observe(ppu, ObservationFormat::Gray8, PPU::kScreenWidth, PPU::kScreenHeight));
+    set_dispcnt(bus, PPU::kMode3 | PPU::kDispcntBg2);
+    put_pixel(bus, 0U, 0U, kRed);
+    put_pixel(bus, 1U, 0U, kGreen);
+    put_pixel(bus, 2U, 50U, kBlue);
+    put_pixel(bus, 239U, 159U, kWhite);
+
+    render_frame(ppu, bus);
+    const auto gray = ppu.observation();
+    ASSERT_EQ(gray.size(), PPU::kPixels);
+    EXPECT_EQ(gray[0], kLumaRed);
+    EXPECT_EQ(gray[1], kLumaGreen);
+    EXPECT_EQ(gray[(50U * PPU::kScreenWidth) + 2U], kLumaBlue);
+    EXPECT_EQ(gray[PPU::kPixels - 1U], 255U);
+    EXPECT_EQ(gray[3], 0U);
+}
+
+TEST(PPUObservation, Gray8DownscalesByAveragingBoxes) {
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    ASSERT_TRUE(observe(ppu, ObservationFormat::Gray8, kAgentSize, kAgentSize));
+    set_dispcnt(bus, PPU::kMode3 | PPU::kDispcntBg2);
+    // Left half white; one 3x2 source box of column 0 (x 0..2, y 0..1) gets one black pixel
+    for (std::uint32_t y = 0; y < PPU::kScreenHeight; ++y) {
+        for (std::uint32_t x = 0; x < PPU::kScreenWidth / 2U; ++x) {
+            put_pixel(bus, x, y, kWhite);
+        }
+    }
+    put_pixel(bus, 1U, 1U, 0U);
+
+    render_frame(ppu, bus);
+    const auto gray = ppu.observation();
+    ASSERT_EQ(gray.size(), std::size_t{kAgentSize} * kAgentSize);
+    EXPECT_EQ(gray[0], (255U * 5U + 3U) / 6U); // five of six white, rounded
+    for (std::uint32_t y = 1; y < kAgentSize; ++y) {
+        for (std::uint32_t x = 0; x < kAgentSize; ++x) {
+            // Output column 42 starts exactly at source column 120
+            EXPECT_EQ(gray[(y * kAgentSize) + x], x < kAgentSize / 2U ? 255U : 0U) << x << "," << y;
+        }
+    }
+}
+
+TEST(PPUObservation, PaletteIndicesAreSampledFromMode4) {
+    constexpr std::uint32_t kHalfWidth = PPU::kScreenWidth / 2U;
+    constexpr std::uint32_t kHalfHeight = PPU::kScreenHeight / 2U;
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    ASSERT_TRUE(observe(ppu, ObservationFormat::PaletteIndex8, kHalfWidth, kHalfHeight));
+    set_dispcnt(bus, PPU::kMode4 | PPU::kDispcntBg2);
+    for (std::uint32_t y = 0; y < PPU::kScreenHeight; ++y) {
+        for (std::uint32_t x = 0; x < PPU::kScreenWidth; ++x) {
+            bus.write8(MMU::VRAM_BASE + (y * PPU::kScreenWidth) + x, static_cast<std::uint8_t>(x + y));
+        }
+    }
+
+    render_frame(ppu, bus);
+    const auto indices = ppu.observation();
+    ASSERT_EQ(indices.size(), std::size_t{kHalfWidth} * kHalfHeight);
+    for (std::uint32_t y = 0; y < kHalfHeight; ++y) {
+        for (std::uint32_t x = 0; x < kHalfWidth; ++x) {
+            EXPECT_EQ(indices[(y * kHalfWidth) + x], static_cast<std::uint8_t>((2U * x) + (2U * y)));
+        }
+    }
+
+    // Direct colour has no indices
+    set_dispcnt(bus, PPU::kMode3 | PPU::kDispcntBg2);
+    render_frame(ppu, bus);
+    EXPECT_TRUE(std::ranges::all_of(ppu.observation(), [](std::uint8_t index) { return index == 0U; }));
+}
+
+TEST(PPUObservation, ColourOutputCanBeSkipped) {
+    Bus bus;
+    bus.reset();
+    PPU ppu;
+    ppu.set_color_output(false);
+    ASSERT_TRUE(observe(ppu, ObservationFormat::Gray8, kAgentSize, kAgentSize));
+    set_dispcnt(bus, PPU::kMode3 | PPU::kDispcntBg2 | PPU::kDispcntForcedBlank);
+
+    render_frame(ppu, bus);
+    EXPECT_TRUE(std::ranges::all_of(ppu.framebuffer(), [](std::uint16_t pixel) { return pixel == 0U; }));
+    EXPECT_TRUE(std::ranges::all_of(ppu.observation(), [](std::uint8_t gray) { return gray == 255U; }));
+
+    ppu.set_color_output(true);
+    render_frame(ppu, bus);
+    EXPECT_EQ(ppu.framebuffer()[0], kWhite);
+}
+
+TEST(PPUObservation, RejectsBadSizesAndKeepsTheOldSetting) {
+    PPU ppu;
+    EXPECT_TRUE(ppu.observation().empty()); // None by default
+    ASSERT_TRUE(observe(ppu, ObservationFormat::Gray8, kAgentSize, kAgentSize));
+    EXPECT_FALSE(observe(ppu, ObservationFormat::Gray8, 0U, kAgentSize));
+    EXPECT_FALSE(observe(ppu, ObservationFormat::Gray8, kAgentSize, PPU::kScreenHeight + 1U));
+    EXPECT_EQ(ppu.observation_config().width, kAgentSize);
+    EXPECT_EQ(ppu.observation().size(), std::size_t{kAgentSize} * kAgentSize);
+
+    ASSERT_TRUE(observe(ppu, ObservationFormat::None, kAgentSize, kAgentSize));
+    EXPECT_TRUE(ppu.observation().empty());
+}
@@ -0,0 +1,89 @@
+// tests/ppu_output_format.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "core/bus/bus.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/pixel_convert.h"
+#include "core/ppu/ppu.h"
+
+using gba::Bus;
+using gba::IORegs;
+using gba::MMU;
+using gba::PixelFormat;
+using gba::PPU;
+
+namespace {
+    constexpr std::uint16_t kFirstColor = 0x1234U;
+
+    void render_frame(PPU &ppu, const Bus &bus) {
+        for (std::uint16_t line = 0; line < PPU::kScreenHeight; ++line) {
+            ppu.render_line(line, bus);
+        }
+    }
+
+    // Mode 3 with every pixel different, so row/plane offsets and chroma pairing all show up
+    void draw_gradient(Bus &bus) {
+        bus.write16(MMU::IO_BASE + IORegs::kOffDISPCNT, PPU::kMode3 | PPU::kDispcntBg2);
+        for (std::uint32_t i = 0; i < PPU::kPixels; ++i) {
+            bus.write16(MMU::VRAM_BASE + (i * 2U), static_cast<std::uint16_t>(kFirstColor + (i * 37U)));
+        }
+    }
+} // namespace
+
+TEST(PPUOutputFormat, EveryFormatMatchesConvertingTheFinishedFrame) {
+    Bus bus;
+    bus.reset();
+    draw_gradient(bus);
+    PPU reference;
+    render_frame(reference, bus);
+
+    for (const PixelFormat format :
+         {PixelFormat::BGR555, PixelFormat::XRGB8888, PixelFormat::RGB24, PixelFormat::YUV420}) {
+        std::vector<std::uint8_t> expected(gba::pixel_format_bytes(format, PPU::kScreenWidth, PPU::kScreenHeight));
+        ASSERT_TRUE(gba::convert_frame(format, reference.framebuffer(), PPU::kScreenWidth, PPU::kScreenHeight,
+                                       expected));
+        PPU ppu;
+        ppu.set_output_format(format);
+        render_frame(ppu, bus);
+        EXPECT_EQ(ppu.output_format(), format);
+        ASSERT_EQ(ppu.output().size(), expected.size()) << static_cast<int>(format);
+        EXPECT_TRUE(std::ranges::equal(ppu.output(), expected)) << static_cast<int>(format);
+    }
+}
+
+TEST(PPUOutputFormat, OtherFormatsLeaveTheFramebufferAlone) {
+    Bus bus;
+    bus.reset();
+    draw_gradient(bus);
+    PPU ppu;
+    ppu.set_output_format(PixelFormat::RGB24);
+    render_frame(ppu, bus);
+    EXPECT_TRUE(std::ranges::all_of(ppu.framebuffer(), [](std::uint16_t pixel) { return pixel == 0U; }));
+
+    // Back to BGR555: output() is the framebuffer itself
+    ppu.set_output_format(PixelFormat::BGR555);
+    render_frame(ppu, bus);
+    ASSERT_EQ(ppu.output().size(), PPU::kPixels * 2U);
+    EXPECT_EQ(ppu.output().data(), static_cast<const void *>(ppu.framebuffer().data()));
+    EXPECT_EQ(ppu.framebuffer()[0], kFirstColor);
+}
+
+TEST(PPUOutputFormat, ResetAndColourSkipApplyToTheOutput) {
+    Bus bus;
+    bus.reset();
+    draw_gradient(bus);
+    PPU ppu;
+    ppu.set_output_format(PixelFormat::XRGB8888);
+    ppu.set_color_output(false);
+    render_frame(ppu, bus);
+    EXPECT_TRUE(std::ranges::all_of(ppu.output(), [](std::uint8_t byte) { return byte == 0U; }));
+
+    ppu.set_color_output(true);
+    render_frame(ppu, bus);
+    EXPECT_FALSE(std::ranges::all_of(ppu.output(), [](std::uint8_t byte) { return byte == 0U; }));
+    ppu.reset();
+    EXPECT_TRUE(std::ranges::all_of(ppu.output(), [](std::uint8_t byte) { return byte == 0U; }));
+}
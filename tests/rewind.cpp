@@ -0,0 +1,226 @@
+// tests/rewind.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/state/lz.h"
+#include "core/state/rewind.h"
+#include "core/system/system.h"
+
+using gba::lz_compress;
+using gba::lz_decompress;
+using gba::MMU;
+using gba::RewindBuffer;
+using gba::RewindConfig;
+using gba::System;
+
+namespace {
+    using Bytes = std::vector<std::uint8_t>;
+
+    constexpr std::size_t kStateBytes = 64U * 1024U;
+    constexpr std::uint32_t kSeed = 0x5EEDU;
+
+    auto random_bytes(std::size_t size, std::uint32_t seed) -> Bytes {
+        std::mt19937 rng(seed);
+        Bytes out(size);
+        for (auto &b : out) {
+            b = static_cast<std::uint8_t>(rng());
+        }
+        return out;
+    }
+
+    auto round_trip(const Bytes &input) -> Bytes {
+        Bytes packed;
+        lz_compress(input, packed);
+        Bytes unpacked(input.size());
+        EXPECT_TRUE(lz_decompress(packed, unpacked));
+        return unpacked;
+    }
+
+    // A "frame" touches a few bytes of the previous one, like a running game.
+    auto next_frame(const Bytes &previous, std::uint32_t frame) -> Bytes {
+        constexpr std::size_t kTouchedPerFrame = 64U;
+        constexpr std::size_t kStride = 977U; // prime: spreads the writes
+        Bytes next = previous;
+        for (std::size_t i = 0; i < kTouchedPerFrame; ++i) {
+            next[(frame * kTouchedPerFrame + i) * kStride % next.size()] ^= static_cast<std::uint8_t>(frame + i + 1U);
+        }
+        return next;
+    }
+} // namespace
+
+// ---------------- LZ codec ----------------
+
+TEST(LzCodec, RoundTripsEdgeCases) {
+    EXPECT_EQ(round_trip({}), Bytes{});
+    EXPECT_EQ(round_trip({0x42U}), Bytes{0x42U});
+
+    const Bytes noise = random_bytes(kStateBytes, kSeed);
+    EXPECT_EQ(round_trip(noise), noise);
+
+    Bytes mixed(kStateBytes, 0U); // zero runs broken up by short literals and repeats
+    for (std::size_t i = 0; i < mixed.size(); i += 1000U) {
+        mixed[i] = static_cast<std::uint8_t>(i);
+        mixed[i + 1U] = 0xABU;
+    }
+    EXPECT_EQ(round_trip(mixed), mixed);
+}
+
+TEST(LzCodec, ZeroRunsCollapse) {
+    const Bytes zeros(kStateBytes, 0U);
+    Bytes packed;
+    lz_compress(zeros, packed);
+    EXPECT_LT(packed.size(), kStateBytes / 100U);
+}
+
+TEST(LzCodec, RejectsMalformedBlocks) {
+    const Bytes input = random_bytes(1024U, kSeed);
+    Bytes packed;
+    lz_compress(input, packed);
+
+    Bytes wrongSize(input.size() + 1U);
+    EXPECT_FALSE(lz_decompress(packed, wrongSize));
+
+    Bytes out(input.size());
+    const Bytes truncated(packed.begin(), packed.end() - 1);
+    EXPECT_FALSE(lz_decompress(truncated, out));
+
+    const Bytes badOffset{0x00U, 0x10U, 0x00U}; // match before any output
+    Bytes four(4U);
+    EXPECT_FALSE(lz_decompress(badOffset, four));
+}
+
+// ---------------- Rewind buffer ----------------
+
+TEST(Rewind, StepsBackThroughEveryFrameInOrder) {
+    constexpr std::uint32_t kFrames = 50U;
+    RewindBuffer rewind;
+    std::vector<Bytes> frames{random_bytes(kStateBytes, kSeed)};
+    for (std::uint32_t f = 1; f < kFrames; ++f) {
+        frames.push_back(next_frame(frames.back(), f));
+    }
+    for (const auto &frame : frames) {
+        rewind.push(frame);
+    }
+    rewind.flush();
+    EXPECT_EQ(rewind.size(), kFrames);
+    EXPECT_LT(rewind.compressed_bytes(), kFrames * kStateBytes / 20U); // deltas, not copies
+
+    Bytes restored;
+    for (std::uint32_t f = kFrames - 1U; f > 0U; --f) {
+        ASSERT_TRUE(rewind.step_back(restored));
+        ASSERT_EQ(restored, frames[f - 1U]) << "frame " << (f - 1U);
+    }
+    EXPECT_FALSE(rewind.step_back(restored));
+    EXPECT_EQ(rewind.size(), 1U);
+}
+
+TEST(Rewind, RespectsSnapshotAndByteBounds) {
+    constexpr std::size_t kKeep = 8U;
+    RewindBuffer bySnapshots(RewindConfig{kKeep, std::size_t{1} << 30U});
+    RewindBuffer byBytes(RewindConfig{1000U, 4096U});
+
+    Bytes frame = random_bytes(kStateBytes, kSeed);
+    for (std::uint32_t f = 1; f <= 40U; ++f) {
+        frame = next_frame(frame, f);
+        bySnapshots.push(frame);
+        byBytes.push(frame);
+    }
+    bySnapshots.flush();
+    byBytes.flush();
+    EXPECT_EQ(bySnapshots.size(), kKeep);
+    EXPECT_LE(byBytes.compressed_bytes(), 4096U);
+    EXPECT_GE(byBytes.size(), 2U);
+}
+
+// A scene change (incompressible deltas) followed by ordinary frames: the small deltas
+// must not keep the large buffers' capacity alive, or the heap grows past max_bytes.
+TEST(Rewind, LargeDeltaBurstDoesNotPinCapacity) {
+    constexpr std::size_t kBudget = std::size_t{256} << 10U;
+    constexpr std::uint32_t kBurst = 40U; // far past the budget: most of these are evicted and recycled
+    constexpr std::uint32_t kQuiet = 300U;
+    RewindBuffer rewind(RewindConfig{1000U, kBudget});
+    // Worst case for a spare buffer is one incompressible delta (the state plus LZ overhead)
+    constexpr std::size_t kBound = kBudget + (RewindBuffer::kMaxSpareDeltas * 2U * kStateBytes);
+
+    Bytes frame;
+    for (std::uint32_t f = 0; f < kBurst; ++f) {
+        frame = random_bytes(kStateBytes, kSeed + f);
+        rewind.push(frame);
+    }
+    rewind.flush();
+    EXPECT_LE(rewind.retained_bytes(), kBound); // evicted buffers are not all kept as spares
+
+    for (std::uint32_t f = 1; f <= kQuiet; ++f) {
+        frame = next_frame(frame, f);
+        rewind.push(frame);
+    }
+    rewind.flush();
+
+    EXPECT_LE(rewind.compressed_bytes(), kBudget);
+    EXPECT_LE(rewind.retained_bytes(), kBound);
+    EXPECT_GT(rewind.size(), kQuiet / 2U); // small deltas are billed at their own size
+
+    Bytes restored;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(rewind.step_back(restored));
+    }
+    EXPECT_LE(rewind.retained_bytes(), kBound);
+}
+
+TEST(Rewind, ClearKeepsOnlyAFewSpareBuffers) {
+    constexpr std::uint32_t kFrames = 16U;
+    RewindBuffer rewind;
+    for (std::uint32_t f = 0; f < kFrames; ++f) {
+        rewind.push(random_bytes(kStateBytes, kSeed + f));
+    }
+    rewind.flush();
+    EXPECT_GT(rewind.retained_bytes(), RewindBuffer::kMaxSpareDeltas * 2U * kStateBytes);
+
+    rewind.clear();
+    EXPECT_LE(rewind.retained_bytes(), RewindBuffer::kMaxSpareDeltas * 2U * kStateBytes);
+}
+
+TEST(Rewind, SizeChangeRestartsHistory) {
+    RewindBuffer rewind;
+    rewind.push(Bytes(kStateBytes, 1U));
+    rewind.push(Bytes(kStateBytes, 2U));
+    rewind.push(Bytes(kStateBytes / 2U, 3U));
+    rewind.flush();
+    EXPECT_EQ(rewind.size(), 1U);
+
+    rewind.clear();
+    EXPECT_EQ(rewind.size(), 0U);
+    EXPECT_EQ(rewind.compressed_bytes(), 0U);
+}
+
+// End to end: a running System rewound a few frames matches what was saved there.
+TEST(Rewind, RestoresSystemFrames) {
+    constexpr int kFrames = 10;
+    constexpr int kBack = 3;
+    System sys;
+    sys.reset();
+    RewindBuffer rewind;
+    std::vector<std::uint64_t> cyclesAt;
+    std::vector<std::uint8_t> ewramAt;
+
+    Bytes state;
+    for (int f = 0; f < kFrames; ++f) {
+        sys.bus().write8(MMU::EWRAM_BASE + static_cast<std::uint32_t>(f), static_cast<std::uint8_t>(f + 1));
+        sys.run_frame();
+        sys.save_state(state);
+        rewind.push(state);
+        cyclesAt.push_back(sys.cycles());
+        ewramAt.push_back(sys.bus().read8(MMU::EWRAM_BASE + static_cast<std::uint32_t>(f)));
+    }
+
+    for (int i = 0; i < kBack; ++i) {
+        ASSERT_TRUE(rewind.step_back(state));
+    }
+    ASSERT_TRUE(sys.load_state(state));
+    const auto target = static_cast<std::size_t>(kFrames - 1 - kBack);
+    EXPECT_EQ(sys.cycles(), cyclesAt[target]);
+    EXPECT_EQ(sys.bus().read8(MMU::EWRAM_BASE + static_cast<std::uint32_t>(target)), ewramAt[target]);
+    EXPECT_EQ(sys.bus().read8(MMU::EWRAM_BASE + static_cast<std::uint32_t>(target + 1U)), 0U); // written later
+}
@@ -0,0 +1,128 @@
+// tests/rom_image.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/mmu/rom_image.h"
+#include "core/system/system.h"
+
+using gba::MemoryFootprint;
+using gba::MMU;
+using gba::RomCache;
+using gba::RomImage;
+using gba::System;
+
+namespace {
+    constexpr std::size_t kRomBytes = 64U * 1024U;
+    constexpr std::size_t kShortBios = 0x100U;
+    constexpr std::uint8_t kFill = 0xA5U;
+
+    // Scratch file removed on both ends
+    class TempFile {
+      public:
+        explicit TempFile(const std::string &name) : path_(std::filesystem::temp_directory_path() / name) {
+            std::filesystem::remove(path_);
+        }
+        TempFile(const TempFile &) = delete;
+        auto operator=(const TempFile &) -> TempFile & = delete;
+        TempFile(TempFile &&) = delete;
+        auto operator=(TempFile &&) -> TempFile & = delete;
+        ~TempFile() { std::filesystem::remove(path_); }
+
+        [[nodiscard]] auto path() const -> const std::filesystem::path & { return path_; }
+        void write(std::size_t bytes, std::uint8_t seed) const {
+            std::vector<char> data(bytes);
+            for (std::size_t i = 0; i < bytes; ++i) {
+                data[i] = static_cast<char>(seed + i);
+            }
+            std::ofstream(path_, std::ios::binary | std::ios::trunc)
+                .write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+
+      private:
+        std::filesystem::path path_;
+    };
+} // namespace
+
+TEST(RomImage, LoadsFilesWithAnOptionalLimit) {
+    const TempFile file("gba_rom_image_test.gba");
+    file.write(kRomBytes, 1U);
+    const auto whole = RomImage::load(file.path());
+    ASSERT_NE(whole, nullptr);
+    EXPECT_EQ(whole->size(), kRomBytes);
+    EXPECT_EQ((*whole)[0], 1U);
+    EXPECT_EQ((*whole)[kRomBytes - 1U], static_cast<std::uint8_t>(1U + kRomBytes - 1U));
+
+    const auto bios = RomImage::load(file.path(), MMU::BIOS_SIZE);
+    ASSERT_NE(bios, nullptr);
+    EXPECT_EQ(bios->size(), MMU::BIOS_SIZE);
+
+    EXPECT_EQ(RomImage::load(file.path().string() + ".missing"), nullptr);
+    const std::vector<std::uint8_t> bytes(3U, kFill);
+    EXPECT_EQ(RomImage::copy_of(bytes)->size(), 3U);
+}
+
+TEST(RomCache, SharesOneImageWhileItIsInUse) {
+    const TempFile file("gba_rom_cache_test.gba");
+    file.write(kRomBytes, 2U);
+    RomCache cache;
+    auto first = cache.load(file.path());
+    const auto viaOtherSpelling = cache.load(file.path().parent_path() / "." / file.path().filename());
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, viaOtherSpelling); // one image per canonical path
+    EXPECT_NE(cache.load(file.path(), MMU::BIOS_SIZE), first); // a different limit is a different image
+    EXPECT_EQ(cache.live(), 1U);
+
+    // The cache holds no reference of its own
+    const std::weak_ptr<const RomImage> watch = first;
+    first.reset();
+    EXPECT_FALSE(viaOtherSpelling == nullptr);
+    EXPECT_FALSE(watch.expired());
+    EXPECT_EQ(cache.live(), 1U);
+
+    // A rewritten file is loaded afresh even while the old image is still in use
+    file.write(kRomBytes / 2U, 3U);
+    const auto rewritten = cache.load(file.path());
+    ASSERT_NE(rewritten, nullptr);
+    EXPECT_NE(rewritten, viaOtherSpelling);
+    EXPECT_EQ(rewritten->size(), kRomBytes / 2U);
+    EXPECT_EQ(cache.load(file.path().string() + ".missing"), nullptr);
+}
+
+TEST(RomImage, InstancesMapOneImageAndReportItAsShared) {
+    const auto rom = RomImage::copy_of(std::vector<std::uint8_t>(kRomBytes, kFill));
+    const auto bios = RomImage::copy_of(std::vector<std::uint8_t>(kShortBios, kFill));
+    auto first = std::make_unique<System>();
+    first->reset();
+    const MemoryFootprint bare = first->memory_footprint();
+    first->set_gamepak(rom);
+    first->set_bios(bios);
+
+    auto second = std::make_unique<System>();
+    second->reset();
+    second->set_gamepak(rom);
+    second->set_bios(bios);
+    EXPECT_EQ(second->bus().read8(MMU::WS0_BASE + kRomBytes - 1U), kFill);
+    EXPECT_EQ(second->bus().read8(MMU::BIOS_BASE), kFill);
+    EXPECT_EQ(second->bus().read8(MMU::BIOS_BASE + kShortBios), 0U); // short BIOS: zero tail
+    EXPECT_EQ(rom.use_count(), 3);
+
+    // Images mapped by several owners count as shared; nothing private is added
+    const MemoryFootprint shared = first->memory_footprint();
+    EXPECT_EQ(shared.private_bytes, bare.private_bytes);
+    EXPECT_EQ(shared.shared_bytes, bare.shared_bytes + kRomBytes + kShortBios);
+    EXPECT_EQ(second->memory_footprint().private_bytes, shared.private_bytes);
+    EXPECT_GE(shared.private_bytes, MMU::EWRAM_SIZE + MMU::IWRAM_SIZE + MMU::VRAM_SIZE);
+
+    // A fork shares its parent's RAM pages as well; reset unmaps the images
+    const auto child = first->fork();
+    EXPECT_GT(child->memory_footprint().shared_bytes, shared.shared_bytes + MMU::EWRAM_SIZE);
+    first->reset();
+    EXPECT_EQ(first->bus().read8(MMU::BIOS_BASE), MMU::kOpenBus);
+    EXPECT_EQ(first->bus().gamepak_image(), nullptr);
+    EXPECT_EQ(child->bus().gamepak_image(), rom);
+}
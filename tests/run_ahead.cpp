@@ -0,0 +1,196 @@
+// tests/run_ahead.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#include "core/apu/apu.h"
+#include "core/backup/backup.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/run_ahead.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::APU;
+using gba::AudioMode;
+using gba::Backup;
+using gba::IORegs;
+using gba::MMU;
+using gba::PPU;
+using gba::RunAhead;
+using gba::System;
+using gba::test::counter_program;
+using gba::test::kToTopByte;
+using gba::test::load_program;
+using gba::test::Thumb_ADD_imm;
+using gba::test::Thumb_B_off11;
+using gba::test::Thumb_LSL_imm;
+using gba::test::Thumb_MOV_imm;
+using gba::test::Thumb_STRB_imm;
+
+namespace {
+    constexpr std::uint16_t kVramHighByte = 0x06U;
+    constexpr std::uint16_t kMode3Bg2 = PPU::kMode3 | PPU::kDispcntBg2;
+
+    // Mode 3 with r1 = VRAM_BASE; loop { r0 += 1; pixel(0,0) low byte = r0 }
+    // The PPU samples the counter at line 0's HBlank, so every frame looks different.
+    void boot_counter(System &sys) {
+        sys.reset();
+        sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, kMode3Bg2);
+        load_program(sys, counter_program(kVramHighByte));
+    }
+
+    // r1 = 0x0E; r2 = SRAM_BASE; loop { r0 += 1; SRAM[0] = r0 }: every frame writes the save chip
+    constexpr std::uint16_t kSramHighByte = 0x0EU;
+    void boot_sram_counter(System &sys) {
+        sys.reset();
+        std::vector<std::uint8_t> rom(0x400U, 0x00U);
+        constexpr std::string_view kSram = "SRAM_V113";
+        std::copy(kSram.begin(), kSram.end(), rom.begin() + 0x200);
+        sys.load_gamepak(rom);
+        constexpr std::int16_t kBackToAdd = -8; // B at +8 targets +4 (PC reads as +12)
+        const std::array<std::uint16_t, 5> program{
+            Thumb_MOV_imm(1U, kSramHighByte), Thumb_LSL_imm(2U, 1U, kToTopByte), Thumb_ADD_imm(0U, 1U),
+            Thumb_STRB_imm(0U, 2U, 0U), Thumb_B_off11(kBackToAdd)};
+        load_program(sys, program);
+    }
+
+    auto same_picture(const System &a, const System &b) -> bool {
+        return std::ranges::equal(a.ppu().framebuffer(), b.ppu().framebuffer());
+    }
+
+    constexpr std::uint32_t kAhead = 2U;
+} // namespace
+
+TEST(RunAhead, ShowsTheFrameKAheadButStaysOnTheRealTimeline) {
+    System sys;
+    boot_counter(sys);
+    RunAhead runAhead(sys);
+    runAhead.set_frames(kAhead);
+
+    System future;
+    boot_counter(future);
+    for (std::uint32_t i = 0; i < 1U + kAhead; ++i) {
+        future.run_frame();
+    }
+
+    ASSERT_TRUE(runAhead.run_frame(0U));
+    EXPECT_TRUE(same_picture(sys, future));
+    EXPECT_EQ(sys.frame(), 1U);
+    EXPECT_EQ(sys.cycles(), System::kCyclesPerFrame);
+}
+
+TEST(RunAhead, RealTimelineMatchesPlainEmulation) {
+    constexpr int kHostFrames = 5;
+    System sys;
+    boot_counter(sys);
+    RunAhead runAhead(sys);
+    runAhead.set_frames(kAhead);
+
+    System plain;
+    boot_counter(plain);
+    for (int i = 0; i < kHostFrames; ++i) {
+        ASSERT_TRUE(runAhead.run_frame(IORegs::kKeyA));
+        plain.bus().io().set_keys_pressed(IORegs::kKeyA);
+        plain.run_frame();
+    }
+    EXPECT_EQ(sys.cycles(), plain.cycles());
+    EXPECT_EQ(sys.cpu().debug_reg(0), plain.cpu().debug_reg(0));
+    EXPECT_EQ(sys.cpu().debug_pc(), plain.cpu().debug_pc());
+    EXPECT_EQ(sys.bus().read16(MMU::IO_BASE + IORegs::kOffKEYINPUT),
+              static_cast<std::uint16_t>(IORegs::kKeyMask & ~IORegs::kKeyA));
+}
+
+TEST(RunAhead, ZeroFramesIsPlainEmulation) {
+    System sys;
+    boot_counter(sys);
+    RunAhead runAhead(sys);
+
+    System plain;
+    boot_counter(plain);
+    ASSERT_TRUE(runAhead.run_frame(0U));
+    plain.run_frame();
+    EXPECT_TRUE(same_picture(sys, plain));
+}
+
+// Hidden frames are silent: only the real frame's audio reaches the host.
+TEST(RunAhead, KeepsAudioOfTheRealFrameOnly) {
+    constexpr std::uint16_t kMasterEnable = APU::kCntXMasterEnable;
+    System sys;
+    boot_counter(sys);
+    sys.bus().write16(MMU::IO_BASE + APU::kOffSOUNDCNT_X, kMasterEnable);
+    RunAhead runAhead(sys);
+    runAhead.set_frames(kAhead);
+
+    System plain;
+    boot_counter(plain);
+    plain.bus().write16(MMU::IO_BASE + APU::kOffSOUNDCNT_X, kMasterEnable);
+
+    ASSERT_TRUE(runAhead.run_frame(0U));
+    plain.run_frame();
+    EXPECT_EQ(sys.bus().apu().output().size(), plain.bus().apu().output().size());
+    EXPECT_EQ(sys.bus().apu().mode(), AudioMode::Full);
+    EXPECT_TRUE(sys.ppu().render_enabled());
+}
+
+// A frame is not a whole number of mixer periods: the restore each frame must keep the
+// mixer phase, or every frame loses the fraction of a sample it carried over.
+TEST(RunAhead, AudioStreamMatchesPlainEmulationAcrossFrames) {
+    constexpr int kHostFrames = 8; // well within APU::kOutputFrames undrained
+    System sys;
+    boot_counter(sys);
+    sys.bus().write16(MMU::IO_BASE + APU::kOffSOUNDCNT_X, APU::kCntXMasterEnable);
+    RunAhead runAhead(sys);
+    runAhead.set_frames(kAhead);
+
+    System plain;
+    boot_counter(plain);
+    plain.bus().write16(MMU::IO_BASE + APU::kOffSOUNDCNT_X, APU::kCntXMasterEnable);
+    for (int i = 0; i < kHostFrames; ++i) {
+        ASSERT_TRUE(runAhead.run_frame(0U));
+        plain.run_frame();
+    }
+
+    const auto heard = sys.bus().apu().output();
+    const auto expected = plain.bus().apu().output();
+    ASSERT_EQ(heard.size(), expected.size());
+    EXPECT_TRUE(std::ranges::equal(heard, expected, [](const gba::AudioFrame &a, const gba::AudioFrame &b) {
+        return a.left == b.left && a.right == b.right;
+    }));
+}
+
+TEST(RunAhead, FrameCountIsClamped) {
+    System sys;
+    RunAhead runAhead(sys);
+    runAhead.set_frames(RunAhead::kMaxFrames + 10U);
+    EXPECT_EQ(runAhead.frames(), RunAhead::kMaxFrames);
+}
+
+// Hidden frames write the save file too; restoring the snapshot must take those writes back.
+TEST(RunAhead, SpeculativeSaveWritesAreRolledBack) {
+    const auto path = std::filesystem::temp_directory_path() / "gba_run_ahead_test_sram.sav";
+    std::filesystem::remove(path);
+    {
+        System sys;
+        boot_sram_counter(sys);
+        ASSERT_TRUE(sys.bus().backup().attach_file(path));
+        RunAhead runAhead(sys);
+        runAhead.set_frames(kAhead);
+
+        System plain;
+        boot_sram_counter(plain);
+        for (int i = 0; i < 2; ++i) {
+            ASSERT_TRUE(runAhead.run_frame(0U));
+            plain.run_frame();
+        }
+        EXPECT_EQ(sys.cpu().debug_reg(0), plain.cpu().debug_reg(0));
+        EXPECT_NE(plain.bus().read8(MMU::SRAM_BASE), Backup::kErased);
+        EXPECT_EQ(sys.bus().read8(MMU::SRAM_BASE), plain.bus().read8(MMU::SRAM_BASE));
+        EXPECT_TRUE(std::ranges::equal(sys.bus().backup().contents(), plain.bus().backup().contents()));
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,264 @@
+// tests/save_state.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include "core/apu/apu.h"
+#include "core/backup/backup.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/state/state_io.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::APU;
+using gba::Backup;
+using gba::IORegs;
+using gba::MMU;
+using gba::System;
+using gba::test::counter_program;
+using gba::test::load_program;
+using gba::test::state_of;
+
+namespace {
+    constexpr std::uint16_t kEwramHighByte = 0x02U;
+
+    // r1 = EWRAM_BASE; loop { r0 += 1; [r1] = r0 (byte) }
+    void load_counter_program(System &sys) {
+        load_program(sys, counter_program(kEwramHighByte));
+    }
+
+    struct Observed {
+        std::uint32_t r0 = 0;
+        std::uint32_t pc = 0;
+        std::uint8_t ewram0 = 0;
+        std::uint16_t vcount = 0;
+        std::uint64_t cycles = 0;
+
+        auto operator==(const Observed &) const -> bool = default;
+    };
+    auto observe(const System &sys) -> Observed {
+        return Observed{sys.cpu().debug_reg(0), sys.cpu().debug_pc(), sys.bus().read8(MMU::EWRAM_BASE),
+                        sys.bus().read16(MMU::IO_BASE + IORegs::kOffVCOUNT), sys.cycles()};
+    }
+
+    // A GamePak image whose library string selects the save chip
+    auto rom_with(std::string_view id) -> std::vector<std::uint8_t> {
+        std::vector<std::uint8_t> rom(0x400U, 0x00U);
+        std::copy(id.begin(), id.end(), rom.begin() + 0x200);
+        return rom;
+    }
+
+    // Grows (delta > 0) or shrinks a section's payload at its end; the framing stays valid
+    auto resize_section(std::vector<std::uint8_t> state, std::uint32_t tag, int delta) -> std::vector<std::uint8_t> {
+        constexpr std::size_t kHeaderBytes = 8U;
+        std::size_t pos = kHeaderBytes;
+        while (pos + kHeaderBytes <= state.size()) {
+            std::uint32_t found = 0;
+            std::uint32_t size = 0;
+            std::memcpy(&found, &state[pos], sizeof(found));
+            std::memcpy(&size, &state[pos + 4U], sizeof(size));
+            const auto end = static_cast<std::ptrdiff_t>(pos + kHeaderBytes + size);
+            if (found == tag) {
+                if (delta > 0) {
+                    state.insert(state.begin() + end, static_cast<std::size_t>(delta), std::uint8_t{0x5AU});
+                } else {
+                    state.erase(state.begin() + end + delta, state.begin() + end);
+                }
+                size = static_cast<std::uint32_t>(static_cast<int>(size) + delta);
+                std::memcpy(&state[pos + 4U], &size, sizeof(size));
+                return state;
+            }
+            pos += kHeaderBytes + size;
+        }
+        ADD_FAILURE() << "no such section";
+        return state;
+    }
+
+    constexpr std::uint32_t kWarmupCycles = 12345U;
+    constexpr std::uint32_t kContinueCycles = 100000U;
+} // namespace
+
+// Restoring and re-running must reproduce exactly what the original run did.
+TEST(SaveState, RoundTripReplaysDeterministically) {
+    System sys;
+    sys.reset();
+    load_counter_program(sys);
+    sys.run(kWarmupCycles);
+
+    std::vector<std::uint8_t> state;
+    sys.save_state(state);
+    sys.run(kContinueCycles);
+    const Observed expected = observe(sys);
+
+    ASSERT_TRUE(sys.load_state(state));
+    sys.run(kContinueCycles);
+    EXPECT_EQ(observe(sys), expected);
+}
+
+TEST(SaveState, RestoresIntoAnotherInstance) {
+    System original;
+    original.reset();
+    load_counter_program(original);
+    original.run(kWarmupCycles);
+
+    std::vector<std::uint8_t> state;
+    original.save_state(state);
+
+    System clone;
+    clone.reset();
+    ASSERT_TRUE(clone.load_state(state));
+    EXPECT_EQ(observe(clone), observe(original));
+
+    original.run(kContinueCycles);
+    clone.run(kContinueCycles);
+    EXPECT_EQ(observe(clone), observe(original));
+}
+
+TEST(SaveState, CapturesIoShadowAndApuFifo) {
+    constexpr std::uint16_t kLyc = 0x4200U | IORegs::kDispstatEnableVCount; // LYC 0x42 + IRQ enable
+    constexpr std::uint32_t kFifoWord = 0x04030201U;
+    constexpr std::uint16_t kScanline = 0x42U;
+
+    System sys;
+    sys.reset();
+    sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPSTAT, kLyc);
+    sys.bus().write32(MMU::IO_BASE + APU::kOffFIFO_A, kFifoWord);
+    sys.bus().debug_set_vcount_for_tests(kScanline);
+
+    std::vector<std::uint8_t> state;
+    sys.save_state(state);
+    sys.reset();
+
+    ASSERT_TRUE(sys.load_state(state));
+    const auto dispstat = sys.bus().read16(MMU::IO_BASE + IORegs::kOffDISPSTAT);
+    EXPECT_EQ(dispstat & IORegs::kDispstatLycMask, kLyc & IORegs::kDispstatLycMask);
+    EXPECT_NE(dispstat & IORegs::kDispstatFlagVCount, 0U); // VCOUNT restored and matches LYC
+    EXPECT_EQ(sys.bus().apu().fifo_size(0), 4U);
+}
+
+TEST(SaveState, RejectsForeignTruncatedAndFutureStates) {
+    constexpr std::uint32_t kMarker = 0xC0FFEEU;
+    System sys;
+    sys.reset();
+    std::vector<std::uint8_t> good;
+    sys.save_state(good);
+    sys.cpu().debug_set_reg(0, kMarker);
+
+    auto badMagic = good;
+    badMagic[0] ^= 0xFFU;
+    EXPECT_FALSE(sys.load_state(badMagic));
+
+    auto future = good;
+    const std::uint32_t nextVersion = gba::kStateVersion + 1U;
+    std::memcpy(&future[sizeof(std::uint32_t)], &nextVersion, sizeof(nextVersion));
+    EXPECT_FALSE(sys.load_state(future));
+
+    const std::vector<std::uint8_t> truncated(good.begin(), good.end() - 1);
+    EXPECT_FALSE(sys.load_state(truncated));
+
+    // Nothing was half-loaded
+    EXPECT_EQ(sys.cpu().debug_reg(0), kMarker);
+}
+
+// A well-framed state whose CPU or IO payload has the wrong size must not half-load:
+// the CPU section is read first and IO only after all of RAM.
+TEST(SaveState, RejectsResizedSectionsWithoutPartialLoads) {
+    System source;
+    source.reset();
+    load_counter_program(source);
+    source.run(kWarmupCycles);
+    std::vector<std::uint8_t> good;
+    source.save_state(good);
+
+    System sys;
+    sys.reset();
+    const auto before = state_of(sys);
+    for (const std::uint32_t tag : {gba::kStateTagCPU, gba::kStateTagIO, gba::kStateTagAPU}) {
+        for (const int delta : {4, -4}) {
+            EXPECT_FALSE(sys.load_state(resize_section(good, tag, delta))) << tag << " " << delta;
+            EXPECT_EQ(state_of(sys), before) << tag << " " << delta;
+        }
+    }
+    EXPECT_TRUE(sys.load_state(good));
+}
+
+// Saving every frame into the same vector must not reallocate.
+TEST(SaveState, SaveReusesCallerBuffer) {
+    System sys;
+    sys.reset();
+    std::vector<std::uint8_t> state;
+    sys.save_state(state);
+    const auto *data = state.data();
+    const auto size = state.size();
+
+    sys.run(kWarmupCycles);
+    sys.save_state(state);
+    EXPECT_EQ(state.data(), data);
+    EXPECT_EQ(state.size(), size);
+    EXPECT_GE(size, MMU::EWRAM_SIZE + MMU::IWRAM_SIZE + MMU::VRAM_SIZE + MMU::PAL_SIZE + MMU::OAM_SIZE);
+}
+
+TEST(SaveState, SchedulerPositionSurvivesMidFrame) {
+    constexpr std::uint32_t kMidLine = System::kCyclesPerLine * 100U + 17U;
+    System sys;
+    sys.reset();
+    sys.run(kMidLine);
+
+    std::vector<std::uint8_t> state;
+    sys.save_state(state);
+    sys.run_frame();
+    const auto frameAfter = sys.frame();
+    const auto cyclesAfter = sys.cycles();
+
+    ASSERT_TRUE(sys.load_state(state));
+    sys.run_frame();
+    EXPECT_EQ(sys.frame(), frameAfter);
+    EXPECT_EQ(sys.cycles(), cyclesAfter);
+    EXPECT_EQ(cyclesAfter, System::kCyclesPerFrame);
+}
+
+TEST(SaveState, CarriesBackupContentsAndChipState) {
+    constexpr std::uint32_t kFlashCmd1 = MMU::SRAM_BASE + Backup::kFlashCmd1;
+    constexpr std::uint32_t kFlashCmd2 = MMU::SRAM_BASE + Backup::kFlashCmd2;
+    System sys;
+    sys.reset();
+    sys.load_gamepak(rom_with("SRAM_V113"));
+    sys.bus().write8(MMU::SRAM_BASE + 0x10U, 0x5AU);
+    std::vector<std::uint8_t> state;
+    sys.save_state(state);
+    sys.bus().write8(MMU::SRAM_BASE + 0x10U, 0x00U);
+    ASSERT_TRUE(sys.load_state(state));
+    EXPECT_EQ(sys.bus().read8(MMU::SRAM_BASE + 0x10U), 0x5AU);
+
+    // Mid-protocol: a state taken in Flash ID mode comes back in ID mode
+    System flash;
+    flash.reset();
+    flash.load_gamepak(rom_with("FLASH_V126"));
+    flash.bus().write8(kFlashCmd1, 0xAAU);
+    flash.bus().write8(kFlashCmd2, 0x55U);
+    flash.bus().write8(kFlashCmd1, 0x90U); // enter ID mode
+    flash.save_state(state);
+    flash.bus().write8(kFlashCmd1, 0xF0U); // exit ID mode
+    ASSERT_NE(flash.bus().read8(MMU::SRAM_BASE), Backup::kFlash64KId[0]);
+    ASSERT_TRUE(flash.load_state(state));
+    EXPECT_EQ(flash.bus().read8(MMU::SRAM_BASE), Backup::kFlash64KId[0]);
+}
+
+TEST(SaveState, RejectsStatesOfAnotherSaveChip) {
+    constexpr std::uint32_t kMarker = 0xC0FFEEU;
+    System sram;
+    sram.reset();
+    sram.load_gamepak(rom_with("SRAM_V113"));
+    std::vector<std::uint8_t> state;
+    sram.save_state(state);
+
+    System flash;
+    flash.reset();
+    flash.load_gamepak(rom_with("FLASH_V126"));
+    flash.cpu().debug_set_reg(0, kMarker);
+    EXPECT_FALSE(flash.load_state(state));
+    EXPECT_EQ(flash.cpu().debug_reg(0), kMarker); // nothing was half-loaded
+}
@@ -0,0 +1,151 @@
+// tests/state_delta.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/mmu/paged_memory.h"
+#include "core/state/state_io.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::MMU;
+using gba::PagedMemory;
+using gba::System;
+using gba::test::counter_program;
+using gba::test::load_program;
+
+namespace {
+    constexpr std::uint16_t kEwramHighByte = 0x02U;
+
+    // r1 = EWRAM_BASE; loop { r0 += 1; [r1] = r0 (byte) }
+    void load_counter_program(System &sys) {
+        load_program(sys, counter_program(kEwramHighByte));
+    }
+
+    // Header + six section headers + five region masks, no pages
+    constexpr std::size_t kFramingBytes = 8U + (6U * 8U) + (MMU::kStateRegionSizes.size() * 8U);
+
+    void keyframe(System &sys, std::vector<std::uint8_t> &state) {
+        sys.save_state(state);
+        sys.checkpoint();
+    }
+} // namespace
+
+TEST(StateDelta, ReplayingDeltasRebuildsTheFullState) {
+    System sys;
+    sys.reset();
+    load_counter_program(sys);
+    std::vector<std::uint8_t> rebuilt;
+    keyframe(sys, rebuilt);
+
+    std::vector<std::uint8_t> delta;
+    std::vector<std::uint8_t> full;
+    for (int frame = 0; frame < 3; ++frame) {
+        sys.run_frame();
+        sys.bus().write8(MMU::VRAM_BASE + (static_cast<std::uint32_t>(frame) * PagedMemory::kPageBytes * 3U), 0x77U);
+        sys.save_delta(delta);
+        ASSERT_TRUE(System::apply_delta(rebuilt, delta));
+        sys.save_state(full);
+        EXPECT_EQ(rebuilt, full) << "frame " << frame;
+        EXPECT_LT(delta.size(), full.size() / 10U);
+    }
+
+    System other;
+    ASSERT_TRUE(other.load_state(rebuilt));
+    EXPECT_EQ(other.cycles(), sys.cycles());
+    EXPECT_EQ(other.cpu().debug_reg(0), sys.cpu().debug_reg(0));
+}
+
+TEST(StateDelta, DeltaCarriesOnlyWrittenPages) {
+    System sys;
+    sys.reset();
+    std::vector<std::uint8_t> state;
+    keyframe(sys, state);
+
+    std::vector<std::uint8_t> delta;
+    sys.save_delta(delta);
+    const std::size_t idle = delta.size();
+    EXPECT_GE(idle, kFramingBytes);
+    EXPECT_LT(idle, PagedMemory::kPageBytes); // registers only
+
+    sys.bus().write8(MMU::EWRAM_BASE + 0x5123U, 1U);
+    sys.bus().write8(MMU::EWRAM_BASE + 0x5FFFU, 2U); // same page
+    sys.save_delta(delta);
+    EXPECT_EQ(delta.size(), idle + PagedMemory::kPageBytes);
+
+    sys.save_delta(delta); // the previous delta started a new interval
+    EXPECT_EQ(delta.size(), idle);
+}
+
+TEST(StateDelta, LoadStateDirtiesEveryPage) {
+    System sys;
+    sys.reset();
+    std::vector<std::uint8_t> state;
+    keyframe(sys, state);
+    ASSERT_TRUE(sys.load_state(state));
+
+    std::vector<std::uint8_t> delta;
+    sys.save_delta(delta);
+    EXPECT_GT(delta.size(), MMU::EWRAM_SIZE + MMU::IWRAM_SIZE + MMU::VRAM_SIZE);
+}
+
+TEST(StateDelta, MalformedDeltasLeaveTheStateUntouched) {
+    System sys;
+    sys.reset();
+    std::vector<std::uint8_t> state;
+    keyframe(sys, state);
+    sys.bus().write8(MMU::IWRAM_BASE + 0x10U, 0x42U);
+    std::vector<std::uint8_t> delta;
+    sys.save_delta(delta);
+    const auto original = state;
+
+    auto truncated = delta;
+    truncated.pop_back();
+    EXPECT_FALSE(System::apply_delta(state, truncated));
+
+    auto foreignMagic = delta;
+    foreignMagic[0] ^= 0xFFU;
+    EXPECT_FALSE(System::apply_delta(state, foreignMagic));
+
+    // A full state is not a delta, and a delta is not a keyframe
+    EXPECT_FALSE(System::apply_delta(state, original));
+    auto notKeyframe = delta;
+    EXPECT_FALSE(System::apply_delta(notKeyframe, delta));
+    EXPECT_EQ(state, original);
+
+    ASSERT_TRUE(System::apply_delta(state, delta));
+    System other;
+    ASSERT_TRUE(other.load_state(state));
+    EXPECT_EQ(other.bus().read8(MMU::IWRAM_BASE + 0x10U), 0x42U);
+}
+
+TEST(StateDelta, BackupContentsTravelOnlyWhenWritten) {
+    std::vector<std::uint8_t> rom(0x400U, 0x00U);
+    constexpr std::string_view kSram = "SRAM_V113";
+    std::copy(kSram.begin(), kSram.end(), rom.begin() + 0x200);
+    System sys;
+    sys.reset();
+    sys.load_gamepak(rom);
+    std::vector<std::uint8_t> rebuilt;
+    keyframe(sys, rebuilt);
+
+    std::vector<std::uint8_t> delta;
+    sys.save_delta(delta);
+    const std::size_t idle = delta.size();
+    ASSERT_TRUE(System::apply_delta(rebuilt, delta));
+
+    sys.bus().write8(MMU::SRAM_BASE + 0x123U, 0x42U);
+    sys.save_delta(delta);
+    EXPECT_EQ(delta.size(), idle + sys.bus().backup().contents().size());
+    ASSERT_TRUE(System::apply_delta(rebuilt, delta));
+
+    sys.save_delta(delta);
+    EXPECT_EQ(delta.size(), idle);
+    ASSERT_TRUE(System::apply_delta(rebuilt, delta)); // keeps the contents rebuilt so far
+
+    std::vector<std::uint8_t> full;
+    sys.save_state(full);
+    EXPECT_EQ(rebuilt, full);
+}
@@ -0,0 +1,99 @@
+// tests/system_fork.cpp
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/mmu/paged_memory.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::MMU;
+using gba::PagedMemory;
+using gba::System;
+using gba::test::counter_program;
+using gba::test::load_program;
+
+namespace {
+    constexpr std::uint16_t kEwramHighByte = 0x02U;
+
+    // r1 = EWRAM_BASE; loop { r0 += 1; [r1] = r0 (byte) }
+    void boot_counter(System &sys) {
+        sys.reset();
+        load_program(sys, counter_program(kEwramHighByte));
+    }
+
+    constexpr std::uint32_t kFarPage = 10U * PagedMemory::kPageBytes;
+} // namespace
+
+TEST(SystemFork, ChildSharesEveryPageUntilItWrites) {
+    System parent;
+    boot_counter(parent);
+    const auto child = parent.fork();
+
+    const auto &parentRam = parent.bus().ewram();
+    const auto &childRam = child->bus().ewram();
+    for (std::size_t i = 0; i < parentRam.page_count(); ++i) {
+        EXPECT_TRUE(childRam.shares_page_with(parentRam, i)) << "page " << i;
+    }
+
+    child->bus().write8(MMU::EWRAM_BASE + kFarPage, 0x5AU);
+    EXPECT_EQ(child->bus().read8(MMU::EWRAM_BASE + kFarPage), 0x5AU);
+    EXPECT_EQ(parent.bus().read8(MMU::EWRAM_BASE + kFarPage), 0x00U);
+    EXPECT_FALSE(childRam.shares_page_with(parentRam, kFarPage / PagedMemory::kPageBytes));
+    EXPECT_TRUE(childRam.shares_page_with(parentRam, 0U));
+}
+
+TEST(SystemFork, ChildContinuesExactlyLikeTheParent) {
+    System parent;
+    boot_counter(parent);
+    parent.run(System::kCyclesPerLine * 7U + 100U);
+    const auto child = parent.fork();
+
+    parent.run_frame();
+    child->run_frame();
+    EXPECT_EQ(child->cycles(), parent.cycles());
+    EXPECT_EQ(child->frame(), parent.frame());
+    EXPECT_EQ(child->cpu().debug_reg(0), parent.cpu().debug_reg(0));
+    EXPECT_EQ(child->bus().read8(MMU::EWRAM_BASE), parent.bus().read8(MMU::EWRAM_BASE));
+}
+
+TEST(SystemFork, GamePakImageIsShared) {
+    const std::vector<std::uint8_t> rom{0x11U, 0x22U, 0x33U, 0x44U};
+    System parent;
+    parent.reset();
+    parent.load_gamepak(rom);
+    const auto child = parent.fork();
+    EXPECT_EQ(child->bus().read32(MMU::WS0_BASE), parent.bus().read32(MMU::WS0_BASE));
+}
+
+// Siblings that share pages run on their own threads without seeing each other.
+TEST(SystemFork, SiblingsDivergeIndependentlyAcrossThreads) {
+    constexpr std::size_t kChildren = 8U;
+    System parent;
+    boot_counter(parent);
+    parent.run_frame();
+    const auto parentByte = parent.bus().read8(MMU::EWRAM_BASE + kFarPage);
+
+    std::vector<std::unique_ptr<System>> children;
+    for (std::size_t i = 0; i < kChildren; ++i) {
+        children.push_back(parent.fork());
+    }
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < kChildren; ++i) {
+        threads.emplace_back([&child = *children[i], i] {
+            child.bus().write8(MMU::EWRAM_BASE + kFarPage, static_cast<std::uint8_t>(i + 1U));
+            child.run_frame();
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t i = 0; i < kChildren; ++i) {
+        EXPECT_EQ(children[i]->bus().read8(MMU::EWRAM_BASE + kFarPage), static_cast<std::uint8_t>(i + 1U));
+        EXPECT_EQ(children[i]->frame(), parent.frame() + 1U);
+    }
+    EXPECT_EQ(parent.bus().read8(MMU::EWRAM_BASE + kFarPage), parentByte);
+}
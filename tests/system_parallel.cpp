@@ -0,0 +1,109 @@
+// tests/system_parallel.cpp
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+#include "core/apu/apu.h"
+#include "core/io/io.h"
+#include "core/mmu/mmu.h"
+#include "core/ppu/ppu.h"
+#include "core/system/headless.h"
+#include "core/system/system.h"
+#include "thumb_program.h"
+
+using gba::IORegs;
+using gba::MMU;
+using gba::PPU;
+using gba::System;
+using gba::test::kKeyInputDiv8;
+using gba::test::kTimes8;
+using gba::test::kToTopByte;
+using gba::test::load_program;
+using gba::test::Thumb_ADD_imm;
+using gba::test::Thumb_ADD_reg;
+using gba::test::Thumb_B_off11;
+using gba::test::Thumb_LDRB_imm;
+using gba::test::Thumb_LSL_imm;
+using gba::test::Thumb_MOV_imm;
+using gba::test::Thumb_STRB_imm;
+
+namespace {
+    constexpr std::size_t kInstances = 64U;
+    constexpr std::uint64_t kFrames = 6U;
+    constexpr std::int16_t kBackToLoop = -10; // B four instructions after the loop label (offset from the next one)
+    constexpr std::uint16_t kMode3Bg2 = PPU::kMode3 | PPU::kDispcntBg2;
+
+    // Everything one run leaves behind; two runs agree only if every byte of state does
+    struct Outcome {
+        std::vector<std::uint8_t> state;
+        std::uint64_t framebuffer_hash = 0;
+        std::uint64_t ram_hash = 0;
+        std::uint64_t audio_hash = gba::kFnvOffsetBasis;
+    };
+
+    // Mode 3; r5 starts at `seed`; loop { r5 += 1; pixel(0,0) low byte = r5; EWRAM[0] = KEYINPUT low byte }
+    void boot(System &sys, std::size_t seed) {
+        sys.reset();
+        const std::array<std::uint16_t, 15> program{
+            Thumb_MOV_imm(1U, MMU::IO_BASE >> kToTopByte), Thumb_LSL_imm(1U, 1U, kToTopByte),
+            Thumb_MOV_imm(0U, kKeyInputDiv8), Thumb_LSL_imm(0U, 0U, kTimes8), Thumb_ADD_reg(1U, 1U, 0U),
+            Thumb_MOV_imm(3U, MMU::EWRAM_BASE >> kToTopByte), Thumb_LSL_imm(3U, 3U, kToTopByte),
+            Thumb_MOV_imm(4U, MMU::VRAM_BASE >> kToTopByte), Thumb_LSL_imm(4U, 4U, kToTopByte),
+            Thumb_MOV_imm(5U, static_cast<std::uint16_t>(seed)),
+            // loop:
+            Thumb_ADD_imm(5U, 1U), Thumb_STRB_imm(5U, 4U, 0U), Thumb_LDRB_imm(2U, 1U, 0U), Thumb_STRB_imm(2U, 3U, 0U),
+            Thumb_B_off11(kBackToLoop)};
+        sys.bus().write16(MMU::IO_BASE + IORegs::kOffDISPCNT, kMode3Bg2);
+        load_program(sys, program);
+    }
+
+    auto run_instance(std::size_t index) -> Outcome {
+        auto sys = std::make_unique<System>();
+        boot(*sys, index);
+        Outcome outcome;
+        auto &apu = sys->bus().apu();
+        for (std::uint64_t frame = 0; frame < kFrames; ++frame) {
+            sys->bus().io().set_keys_pressed(static_cast<std::uint16_t>((index * 7U + frame) & IORegs::kKeyMask));
+            sys->run_frame();
+            const auto audio = apu.output();
+            const std::span<const std::uint8_t> bytes(reinterpret_cast<const std::uint8_t *>(audio.data()), // NOLINT
+                                                      audio.size_bytes());
+            outcome.audio_hash = gba::fnv1a64(bytes, outcome.audio_hash);
+            apu.consume_output();
+        }
+        sys->save_state(outcome.state);
+        outcome.framebuffer_hash = gba::framebuffer_hash(sys->ppu());
+        outcome.ram_hash = gba::ram_hash(sys->bus());
+        return outcome;
+    }
+} // namespace
+
+TEST(SystemParallel, SixtyFourInstancesOnThreadsMatchSerialRuns) {
+    std::vector<Outcome> serial(kInstances);
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        serial[i] = run_instance(i);
+    }
+
+    std::vector<Outcome> parallel(kInstances);
+    std::vector<std::thread> threads;
+    threads.reserve(kInstances);
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        threads.emplace_back([&parallel, i] { parallel[i] = run_instance(i); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t i = 0; i < kInstances; ++i) {
+        EXPECT_EQ(parallel[i].state, serial[i].state) << "instance " << i;
+        EXPECT_EQ(parallel[i].framebuffer_hash, serial[i].framebuffer_hash) << "instance " << i;
+        EXPECT_EQ(parallel[i].ram_hash, serial[i].ram_hash) << "instance " << i;
+        EXPECT_EQ(parallel[i].audio_hash, serial[i].audio_hash) << "instance " << i;
+    }
+    // The instances really differ, so a shared hidden state would have shown up
+    EXPECT_NE(serial[0].ram_hash, serial[1].ram_hash);
+    EXPECT_NE(serial[0].framebuffer_hash, serial[1].framebuffer_hash);
+}
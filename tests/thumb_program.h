@@ -0,0 +1,131 @@
+// tests/thumb_program.h
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "core/mmu/mmu.h"
+#include "core/system/system.h"
+
+// Thumb encoders, the small guest programs the System-level tests run from IWRAM and
+// the helpers that set those Systems up and compare them.
+// The CPU unit tests keep their own encoders next to the instructions they check.
+namespace gba::test {
+    constexpr std::uint16_t kThumbTop5Shift = 11U;
+    constexpr std::uint16_t kRegFieldShift = 8U;
+    constexpr std::uint16_t kImm5Shift = 6U;
+    constexpr std::uint16_t kRbShift = 3U;
+    constexpr std::uint16_t kRnShift = 6U;
+    constexpr std::uint16_t kImm11Mask = 0x07FFU;
+    constexpr std::uint16_t kTop5_LSL = 0b00000U;
+    constexpr std::uint16_t kTop5_LSR = 0b00001U;
+    constexpr std::uint16_t kTop5_MOV = 0b00100U;
+    constexpr std::uint16_t kTop5_ADD = 0b00110U;
+    constexpr std::uint16_t kTop5_STRB = 0b01110U;
+    constexpr std::uint16_t kTop5_LDRB = 0b01111U;
+    constexpr std::uint16_t kTop5_B = 0b11100U;
+    constexpr std::uint16_t kAddRegOpcode = 0x1800U; // 0001100 Rn Rs Rd
+
+    constexpr auto Thumb_MOV_imm(std::uint16_t rd, std::uint16_t imm8) -> std::uint16_t {
+        return static_cast<std::uint16_t>((kTop5_MOV << kThumbTop5Shift) | (rd << kRegFieldShift) | imm8);
+    }
+    constexpr auto Thumb_ADD_imm(std::uint16_t rd, std::uint16_t imm8) -> std::uint16_t {
+        return static_cast<std::uint16_t>((kTop5_ADD << kThumbTop5Shift) | (rd << kRegFieldShift) | imm8);
+    }
+    constexpr auto Thumb_ADD_reg(std::uint16_t rd, std::uint16_t rs, std::uint16_t rn) -> std::uint16_t {
+        return static_cast<std::uint16_t>(kAddRegOpcode | (rn << kRnShift) | (rs << kRbShift) | rd);
+    }
+    constexpr auto Thumb_LSL_imm(std::uint16_t rd, std::uint16_t rs, std::uint16_t imm5) -> std::uint16_t {
+        return static_cast<std::uint16_t>((kTop5_LSL << kThumbTop5Shift) | (imm5 << kImm5Shift) | (rs << kRbShift) |
+                                          rd);
+    }
+    constexpr auto Thumb_LSR_imm(std::uint16_t rd, std::uint16_t rs, std::uint16_t imm5) -> std::uint16_t {
+        return static_cast<std::uint16_t>((kTop5_LSR << kThumbTop5Shift) | (imm5 << kImm5Shift) | (rs << kRbShift) |
+                                          rd);
+    }
+    constexpr auto Thumb_STRB_imm(std::uint16_t rd, std::uint16_t rb, std::uint16_t imm5) -> std::uint16_t {
+        return static_cast<std::uint16_t>((kTop5_STRB << kThumbTop5Shift) | (imm5 << kImm5Shift) |
+                                          (rb << kRbShift) | rd);
+    }
+    constexpr auto Thumb_LDRB_imm(std::uint16_t rd, std::uint16_t rb, std::uint16_t imm5) -> std::uint16_t {
+        return static_cast<std::uint16_t>((kTop5_LDRB << kThumbTop5Shift) | (imm5 << kImm5Shift) |
+                                          (rb << kRbShift) | rd);
+    }
+    constexpr auto Thumb_B_off11(std::int16_t offsetBytes) -> std::uint16_t {
+        return static_cast<std::uint16_t>((kTop5_B << kThumbTop5Shift) | ((offsetBytes >> 1) & kImm11Mask));
+    }
+
+    constexpr std::uint32_t kProgramBase = MMU::IWRAM_BASE;
+    constexpr std::uint16_t kToTopByte = 24U;
+    constexpr std::uint16_t kKeyInputDiv8 = 0x26U; // 0x130 >> 3
+    constexpr std::uint16_t kTimes8 = 3U;
+
+    // Copies `program` to kProgramBase and points the CPU at it
+    inline void load_program(System &sys, std::span<const std::uint16_t> program) {
+        for (std::size_t i = 0; i < program.size(); ++i) {
+            sys.bus().write16(kProgramBase + static_cast<std::uint32_t>(i * 2U), program[i]);
+        }
+        sys.cpu().debug_set_program_counter(kProgramBase);
+    }
+
+    // A reset System running `program`; `seed` goes to EWRAM[0] so instances start apart
+    inline auto make_instance(std::span<const std::uint16_t> program, std::uint8_t seed = 0U)
+        -> std::unique_ptr<System> {
+        auto sys = std::make_unique<System>();
+        sys->reset();
+        sys->bus().write8(MMU::EWRAM_BASE, seed);
+        load_program(*sys, program);
+        return sys;
+    }
+
+    // The full save state, for comparing whole machines
+    inline auto state_of(const System &sys) -> std::vector<std::uint8_t> {
+        std::vector<std::uint8_t> state;
+        sys.save_state(state);
+        return state;
+    }
+
+    // r1 = highByte << 24; loop { r0 += 1; [r1] = r0 (byte) }
+    constexpr auto counter_program(std::uint16_t highByte) -> std::array<std::uint16_t, 5> {
+        constexpr std::int16_t kBackToAdd = -8; // B at +8 targets +4 (PC reads as +12)
+        return {Thumb_MOV_imm(1U, highByte), Thumb_LSL_imm(1U, 1U, kToTopByte), Thumb_ADD_imm(0U, 1U),
+                Thumb_STRB_imm(0U, 1U, 0U), Thumb_B_off11(kBackToAdd)};
+    }
+
+    // r1 = KEYINPUT; r3 = highByte << 24; loop { [r3] = [r1] (low byte) }
+    constexpr auto key_echo_program(std::uint16_t highByte) -> std::array<std::uint16_t, 10> {
+        constexpr std::int16_t kBackToLoop = -6; // B two instructions after the loop label (offset from the next one)
+        return {Thumb_MOV_imm(1U, MMU::IO_BASE >> kToTopByte),
+                Thumb_LSL_imm(1U, 1U, kToTopByte),
+                Thumb_MOV_imm(0U, kKeyInputDiv8),
+                Thumb_LSL_imm(0U, 0U, kTimes8),
+                Thumb_ADD_reg(1U, 1U, 0U),
+                Thumb_MOV_imm(3U, highByte),
+                Thumb_LSL_imm(3U, 3U, kToTopByte),
+                // loop:
+                Thumb_LDRB_imm(2U, 1U, 0U),
+                Thumb_STRB_imm(2U, 3U, 0U),
+                Thumb_B_off11(kBackToLoop)};
+    }
+
+    // Position independent: loop { r5 += 1; VRAM[0] = r5; EWRAM[0] = KEYINPUT low byte }
+    constexpr auto counting_key_echo_program() -> std::array<std::uint16_t, 14> {
+        constexpr std::int16_t kBackToLoop = -12; // B at +26 targets +18 (PC reads as +30)
+        return {Thumb_MOV_imm(1U, MMU::IO_BASE >> kToTopByte),
+                Thumb_LSL_imm(1U, 1U, kToTopByte),
+                Thumb_MOV_imm(0U, kKeyInputDiv8),
+                Thumb_LSL_imm(0U, 0U, kTimes8),
+                Thumb_ADD_reg(1U, 1U, 0U),
+                Thumb_MOV_imm(3U, MMU::EWRAM_BASE >> kToTopByte),
+                Thumb_LSL_imm(3U, 3U, kToTopByte),
+                Thumb_MOV_imm(4U, MMU::VRAM_BASE >> kToTopByte),
+                Thumb_LSL_imm(4U, 4U, kToTopByte),
+                // loop:
+                Thumb_ADD_imm(5U, 1U),
+                Thumb_STRB_imm(5U, 4U, 0U),
+                Thumb_LDRB_imm(2U, 1U, 0U),
+                Thumb_STRB_imm(2U, 3U, 0U),
+                Thumb_B_off11(kBackToLoop)};
+    }
+} // namespace gba::test
@@ -0,0 +1,80 @@
+// tests/work_pool.cpp
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/system/work_pool.h"
+
+using gba::WorkStealingPool;
+
+namespace {
+    constexpr std::size_t kWorkers = 4U;
+    constexpr std::size_t kItems = 1000U;
+} // namespace
+
+TEST(WorkStealingPool, RunsEveryIndexExactlyOnceOnValidWorkers) {
+    WorkStealingPool pool(kWorkers);
+    ASSERT_EQ(pool.size(), kWorkers);
+    std::vector<std::atomic<int>> calls(kItems);
+    std::atomic<bool> badWorker{false};
+    pool.run(kItems, [&](std::size_t index, std::size_t worker) {
+        calls[index].fetch_add(1, std::memory_order_relaxed);
+        if (worker >= kWorkers) {
+            badWorker.store(true);
+        }
+    });
+    for (const auto &count : calls) {
+        EXPECT_EQ(count.load(), 1);
+    }
+    EXPECT_FALSE(badWorker.load());
+}
+
+TEST(WorkStealingPool, AWorkerNeverRunsTwoItemsAtOnce) {
+    WorkStealingPool pool(kWorkers);
+    std::vector<std::atomic<bool>> busy(kWorkers);
+    std::atomic<bool> overlap{false};
+    pool.run(kItems, [&](std::size_t /*index*/, std::size_t worker) {
+        if (busy[worker].exchange(true)) {
+            overlap.store(true);
+        }
+        std::this_thread::yield();
+        busy[worker].store(false);
+    });
+    EXPECT_FALSE(overlap.load());
+}
+
+TEST(WorkStealingPool, IdleWorkersStealFromASlowQueue) {
+    constexpr std::size_t kSlowItems = kItems / kWorkers; // worker 0's whole block
+    WorkStealingPool pool(kWorkers);
+    std::vector<std::size_t> ranBy(kItems);
+    pool.run(kItems, [&](std::size_t index, std::size_t worker) {
+        ranBy[index] = worker;
+        if (index < kSlowItems) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+    EXPECT_GT(pool.steals(), 0U);
+    std::size_t slowOnOthers = 0;
+    for (std::size_t i = 0; i < kSlowItems; ++i) {
+        slowOnOthers += ranBy[i] != 0U ? 1U : 0U;
+    }
+    EXPECT_GT(slowOnOthers, 0U);
+}
+
+TEST(WorkStealingPool, IsReusableAndHandlesEmptyAndSingleWorkerBatches) {
+    WorkStealingPool pool(kWorkers);
+    std::atomic<std::size_t> total{0};
+    for (int round = 0; round < 50; ++round) {
+        pool.run(static_cast<std::size_t>(round), [&](std::size_t, std::size_t) { total.fetch_add(1U); });
+    }
+    EXPECT_EQ(total.load(), 49U * 50U / 2U);
+
+    WorkStealingPool single(1U);
+    std::size_t ran = 0; // caller thread only: no synchronisation needed
+    single.run(kItems, [&](std::size_t, std::size_t worker) { ran += worker == 0U ? 1U : 0U; });
+    EXPECT_EQ(ran, kItems);
+    EXPECT_GE(WorkStealingPool().size(), 1U); // default: one per hardware thread
+}